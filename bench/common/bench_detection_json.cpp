@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "common/infer/detection_json_writer.hpp"
+#include "common/utils/json.hpp"
+#include "detection_frames.hpp"
+
+using app_common::DetectionFrame;
+
+namespace {
+auto makeFrame(uint32_t num_objects) { return test_support::makeRandomFrame(num_objects, 42, 4); }
+
+// DetectionJsonWriter 이전에 AiService 가 쓰던 nlohmann::json 직렬화 경로 (기준선)
+std::string dumpWithNlohmann(const DetectionFrame& frame) {
+  app_common::Json frame_json;
+  frame_json["frame_number"] = frame.frame_number;
+  frame_json["timestamp"] = frame.timestamp;
+
+  app_common::Json objects_array = app_common::Json::array();
+  for (uint32_t i = 0; i < frame.num_objects; ++i) {
+    const auto& det = frame.objects[i];
+    app_common::Json object_json;
+    object_json["class_id"] = det.class_id;
+    object_json["label"] = std::string(det.label);
+    object_json["confidence"] = det.confidence;
+
+    app_common::Json box_json;
+    box_json["x"] = det.x;
+    box_json["y"] = det.y;
+    box_json["w"] = det.w;
+    box_json["h"] = det.h;
+    object_json["box"] = box_json;
+    objects_array.push_back(object_json);
+  }
+  frame_json["objects"] = objects_array;
+  return frame_json.dump();
+}
+}  // namespace
+
+static void BM_DetectionJsonNlohmann(benchmark::State& state) {
+  auto frame = makeFrame(static_cast<uint32_t>(state.range(0)));
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    auto json = dumpWithNlohmann(*frame);
+    bytes += json.size();
+    benchmark::DoNotOptimize(json.data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_DetectionJsonNlohmann)->Arg(0)->Arg(10)->Arg(100)->Arg(500);
+
+static void BM_DetectionJsonWriter(benchmark::State& state) {
+  auto frame = makeFrame(static_cast<uint32_t>(state.range(0)));
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    auto json = app_common::writeDetectionJson(*frame);
+    bytes += json.size();
+    benchmark::DoNotOptimize(json.data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_DetectionJsonWriter)->Arg(0)->Arg(10)->Arg(100)->Arg(500);
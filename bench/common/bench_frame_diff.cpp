@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "common/vision/frame_diff.hpp"
+
+using app_common::SimdLevel;
+
+namespace {
+constexpr int kWidth = 1920;
+constexpr int kHeight = 1080;
+
+std::vector<uint8_t> makeLuma(uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<uint8_t> luma(static_cast<std::size_t>(kWidth) * kHeight);
+  for (auto& v : luma) v = static_cast<uint8_t>(dist(rng));
+  return luma;
+}
+}  // namespace
+
+// 1080p luma plane 전체 SAD
+static void BM_SumAbsDiff(benchmark::State& state) {
+  const auto level = static_cast<SimdLevel>(state.range(0));
+  const auto a = makeLuma(1);
+  const auto b = makeLuma(2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(app_common::sumAbsDiff(a.data(), b.data(), a.size(), level));
+  }
+  state.SetLabel(app_common::simdLevelName(level));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(a.size()) * 2);
+}
+BENCHMARK(BM_SumAbsDiff)
+    ->Arg(static_cast<int>(SimdLevel::Scalar))
+    ->Arg(static_cast<int>(SimdLevel::Sse2))
+    ->Arg(static_cast<int>(SimdLevel::Avx2))
+    ->Arg(static_cast<int>(SimdLevel::Neon));
+
+// 모션 게이트가 프레임마다 하는 일: row_step 줄마다 참조와 비교
+static void BM_FrameDiffScore(benchmark::State& state) {
+  const auto a = makeLuma(1);
+  const auto b = makeLuma(2);
+  app_common::FrameDiffScorer scorer(static_cast<int>(state.range(0)));
+  scorer.setReference(a.data(), kWidth, kHeight, kWidth);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scorer.score(b.data(), kWidth, kHeight, kWidth));
+  }
+}
+BENCHMARK(BM_FrameDiffScore)->Arg(1)->Arg(4)->Arg(8);
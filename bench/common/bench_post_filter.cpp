@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/infer/post_filter.hpp"
+#include "detection_frames.hpp"
+
+using app_common::DetectionFrame;
+using app_common::PostFilterConfig;
+
+namespace {
+auto makeFrame(uint32_t num_objects) { return test_support::makeRandomFrame(num_objects, 11, 6); }
+
+PostFilterConfig makeConfig() {
+  PostFilterConfig config;
+  config.min_confidence = 0.3f;
+  config.class_confidence = {{1, 0.5f}, {3, 0.2f}};
+  config.allowed_classes = {0, 1, 2, 3, 4};
+  config.min_area = 900.0f;
+  config.nms_iou = 0.45f;
+  return config;
+}
+
+// 같은 규칙을 Detection 배열 위에서 그대로 구현한 기준선
+uint32_t filterAos(DetectionFrame& frame, const PostFilterConfig& config) {
+  const std::unordered_set<int32_t> allowed(config.allowed_classes.begin(), config.allowed_classes.end());
+  const std::unordered_map<int32_t, float> thresholds(config.class_confidence.begin(), config.class_confidence.end());
+
+  std::vector<app_common::Detection> kept;
+  for (uint32_t i = 0; i < frame.num_objects; ++i) {
+    const auto& det = frame.objects[i];
+    if (!allowed.empty() && !allowed.count(det.class_id)) continue;
+    auto it = thresholds.find(det.class_id);
+    if (det.confidence < (it != thresholds.end() ? it->second : config.min_confidence)) continue;
+    if (det.w * det.h < config.min_area) continue;
+    kept.push_back(det);
+  }
+
+  std::stable_sort(kept.begin(), kept.end(), [](const auto& a, const auto& b) { return a.confidence > b.confidence; });
+  std::vector<bool> suppressed(kept.size(), false);
+  for (std::size_t i = 0; i < kept.size(); ++i) {
+    if (suppressed[i]) continue;
+    for (std::size_t j = i + 1; j < kept.size(); ++j) {
+      if (suppressed[j] || kept[j].class_id != kept[i].class_id) continue;
+      const float w = std::min(kept[i].x + kept[i].w, kept[j].x + kept[j].w) - std::max(kept[i].x, kept[j].x);
+      const float h = std::min(kept[i].y + kept[i].h, kept[j].y + kept[j].h) - std::max(kept[i].y, kept[j].y);
+      if (w <= 0 || h <= 0) continue;
+      const float inter = w * h;
+      if (inter / (kept[i].w * kept[i].h + kept[j].w * kept[j].h - inter) > config.nms_iou) suppressed[j] = true;
+    }
+  }
+
+  uint32_t count = 0;
+  for (std::size_t i = 0; i < kept.size(); ++i) {
+    if (!suppressed[i]) frame.objects[count++] = kept[i];
+  }
+  const uint32_t removed = frame.num_objects - count;
+  frame.num_objects = count;
+  return removed;
+}
+}  // namespace
+
+static void BM_PostFilterAos(benchmark::State& state) {
+  auto source = makeFrame(static_cast<uint32_t>(state.range(0)));
+  auto frame = std::make_unique<DetectionFrame>();
+  const PostFilterConfig config = makeConfig();
+  uint64_t removed = 0;
+
+  for (auto _ : state) {
+    app_common::copyFrame(*frame, *source);
+    removed += filterAos(*frame, config);
+    benchmark::DoNotOptimize(frame->num_objects);
+  }
+  state.counters["kept"] = static_cast<double>(frame->num_objects);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+BENCHMARK(BM_PostFilterAos)->Arg(10)->Arg(100)->Arg(500);
+
+static void BM_PostFilterSoa(benchmark::State& state) {
+  auto source = makeFrame(static_cast<uint32_t>(state.range(0)));
+  auto frame = std::make_unique<DetectionFrame>();
+  app_common::PostFilter filter(makeConfig());
+  uint64_t removed = 0;
+
+  for (auto _ : state) {
+    app_common::copyFrame(*frame, *source);
+    removed += filter.apply(*frame);
+    benchmark::DoNotOptimize(frame->num_objects);
+  }
+  state.counters["kept"] = static_cast<double>(frame->num_objects);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+BENCHMARK(BM_PostFilterSoa)->Arg(10)->Arg(100)->Arg(500);
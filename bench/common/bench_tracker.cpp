@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/infer/detection_json_writer.hpp"
+#include "common/infer/tracker.hpp"
+
+using app_common::DetectionFrame;
+
+namespace {
+const char* const kLabels[] = {"car", "person", "bicycle", "roadsign"};
+
+// 천천히 움직이는 객체들: 검출 좌표에 1px 정도의 흔들림을 넣는다
+struct Scene {
+  explicit Scene(uint32_t num_objects) : rng(7), jitter(-1.0f, 1.0f) {
+    std::uniform_real_distribution<float> coord(0.0f, 860.0f);
+    std::uniform_real_distribution<float> speed(-2.0f, 2.0f);
+    for (uint32_t i = 0; i < num_objects; ++i) {
+      x.push_back(coord(rng));
+      y.push_back(coord(rng) * 0.5f);
+      vx.push_back(speed(rng));
+      vy.push_back(speed(rng));
+    }
+  }
+
+  void fill(DetectionFrame& frame, uint64_t frame_number) {
+    frame.frame_number = frame_number;
+    frame.timestamp = frame_number * 33333333;
+    frame.source_id = 0;
+    frame.num_objects = static_cast<uint32_t>(x.size());
+    for (uint32_t i = 0; i < frame.num_objects; ++i) {
+      x[i] += vx[i];
+      y[i] += vy[i];
+      auto& det = frame.objects[i];
+      det = {static_cast<int32_t>(i % 4), 0.8f, x[i] + jitter(rng), y[i] + jitter(rng), 60.0f, 80.0f, {}};
+      app_common::copyLabel(det.label, kLabels[i % 4]);
+    }
+  }
+
+  std::mt19937 rng;
+  std::uniform_real_distribution<float> jitter;
+  std::vector<float> x, y, vx, vy;
+};
+}  // namespace
+
+static void BM_TrackerUpdate(benchmark::State& state) {
+  Scene scene(static_cast<uint32_t>(state.range(0)));
+  auto frame = std::make_unique<DetectionFrame>();
+  app_common::Tracker tracker;
+  app_common::TrackDelta delta;
+  uint64_t frame_number = 0;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    scene.fill(*frame, frame_number++);
+    state.ResumeTiming();
+    tracker.update(*frame, &delta);
+    benchmark::DoNotOptimize(delta.moved.data());
+  }
+}
+BENCHMARK(BM_TrackerUpdate)->Arg(10)->Arg(100)->Arg(500);
+
+// 프레임마다 전체 목록(det)을 보낼 때와 변화만(trk) 보낼 때의 바이트 수
+static void BM_TrackDeltaVolume(benchmark::State& state) {
+  Scene scene(static_cast<uint32_t>(state.range(0)));
+  auto frame = std::make_unique<DetectionFrame>();
+  app_common::Tracker tracker;
+  app_common::TrackDelta delta;
+  std::string out;
+  uint64_t frame_number = 0;
+  std::size_t full_bytes = 0;
+  std::size_t delta_bytes = 0;
+
+  for (auto _ : state) {
+    scene.fill(*frame, frame_number++);
+    tracker.update(*frame, &delta);
+    app_common::writeDetectionJson(*frame, out);
+    full_bytes += out.size();
+    if (!delta.empty()) {
+      app_common::writeTrackDeltaJson(*frame, delta, false, out);
+      delta_bytes += out.size();
+    }
+  }
+  state.counters["full_bytes_per_frame"] = static_cast<double>(full_bytes) / static_cast<double>(frame_number);
+  state.counters["delta_bytes_per_frame"] = static_cast<double>(delta_bytes) / static_cast<double>(frame_number);
+}
+BENCHMARK(BM_TrackDeltaVolume)->Arg(10)->Arg(100);
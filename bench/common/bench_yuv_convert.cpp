@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "common/vision/yuv_convert.hpp"
+
+using app_common::ImageView;
+using app_common::PixelFormat;
+using app_common::SimdLevel;
+
+namespace {
+constexpr int kWidth = 1920;
+constexpr int kHeight = 1080;
+
+struct Frame {
+  Frame(PixelFormat format, int width, int height) {
+    view.format = format;
+    view.width = width;
+    view.height = height;
+    const std::size_t luma = static_cast<std::size_t>(width) * height;
+    if (format == PixelFormat::Rgba) {
+      bytes.resize(luma * 4);
+      view.stride[0] = width * 4;
+    } else {
+      bytes.resize(luma * 3 / 2);
+      view.stride[0] = width;
+      view.stride[1] = format == PixelFormat::Nv12 ? width : width / 2;
+      view.stride[2] = width / 2;
+      view.data[1] = bytes.data() + luma;
+      view.data[2] = bytes.data() + luma + luma / 4;
+    }
+    view.data[0] = bytes.data();
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (auto& v : bytes) v = static_cast<uint8_t>(dist(rng));
+  }
+
+  ImageView view;
+  std::vector<uint8_t> bytes;
+};
+
+void convertFrames(benchmark::State& state, PixelFormat dst_format, int dst_width, int dst_height) {
+  const auto level = static_cast<SimdLevel>(state.range(0));
+  Frame src(PixelFormat::Nv12, kWidth, kHeight);
+  Frame dst(dst_format, dst_width, dst_height);
+  app_common::YuvConverter converter(level);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(converter.convert(src.view, dst.view));
+    benchmark::ClobberMemory();
+  }
+  state.SetLabel(app_common::simdLevelName(converter.level()));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+}  // namespace
+
+// 1080p NV12 -> 추론 입력 크기 RGBA (visionconvert 의 기본 경로)
+static void BM_Nv12ToRgbaScaled(benchmark::State& state) { convertFrames(state, PixelFormat::Rgba, 960, 544); }
+// 스케일 없는 1080p NV12 -> RGBA, 줄 커널만의 처리량
+static void BM_Nv12ToRgba(benchmark::State& state) { convertFrames(state, PixelFormat::Rgba, kWidth, kHeight); }
+// 1080p NV12 -> I420, UV 분리 커널
+static void BM_Nv12ToI420(benchmark::State& state) { convertFrames(state, PixelFormat::I420, kWidth, kHeight); }
+
+#define YUV_SIMD_LEVELS                        \
+  Arg(static_cast<int>(SimdLevel::Scalar))     \
+      ->Arg(static_cast<int>(SimdLevel::Sse2)) \
+      ->Arg(static_cast<int>(SimdLevel::Avx2)) \
+      ->Arg(static_cast<int>(SimdLevel::Neon))
+
+BENCHMARK(BM_Nv12ToRgbaScaled)->YUV_SIMD_LEVELS;
+BENCHMARK(BM_Nv12ToRgba)->YUV_SIMD_LEVELS;
+BENCHMARK(BM_Nv12ToI420)->YUV_SIMD_LEVELS;
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <gst/gst.h>
+
+#include <iterator>
+#include <string>
+
+// visionconvert 와 표준 videoconvert(+videoscale) 의 파이프라인 처리량 비교.
+// 1080p NV12 한 장을 imagefreeze 로 반복해 소스 비용을 빼고, 변환 요소만 바꿔 가며 EOS 까지 돌린다.
+// items_per_second 가 초당 변환한 프레임 수이고, Source 는 변환 없이 같은 버퍼만 흘려 보낸 기준선이다.
+
+namespace {
+constexpr int kFramesPerRun = 200;
+
+struct Case {
+  const char* label;
+  const char* converter;  // 빈 문자열이면 변환 없음
+  const char* output_caps;
+};
+
+constexpr const char* kInferenceCaps = "video/x-raw,format=RGBA,width=960,height=544";
+constexpr const char* kPreviewCaps = "video/x-raw,format=I420,width=960,height=544";
+
+// CameraService 의 conv3(추론 RGBA) 와 front_conv(미리보기 I420) 경로
+const Case kCases[] = {
+    {"source only", "", "video/x-raw,format=NV12,width=1920,height=1080"},
+    {"videoconvert+videoscale rgba", "videoconvert ! videoscale", kInferenceCaps},
+    {"videoconvert+videoscale(nearest) rgba", "videoconvert ! videoscale method=nearest-neighbour", kInferenceCaps},
+    {"visionconvert rgba", "visionconvert", kInferenceCaps},
+    {"videoconvert+videoscale i420", "videoconvert ! videoscale", kPreviewCaps},
+    {"videoconvert+videoscale(nearest) i420", "videoconvert ! videoscale method=nearest-neighbour", kPreviewCaps},
+    {"visionconvert i420", "visionconvert", kPreviewCaps},
+};
+
+// in-tree 플러그인을 등록하고 visionconvert 를 찾을 수 있는지 돌려준다
+bool ensureGst() {
+  static const bool ready = [] {
+    gst_init(nullptr, nullptr);
+    gst_registry_scan_path(gst_registry_get(), VISION_PLUGIN_DIR);
+    GstElementFactory* factory = gst_element_factory_find("visionconvert");
+    if (factory) gst_object_unref(factory);
+    return factory != nullptr;
+  }();
+  return ready;
+}
+
+std::string describe(const Case& c) {
+  std::string desc = "videotestsrc num-buffers=1 pattern=smpte ! video/x-raw,format=NV12,width=1920,height=1080"
+                     " ! imagefreeze num-buffers=" +
+                     std::to_string(kFramesPerRun) + " ! ";
+  if (*c.converter) desc += std::string(c.converter) + " ! ";
+  return desc + c.output_caps + " ! fakesink sync=false";
+}
+
+// EOS 면 true, 에러면 error 에 메시지를 담고 false
+bool runToEos(GstElement* pipeline, std::string& error) {
+  GstBus* bus = gst_element_get_bus(pipeline);
+  gst_element_set_state(pipeline, GST_STATE_PLAYING);
+  GstMessage* msg = gst_bus_timed_pop_filtered(bus, GST_CLOCK_TIME_NONE,
+                                               static_cast<GstMessageType>(GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+  bool ok = msg && GST_MESSAGE_TYPE(msg) == GST_MESSAGE_EOS;
+  if (msg && !ok) {
+    GError* err = nullptr;
+    gst_message_parse_error(msg, &err, nullptr);
+    error = err ? err->message : "unknown error";
+    if (err) g_error_free(err);
+  }
+  if (msg) gst_message_unref(msg);
+  gst_element_set_state(pipeline, GST_STATE_NULL);
+  gst_object_unref(bus);
+  return ok;
+}
+}  // namespace
+
+static void BM_ConvertPipeline(benchmark::State& state) {
+  const Case& c = kCases[state.range(0)];
+  state.SetLabel(c.label);
+  if (!ensureGst() && std::string(c.converter).find("visionconvert") != std::string::npos) {
+    state.SkipWithError("visionconvert plugin not found");
+    return;
+  }
+
+  GError* parse_error = nullptr;
+  GstElement* pipeline = gst_parse_launch(describe(c).c_str(), &parse_error);
+  if (!pipeline || parse_error) {
+    state.SkipWithError(parse_error ? parse_error->message : "gst_parse_launch failed");
+    if (parse_error) g_error_free(parse_error);
+    if (pipeline) gst_object_unref(pipeline);
+    return;
+  }
+
+  std::string error;
+  for (auto _ : state) {
+    if (!runToEos(pipeline, error)) {
+      state.SkipWithError(error.c_str());
+      break;
+    }
+  }
+  gst_object_unref(pipeline);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kFramesPerRun);
+}
+BENCHMARK(BM_ConvertPipeline)->DenseRange(0, static_cast<int>(std::size(kCases)) - 1)->Unit(benchmark::kMillisecond);
@@ -1,13 +1,17 @@
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "common/utils/logging.hpp"
 #include "common/zmq/pub_socket.hpp"
-#include "common/zmq/rep_socket.hpp"
+#include "common/zmq/router_socket.hpp"
 #include "config/app_config.hpp"
+#include "config/camera_config.hpp"
 #include "config/zmq_config.hpp"
 #include "services/audio/audio_service.hpp"
 #include "services/bluetooth/bluetooth_service.hpp"
 #include "services/camera/camera_service.hpp"
+#include "services/config/config_service.hpp"
 #include "services/control/control_service.hpp"
 #include "services/infer/ai_service.hpp"
 
@@ -29,16 +33,37 @@ ZMQ logger level: {}
 int main(int argc, char* argv[]) {
   initLogging();
   gst_init(&argc, &argv);
+  // in-tree 플러그인 (visionconvert, visionfakeinfer). DeepStream 없는 프로파일에서는 CameraService 가 이들을 쓴다.
+  // gst_init 이 이미 GST_PLUGIN_PATH 를 훑었으므로 그쪽에 같은 플러그인이 있으면 그것이 남는다
+  if (*app_config::kPluginPath) gst_registry_scan_path(gst_registry_get(), app_config::kPluginPath);
 
   zmq::context_t ctx{1};
   PubSocket pub_socket(ctx, app_config::kEventEndpoint);
-  RepSocket rep_socket(ctx, app_config::kControlEndpoint);
+  // 검출 결과는 최신 것만 의미가 있고, 상태 이벤트는 검출 트래픽에 밀리면 안 된다
+  pub_socket.registerTopic(app_config::kTopicDetections,
+                           {PubSocket::Priority::Normal, app_common::OverflowPolicy::DropOldest});
+  pub_socket.registerTopic(app_config::kTopicDetectionsBinary,
+                           {PubSocket::Priority::Normal, app_common::OverflowPolicy::DropOldest});
+  pub_socket.registerTopic(app_config::kTopicDetectionLabels,
+                           {PubSocket::Priority::High, app_common::OverflowPolicy::DropOldest});
+  // trk delta 는 버려지면 AiService 가 알 수 있도록 DropNewest 로 두고, 다음 프레임에 sync 를 보낸다
+  pub_socket.registerTopic(app_config::kTopicTracks,
+                           {PubSocket::Priority::High, app_common::OverflowPolicy::DropNewest});
+  // 상태 토픽은 마지막 값을 캐시해 EVENT_SNAPSHOT 으로 재동기화할 수 있게 한다
+  pub_socket.registerTopic(app_config::kTopicTrackChanged,
+                           {PubSocket::Priority::High, app_common::OverflowPolicy::DropOldest, true});
+  pub_socket.registerTopic(app_config::kTopicBluetooth,
+                           {PubSocket::Priority::High, app_common::OverflowPolicy::DropOldest, true});
+  pub_socket.registerTopic(app_config::kTopicJob, {PubSocket::Priority::High, app_common::OverflowPolicy::DropOldest});
+  pub_socket.registerTopic(app_config::kTopicMetrics,
+                           {PubSocket::Priority::Normal, app_common::OverflowPolicy::DropOldest});
+  RouterSocket router_socket(ctx, app_config::kControlEndpoint);
 
   // 음악 서비스
   MusicService music(MusicService::PipelineMode::Custom, pub_socket);
 
   // 카메라 서비스
-  CameraService camera;
+  CameraService camera(pub_socket, CameraService::InferenceSinkMode::MetadataOnly);
 
   // 블루투스 서비스
   BluetoothService bt(pub_socket);
@@ -47,15 +72,31 @@ int main(int argc, char* argv[]) {
   AudioService audio;
 
   // 추론 서비스
-  AiService ai(camera.getInferenceAppsink(), pub_socket);
+  AiService ai(camera.getInferenceAppsink(), pub_socket, camera.getInferenceSinkMode());
+  camera.setConsumerCounters([&ai] { return ai.pulledSamples(); }, [&ai] { return ai.dropped(); });
+  ai.setActivityListener([&camera](uint32_t num_objects) { camera.onDetections(num_objects); });
+  camera.setStaticFrameListener([&ai](uint64_t pts) { ai.onStaticFrame(pts); });
+  camera.setRoiListener([&ai](const std::vector<app_common::RoiTransform>& by_pad) { ai.setRoiTransforms(by_pad); });
+  ai.start();
 
-  ControlService control(rep_socket);
+  // 실행 중 설정 (파일 감시 + CONFIG_SET)
+  ConfigService config(camera, std::string(app_config::kRuntimeConfigFile));
+  config.start();
+
+  ControlService control(router_socket, pub_socket);
   control.registerMusicService(music);
   control.registerCameraService(camera);
   control.registerBluetoothService(bt);
   control.registerAudioService(audio);
+  control.registerAiService(ai);
+  control.registerEventBus(pub_socket);
+  control.registerConfigService(config);
 
   control.poll();
+  config.stop();
+  camera.setConsumerCounters({}, {});
+  camera.setStaticFrameListener({});
+  camera.setRoiListener({});
 
   SPDLOG_INFO(R"(
 ===============================================
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace app_common {
+
+inline constexpr std::size_t kMaxDetectionsPerFrame = 512;
+inline constexpr std::size_t kMaxLabelLength = 32;
+
+// 스트리밍 스레드에서 NvDsObjectMeta 를 그대로 복사해 두는 POD 레코드
+struct Detection {
+  int32_t class_id;
+  float confidence;
+  float x;
+  float y;
+  float w;
+  float h;
+  char label[kMaxLabelLength];
+  uint32_t track_id{0};  // Tracker 가 붙인 id. 0 이면 추적하지 않음
+};
+
+struct DetectionFrame {
+  uint64_t frame_number;
+  uint64_t timestamp;
+  uint32_t source_id;
+  uint32_t num_objects;
+  Detection objects[kMaxDetectionsPerFrame];
+};
+
+// NvDsObjectMeta 의 라벨(최대 128 bytes)보다 짧으므로 잘릴 수 있다. UTF-8 문자 중간에서는 자르지 않는다.
+inline void copyLabel(char (&dst)[kMaxLabelLength], const char* src) {
+  if (!src) {
+    dst[0] = '\0';
+    return;
+  }
+  std::strncpy(dst, src, kMaxLabelLength - 1);
+  dst[kMaxLabelLength - 1] = '\0';
+
+  auto is_continuation = [](char c) { return (static_cast<unsigned char>(c) & 0xC0) == 0x80; };
+  std::size_t length = std::strlen(dst);
+  if (!is_continuation(src[length])) return;
+  while (length > 0 && is_continuation(dst[length - 1])) --length;
+  if (length > 0) --length;  // 잘린 문자의 첫 byte
+  dst[length] = '\0';
+}
+
+// 유효한 객체 수만큼만 복사한다 (슬롯 전체 복사 방지)
+inline void copyFrame(DetectionFrame& dst, const DetectionFrame& src) {
+  dst.frame_number = src.frame_number;
+  dst.timestamp = src.timestamp;
+  dst.source_id = src.source_id;
+  dst.num_objects = src.num_objects < kMaxDetectionsPerFrame ? src.num_objects : kMaxDetectionsPerFrame;
+  std::memcpy(dst.objects, src.objects, sizeof(Detection) * dst.num_objects);
+}
+
+}  // namespace app_common
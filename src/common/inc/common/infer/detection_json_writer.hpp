@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "common/infer/detection.hpp"
+#include "common/infer/tracker.hpp"
+
+namespace app_common {
+
+// doc/infer-schema.json 레이아웃 그대로 DetectionFrame 을 JSON 으로 기록한다.
+// out 은 비운 뒤 다시 채우므로 같은 버퍼를 재사용하면 용량이 유지되어 프레임마다 힙 할당이 없다.
+void writeDetectionJson(const DetectionFrame& frame, std::string& out);
+
+// 추적 변화만 담은 메시지. born 은 객체 전체, moved 는 track_id 와 box, died 는 track id 목록이다.
+// sync 이면 새 구독자를 위해 살아 있는 확정 track 전체를 born 으로 보내는 메시지임을 표시한다.
+void writeTrackDeltaJson(const DetectionFrame& frame, const TrackDelta& delta, bool sync, std::string& out);
+
+// 호출 스레드 전용(thread_local) 버퍼에 기록한다.
+// 반환된 view 는 같은 스레드에서 다음 호출이 있을 때까지만 유효하다.
+std::string_view writeDetectionJson(const DetectionFrame& frame);
+
+}  // namespace app_common
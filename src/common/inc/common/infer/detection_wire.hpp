@@ -0,0 +1,145 @@
+#pragma once
+
+// 검출 결과 바이너리 포맷 (v1) 정의와 디코더.
+// 프론트엔드에서도 그대로 가져다 쓸 수 있도록 표준 라이브러리만 사용한다.
+//
+// 모든 정수/실수는 little-endian 이다.
+//
+//   공통 헤더 (8 bytes)
+//     char[2]  magic   = "VD"
+//     uint8    version = 1
+//     uint8    kind    (0 = Frame, 1 = Labels)
+//     uint32   count   (Frame: 객체 수, Labels: 라벨 수)
+//
+//   Frame  : 헤더 뒤에 uint64 frame_number, uint64 timestamp, uint32 source_id, uint32 reserved (24 bytes)
+//            이어서 count 개의 WireDetection (24 bytes)
+//   Labels : 헤더 뒤에 count 개의 { int32 class_id, uint8 length, char[length] }
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "detection wire format assumes a little-endian host"
+#endif
+
+namespace app_common::wire {
+
+inline constexpr char kMagic[2] = {'V', 'D'};
+inline constexpr uint8_t kVersion = 1;
+
+enum class MessageKind : uint8_t { Frame = 0, Labels = 1 };
+
+#pragma pack(push, 1)
+struct Header {
+  char magic[2];
+  uint8_t version;
+  uint8_t kind;
+  uint32_t count;
+};
+
+struct FrameInfo {
+  uint64_t frame_number;
+  uint64_t timestamp;
+  uint32_t source_id;
+  uint32_t reserved;
+};
+
+struct WireDetection {
+  int32_t class_id;
+  float confidence;
+  float x;
+  float y;
+  float w;
+  float h;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(Header) == 8, "wire header must be 8 bytes");
+static_assert(sizeof(FrameInfo) == 24, "wire frame info must be 24 bytes");
+static_assert(sizeof(WireDetection) == 24, "wire detection must be 24 bytes");
+
+inline constexpr std::size_t kFrameHeaderSize = sizeof(Header) + sizeof(FrameInfo);
+
+// 헤더만 검사해 메시지 종류를 돌려준다. 알 수 없는 메시지면 false.
+inline bool peekKind(const void* data, std::size_t size, MessageKind& kind) {
+  if (!data || size < sizeof(Header)) return false;
+  Header header;
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic[0] != kMagic[0] || header.magic[1] != kMagic[1] || header.version != kVersion) return false;
+  if (header.kind > static_cast<uint8_t>(MessageKind::Labels)) return false;
+  kind = static_cast<MessageKind>(header.kind);
+  return true;
+}
+
+// 버퍼를 복사하지 않고 프레임 메시지를 읽는다. 버퍼는 view 보다 오래 살아 있어야 한다.
+class FrameView {
+public:
+  bool parse(const void* data, std::size_t size) {
+    MessageKind kind;
+    if (!peekKind(data, size, kind) || kind != MessageKind::Frame || size < kFrameHeaderSize) return false;
+
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    Header header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (size != kFrameHeaderSize + static_cast<std::size_t>(header.count) * sizeof(WireDetection)) return false;
+
+    std::memcpy(&info_, bytes + sizeof(Header), sizeof(info_));
+    count_ = header.count;
+    objects_ = bytes + kFrameHeaderSize;
+    return true;
+  }
+
+  uint64_t frameNumber() const { return info_.frame_number; }
+  uint64_t timestamp() const { return info_.timestamp; }
+  uint32_t sourceId() const { return info_.source_id; }
+  std::size_t size() const { return count_; }
+
+  WireDetection operator[](std::size_t index) const {
+    WireDetection det;
+    std::memcpy(&det, objects_ + index * sizeof(WireDetection), sizeof(det));
+    return det;
+  }
+
+private:
+  FrameInfo info_{};
+  std::size_t count_{0};
+  const uint8_t* objects_{nullptr};
+};
+
+namespace detail {
+template <typename Fn>
+bool walkLabels(const uint8_t* bytes, std::size_t size, uint32_t count, Fn&& fn) {
+  std::size_t offset = sizeof(Header);
+  for (uint32_t i = 0; i < count; ++i) {
+    if (offset + sizeof(int32_t) + 1 > size) return false;
+    int32_t class_id;
+    std::memcpy(&class_id, bytes + offset, sizeof(class_id));
+    const uint8_t length = bytes[offset + sizeof(int32_t)];
+    offset += sizeof(int32_t) + 1;
+
+    if (offset + length > size) return false;
+    fn(class_id, std::string_view(reinterpret_cast<const char*>(bytes + offset), length));
+    offset += length;
+  }
+  return offset == size;
+}
+}  // namespace detail
+
+// 라벨 테이블 메시지를 읽는다.
+// 메시지 전체가 올바른 경우에만 fn(int32_t class_id, std::string_view label) 을 호출한다.
+template <typename Fn>
+bool forEachLabel(const void* data, std::size_t size, Fn&& fn) {
+  MessageKind kind;
+  if (!peekKind(data, size, kind) || kind != MessageKind::Labels) return false;
+
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  Header header;
+  std::memcpy(&header, bytes, sizeof(header));
+
+  if (!detail::walkLabels(bytes, size, header.count, [](int32_t, std::string_view) {})) return false;
+  return detail::walkLabels(bytes, size, header.count, fn);
+}
+
+}  // namespace app_common::wire
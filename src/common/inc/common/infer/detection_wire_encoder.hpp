@@ -0,0 +1,27 @@
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "common/infer/detection.hpp"
+#include "common/infer/detection_wire.hpp"
+
+namespace app_common::wire {
+
+// DetectionFrame 을 바이너리 포맷으로 기록하고, 지금까지 본 class_id -> label 테이블을 관리한다.
+// class_id 는 범위 제한 없이 모두 테이블에 들어간다.
+class DetectionWireEncoder {
+public:
+  // out 을 비우고 프레임 메시지를 기록한다. 처음 보는 라벨이 있었으면 true.
+  bool encodeFrame(const DetectionFrame& frame, std::string& out);
+
+  // out 을 비우고 현재 라벨 테이블 메시지를 기록한다.
+  void encodeLabels(std::string& out) const;
+
+private:
+  bool learnLabel(const Detection& det);
+
+  std::map<int32_t, std::string> labels_;
+};
+
+}  // namespace app_common::wire
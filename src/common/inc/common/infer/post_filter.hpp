@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common/infer/detection.hpp"
+
+namespace app_common {
+
+// 클래스별 임계값 표의 크기. 설정에는 [0, kMaxFilterClasses) 의 class_id 만 쓸 수 있다.
+// 검출에 이 범위 밖의 class_id 가 오면 기본 임계값을 쓴다 (허용 목록이 있으면 버린다).
+inline constexpr int32_t kMaxFilterClasses = 256;
+
+struct PostFilterConfig {
+  float min_confidence{0.0f};
+  std::vector<std::pair<int32_t, float>> class_confidence;  // class_id 별로 min_confidence 대신 쓸 값
+  std::vector<int32_t> allowed_classes;                     // 비어 있으면 모든 클래스 허용
+  float min_area{0.0f};                                     // 박스 넓이 (streammux 좌표, px^2)
+  float nms_iou{0.0f};                                      // 같은 클래스끼리 이 IoU 를 넘으면 낮은 쪽을 버림. 0 이면 끔
+};
+
+// "class:conf;class:conf" 형식. 빈 문자열은 클래스별 임계값 없음. class 는 [0, kMaxFilterClasses), conf 는 [0, 1].
+bool parseClassThresholds(std::string_view text, std::vector<std::pair<int32_t, float>>& thresholds,
+                          std::string& error);
+std::string formatClassThresholds(const std::vector<std::pair<int32_t, float>>& thresholds);
+// "class;class" 형식. 빈 문자열은 모든 클래스 허용. class 는 [0, kMaxFilterClasses).
+bool parseClassList(std::string_view text, std::vector<int32_t>& classes, std::string& error);
+std::string formatClassList(const std::vector<int32_t>& classes);
+// 값의 범위를 검사한다: confidence / nms_iou 는 [0, 1], min_area >= 0, class_id 는 [0, kMaxFilterClasses).
+bool validatePostFilter(const PostFilterConfig& config, std::string& error);
+
+// 검출 후처리 필터. 객체를 struct-of-arrays 로 복사한 뒤 분기 없는 루프로 임계값/넓이를 검사하고,
+// NMS 의 IoU 는 SSE2/NEON 으로 4 개씩 계산한다. 살아남은 객체는 원래 순서대로 앞으로 당긴다.
+// 내부 버퍼를 재사용하므로 한 인스턴스는 한 스레드에서만 써야 한다.
+class PostFilter {
+public:
+  explicit PostFilter(const PostFilterConfig& config = {});
+
+  // 아무것도 거르지 않는 설정이면 true (apply 를 건너뛸 수 있다)
+  bool passThrough() const { return pass_through_; }
+  const PostFilterConfig& config() const { return config_; }
+
+  // 버린 객체 수를 돌려준다.
+  uint32_t apply(DetectionFrame& frame);
+
+private:
+  struct Boxes {
+    std::vector<float> x1, y1, x2, y2, area;
+    std::vector<int32_t> class_id;
+    void resize(std::size_t count);
+  };
+
+  void load(const DetectionFrame& frame, std::size_t count);
+  void suppressOverlaps(std::size_t count);
+
+  PostFilterConfig config_;
+  bool pass_through_{true};
+  float default_threshold_{0.0f};
+  std::vector<float> class_threshold_;  // class_id -> 최소 confidence, 허용되지 않은 클래스는 +inf
+
+  // SoA 작업 버퍼
+  Boxes boxes_;   // 프레임 순서
+  Boxes sorted_;  // NMS 후보를 confidence 내림차순으로 모은 것
+  std::vector<float> confidence_, threshold_;
+  std::vector<uint8_t> keep_;
+  std::vector<int32_t> alive_;  // sorted_ 기준 생존 여부
+  std::vector<uint32_t> order_;
+};
+
+}  // namespace app_common
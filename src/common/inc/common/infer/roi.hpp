@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/infer/detection.hpp"
+
+namespace app_common {
+
+// 원본 프레임 픽셀 좌표의 관심 영역. nvvideoconvert src-crop 과 같은 "x:y:w:h" 로 주고받는다.
+struct RoiRect {
+  int x{0};
+  int y{0};
+  int width{0};
+  int height{0};
+
+  bool operator==(const RoiRect& other) const {
+    return x == other.x && y == other.y && width == other.width && height == other.height;
+  }
+  bool operator!=(const RoiRect& other) const { return !(*this == other); }
+};
+
+inline constexpr int kMinRoiSize = 16;
+
+// "x:y:w:h;x:y:w:h" 형식. 빈 문자열은 ROI 없음.
+bool parseRois(std::string_view text, std::vector<RoiRect>& rois, std::string& error);
+std::string formatRoi(const RoiRect& roi);
+std::string formatRois(const std::vector<RoiRect>& rois);
+
+// NV12 crop 을 위해 좌표를 짝수로 내리고 프레임 안으로 자른다. 너무 작아지면 false.
+bool normalizeRoi(RoiRect& roi, int frame_width, int frame_height);
+
+// streammux 입력 하나(pad)의 검출 좌표를 같은 source 의 전체 프레임 좌표로 옮기는 변환.
+// streammux 는 모든 입력을 같은 해상도로 스케일하므로, 전체 프레임 입력은 항등 변환이다.
+struct RoiTransform {
+  uint32_t source_id{0};
+  float offset_x{0.0f};
+  float offset_y{0.0f};
+  float scale_x{1.0f};
+  float scale_y{1.0f};
+
+  void apply(Detection& det) const {
+    det.x = offset_x + det.x * scale_x;
+    det.y = offset_y + det.y * scale_y;
+    det.w *= scale_x;
+    det.h *= scale_y;
+  }
+};
+
+// roi 를 mux_width x mux_height 로 스케일한 입력의 검출을, 전체 프레임을 같은 해상도로 스케일한 좌표로 옮긴다.
+RoiTransform roiTransform(const RoiRect& roi, int frame_width, int frame_height, int mux_width, int mux_height,
+                          uint32_t source_id);
+
+// 전체 프레임 좌표로 옮긴 ROI 검출 [first_roi_object, num_objects) 중, 앞선 검출(전체 프레임 또는 다른 ROI)과
+// 같은 class 이고 겹침(교집합 / 작은 박스 넓이)이 min_overlap 이상인 것을 하나로 합친다. 신뢰도가 높은 쪽이 남는다.
+// ROI 경계에서 잘린 박스도 잡도록 IoU 대신 작은 박스 기준 겹침을 쓴다. 지운 검출 수를 돌려준다.
+uint32_t mergeRoiDetections(DetectionFrame& frame, uint32_t first_roi_object, float min_overlap);
+
+// 추론 배치 안의 프레임 하나
+struct BatchFrame {
+  uint32_t pad_index{0};
+  uint64_t pts{0};
+};
+
+inline constexpr int kBatchRepresentative = -1;  // 이 프레임으로 DetectionFrame 하나를 만든다
+inline constexpr int kBatchDropped = -2;         // 변환표에 없는 pad (ROI 가 바뀌는 중)
+
+// pad 번호 순으로 정렬된 frames 에서 같은 source 의 같은 PTS 프레임(전체 프레임 + ROI crop)을 묶는다.
+// group[i] 는 i 가 합쳐질 대표 프레임(앞선 프레임 중 가장 먼저 나온 것)의 번호이거나 위의 값이다.
+// 대표 프레임은 frames 순서를 그대로 따르므로 source 별 순서가 유지된다.
+void groupBatchFrames(const BatchFrame* frames, std::size_t count, const std::vector<RoiTransform>& by_pad, int* group);
+
+}  // namespace app_common
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/infer/detection.hpp"
+
+namespace app_common {
+
+struct SyntheticConfig {
+  uint32_t objects_per_frame{10};
+  uint32_t num_classes{4};
+  float frame_width{1920.0f};  // streammux 좌표계
+  float frame_height{1080.0f};
+  uint64_t seed{1};
+  // 비어 있지 않으면 스크립트 모드: 프레임마다 한 줄씩 쓰고 끝나면 처음부터 반복한다
+  std::vector<std::vector<Detection>> script;
+};
+
+// 한 줄이 한 프레임. "class:conf:x:y:w:h;class:conf:x:y:w:h" 형식이고
+// 빈 줄은 객체가 없는 프레임, '#' 로 시작하는 줄은 주석이다.
+bool parseSyntheticScript(std::string_view text, std::vector<std::vector<Detection>>& frames, std::string& error);
+
+// 추론 엔진 없이 검출 결과를 만들어 내는 생성기. 같은 설정과 seed 면 플랫폼과 무관하게 같은 순서를 낸다.
+// 랜덤 모드의 객체는 일정한 속도로 움직이다 화면 끝에서 튕기므로 추적기에도 그럴듯한 입력이 된다.
+class SyntheticDetector {
+public:
+  explicit SyntheticDetector(const SyntheticConfig& config = {});
+
+  // frame 의 objects / num_objects 만 채운다. frame_number, timestamp, source_id 는 호출자 몫.
+  void next(DetectionFrame& frame);
+  void reset();
+  uint64_t framesGenerated() const { return frames_; }
+
+private:
+  struct Mover {
+    Detection det;
+    float vx;
+    float vy;
+  };
+
+  uint64_t nextRandom();
+  float uniform(float lo, float hi);
+  void spawn(Mover& mover);
+
+  SyntheticConfig config_;
+  uint64_t state_{0};
+  uint64_t frames_{0};
+  std::vector<Mover> movers_;
+};
+
+}  // namespace app_common
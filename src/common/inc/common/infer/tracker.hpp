@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "common/infer/detection.hpp"
+
+namespace app_common {
+
+struct TrackerConfig {
+  float iou_threshold{0.3f};   // 예측 박스와 검출의 최소 IoU (같은 class 끼리만 비교)
+  uint32_t max_age{5};         // 이 프레임 수만큼 연속으로 매칭되지 않으면 track 삭제
+  uint32_t min_hits{3};        // 이만큼 매칭되어야 확정(born)된다
+  float delta_threshold{0.05f};  // 마지막으로 보낸 박스 대비 위치/크기 변화가 박스 크기의 이 비율을 넘으면 moved
+};
+
+// 한 프레임에서 바뀐 것. born / moved 는 frame.objects 의 인덱스, died 는 track id.
+struct TrackDelta {
+  std::vector<uint32_t> born;
+  std::vector<uint32_t> moved;
+  std::vector<uint32_t> died;
+
+  bool empty() const { return born.empty() && moved.empty() && died.empty(); }
+  void clear() {
+    born.clear();
+    moved.clear();
+    died.clear();
+  }
+};
+
+// SORT 방식의 IoU + Kalman 다중 객체 추적기.
+// 상태는 (cx, cy, w, h) 축마다 독립적인 등속 Kalman 필터이고, track 들은 축별 배열(SoA)에 저장해
+// 예측과 IoU 계산이 track 수만큼의 연속 메모리를 순서대로 훑도록 했다.
+// 매칭은 IoU 내림차순 greedy 로 한다. 출력 박스는 검출값을 그대로 두고 track_id 만 채운다.
+class Tracker {
+public:
+  explicit Tracker(const TrackerConfig& config = {});
+
+  // frame 의 검출마다 track_id 를 채우고, delta 가 있으면 확정 track 의 변화를 기록한다.
+  // 확정 전 track 의 검출도 id 를 받지만 born 되기 전까지 delta 에는 나오지 않는다.
+  void update(DetectionFrame& frame, TrackDelta* delta = nullptr);
+
+  // 살아 있는 확정 track 들의 마지막으로 보낸 박스를 frame 에 채운다 (새 구독자 동기화용).
+  void snapshot(DetectionFrame& frame) const;
+
+  std::size_t size() const { return ids_.size(); }
+  void reset();
+
+private:
+  static constexpr int kDims = 4;  // cx, cy, w, h
+
+  void predict();
+  std::size_t spawn(const Detection& det);
+  void correct(std::size_t track, const Detection& det);
+  void remove(std::size_t track);
+  void publishBox(std::size_t track, const Detection& det);
+  bool movedSincePublished(std::size_t track, const Detection& det) const;
+
+  TrackerConfig config_;
+  uint32_t next_id_{1};
+
+  // track 별 속성 (모두 같은 길이)
+  std::vector<uint32_t> ids_;
+  std::vector<int32_t> class_ids_;
+  std::vector<uint32_t> hits_;
+  std::vector<uint32_t> misses_;
+  std::vector<uint8_t> confirmed_;
+  std::array<std::vector<float>, kDims> mean_;
+  std::array<std::vector<float>, kDims> velocity_;
+  std::array<std::vector<float>, kDims> var_pos_;
+  std::array<std::vector<float>, kDims> cov_pos_vel_;
+  std::array<std::vector<float>, kDims> var_vel_;
+  // 마지막으로 delta 에 실린 값
+  std::array<std::vector<float>, kDims> published_;
+  std::vector<float> published_confidence_;
+  std::vector<std::array<char, kMaxLabelLength>> labels_;
+
+  // update 중에만 쓰는 작업 공간
+  struct Candidate {
+    float iou;
+    uint32_t track;
+    uint32_t det;
+  };
+  std::vector<Candidate> candidates_;
+  std::vector<int32_t> det_track_;
+  std::vector<uint8_t> track_matched_;
+};
+
+}  // namespace app_common
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace app_common {
+
+// 지원하는 파이프라인 기술 파일의 형식 버전. 형식이 바뀌면 올리고 이전 버전은 거부한다.
+inline constexpr int kPipelineSpecVersion = 1;
+
+// 요소 하나. 속성 값은 모두 문자열로 두고 실제 타입 변환은 GStreamer 가 속성 타입에 맞춰 한다
+// (gst_util_set_object_arg 와 같은 규칙: enum 은 nick, caps 는 caps 문자열).
+struct ElementSpec {
+  std::string name;
+  std::string factory;
+  std::vector<std::pair<std::string, std::string>> properties;  // 파일에 적힌 순서대로 설정한다
+};
+
+// src -> sink 연결. pad 이름이 비어 있으면 호환되는 pad 를 고르고, "sink_%u" 같은 템플릿이면 request pad 를 받는다.
+// dynamic 이면 src 의 sometimes pad 가 생길 때(pad-added) 연결하며, caps 가 있으면 그 이름으로 시작하는 pad 만 받는다.
+struct LinkSpec {
+  std::string src;
+  std::string src_pad;
+  std::string sink;
+  std::string sink_pad;
+  bool dynamic{false};
+  std::string caps;
+};
+
+// 오류 / 로그 메시지용 "src.src_pad -> sink.sink_pad"
+std::string describe(const LinkSpec& link);
+
+struct PipelineSpec {
+  int version{kPipelineSpecVersion};
+  std::string name;
+  std::vector<ElementSpec> elements;
+  std::vector<LinkSpec> links;  // 적힌 순서대로 연결한다 (request pad 번호가 이 순서를 따른다)
+
+  const ElementSpec* find(std::string_view element_name) const;
+  ElementSpec* find(std::string_view element_name);
+  // 속성을 덮어쓰거나 없으면 뒤에 추가한다. 요소가 없으면 false.
+  bool setProperty(std::string_view element_name, const std::string& key, std::string value);
+};
+
+// JSON 을 읽고 validatePipelineSpec 까지 한다. 실패하면 error 에 위치("elements[3].name: ...")를 담는다.
+//   {"version": 1, "name": "...",
+//    "elements": [{"name": "q2", "factory": "queue", "properties": {"max-size-buffers": 5, "leaky": "upstream"}}],
+//    "links": [{"chain": ["a", "b", "c"]},
+//              {"from": "tee", "from_pad": "src_%u", "to": "q2"},
+//              {"from": "uri_src", "to": "uri_queue", "dynamic": true, "caps": "video/x-raw"}]}
+// 속성 값은 문자열 / 숫자 / bool 만 받는다.
+bool parsePipelineSpec(std::string_view text, PipelineSpec& spec, std::string& error);
+// 버전, 이름 중복, 없는 요소를 가리키는 link, 자기 자신으로의 link 등을 검사한다. GStreamer 없이 할 수 있는 검사만 한다.
+bool validatePipelineSpec(const PipelineSpec& spec, std::string& error);
+// parsePipelineSpec 으로 다시 읽을 수 있는 JSON. 기본 파이프라인을 파일로 내보낼 때 쓴다.
+std::string pipelineSpecToJson(const PipelineSpec& spec, int indent = 2);
+// 속성 값의 "${name}" 을 vars 로 바꾼다. 정의되지 않은 변수가 있으면 error 와 함께 false.
+bool expandPipelineSpec(PipelineSpec& spec, const std::map<std::string, std::string>& vars, std::string& error);
+
+}  // namespace app_common
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace app_common {
+
+// 실행 중 바꾸는 설정 하나. target 이 "log" 이면 key 는 logger 이름, value 는 레벨이고
+// 그 밖에는 파이프라인 요소 이름 / 속성 이름 / 속성 값(문자열, PipelineSpec 과 같은 규칙)이다.
+struct RuntimeSetting {
+  std::string target;
+  std::string key;
+  std::string value;
+
+  std::string path() const { return target + "." + key; }
+};
+
+inline constexpr std::string_view kLogTarget = "log";
+
+// 실행 중 설정 파일. 요소 -> {속성: 값} 이고 "log" 는 logger -> 레벨이다.
+//   {"q2": {"max-size-buffers": 3, "leaky": "upstream"},
+//    "front_caps": {"caps": "video/x-raw,format=I420,width=640,height=360"},
+//    "log": {"service": "debug"}}
+// 파일에 적힌 순서대로 settings 에 담는다. 실패하면 위치와 함께 error 를 채우고 settings 는 그대로 둔다.
+bool parseRuntimeConfig(std::string_view text, std::vector<RuntimeSetting>& settings, std::string& error);
+// "q2.max-size-buffers" 처럼 target.key 로 적은 설정 하나 (CONFIG_SET). key 에는 '.' 이 들어가도 된다.
+bool parseRuntimeSetting(std::string_view path, std::string value, RuntimeSetting& setting, std::string& error);
+
+// spdlog logger 의 레벨을 바꾼다 ("trace", "debug", "info", "warn", "error", "critical", "off").
+bool setLogLevel(const std::string& logger, const std::string& level, std::string& error);
+
+}  // namespace app_common
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <string>
+
+namespace app_common {
+
+// 파이프라인 기술 파일과 실행 중 설정 파일이 함께 쓰는 파싱 도우미.
+
+// 속성 값(문자열 / 숫자 / bool)을 GStreamer 가 변환할 문자열로 바꾼다. bool 은 "true" / "false",
+// 숫자는 JSON 표기 그대로. 그 밖의 타입이면 false.
+bool propertyValueString(const nlohmann::ordered_json& value, std::string& out);
+
+// error 를 "where: what" 으로 채우고 false 를 돌려준다.
+bool failAt(std::string& error, const std::string& where, const std::string& what);
+
+}  // namespace app_common
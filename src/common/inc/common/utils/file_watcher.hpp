@@ -0,0 +1,95 @@
+#pragma once
+
+#include <sys/stat.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace app_common {
+
+// 파일을 주기적으로 stat 해서 바뀌면(mtime / 크기) 내용을 callback 으로 넘긴다.
+// 편집기가 파일을 새로 써서 바꾸는 경우도 잡도록 inotify 대신 경로를 다시 본다.
+// 처음 볼 때 파일이 있으면 한 번 호출하고, 없어졌다 다시 생겨도 호출한다. callback 은 감시 스레드에서 불린다.
+class FileWatcher {
+public:
+  using Callback = std::function<void(const std::string& contents)>;
+
+  FileWatcher(std::string path, std::chrono::milliseconds interval, Callback callback)
+      : path_(std::move(path)), interval_(interval), callback_(std::move(callback)) {}
+
+  ~FileWatcher() { stop(); }
+
+  FileWatcher(const FileWatcher&) = delete;
+  FileWatcher& operator=(const FileWatcher&) = delete;
+
+  void start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (thread_.joinable()) return;
+    stopping_ = false;
+    thread_ = std::thread([this] { run(); });
+  }
+
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    cv_.notify_one();
+    if (thread_.joinable()) thread_.join();
+  }
+
+  const std::string& path() const { return path_; }
+
+private:
+  struct Version {
+    bool exists{false};
+    long long mtime_ns{0};
+    long long size{0};
+
+    bool operator==(const Version& other) const {
+      return exists == other.exists && mtime_ns == other.mtime_ns && size == other.size;
+    }
+  };
+
+  Version current() const {
+    struct stat st {};
+    if (::stat(path_.c_str(), &st) != 0) return {};
+    return {true, static_cast<long long>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec,
+            static_cast<long long>(st.st_size)};
+  }
+
+  void run() {
+    Version seen;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+      lock.unlock();
+      const Version now = current();
+      if (now.exists && !(now == seen)) {
+        std::ifstream file(path_);
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        if (file) callback_(contents.str());
+      }
+      seen = now;
+      lock.lock();
+      cv_.wait_for(lock, interval_, [this] { return stopping_; });
+    }
+  }
+
+  const std::string path_;
+  const std::chrono::milliseconds interval_;
+  Callback callback_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopping_{false};
+  std::thread thread_;
+};
+
+}  // namespace app_common
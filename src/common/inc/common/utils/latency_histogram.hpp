@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace app_common {
+
+// 로그-선형 버킷 히스토그램 (HDR histogram 방식).
+// 2 의 거듭제곱 구간마다 kSubBuckets 개의 선형 버킷을 두어 상대 오차를 1/kSubBuckets 이하로 유지한다.
+// record() 는 relaxed atomic 몇 번뿐이라 GStreamer 스트리밍 스레드에서 바로 호출해도 된다.
+class LatencyHistogram {
+public:
+  static constexpr int kSubBucketBits = 4;
+  static constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+  static constexpr int kMaxBits = 40;  // ns 기준 약 18 분까지, 넘으면 마지막 버킷
+  static constexpr uint64_t kMaxValue = (uint64_t{1} << kMaxBits) - 1;
+  static constexpr std::size_t kNumBuckets = (kMaxBits - kSubBucketBits + 1) * kSubBuckets;
+
+  struct Snapshot {
+    std::array<uint64_t, kNumBuckets> counts{};
+    uint64_t count{0};
+    uint64_t sum{0};
+    uint64_t max{0};
+
+    // q 는 0..1. 값이 속한 버킷의 상한을 돌려준다 (max 를 넘지 않음).
+    uint64_t percentile(double q) const {
+      if (count == 0) return 0;
+      const auto rank = static_cast<uint64_t>(std::max(1.0, q * static_cast<double>(count) + 0.5));
+      uint64_t seen = 0;
+      for (std::size_t i = 0; i < kNumBuckets; ++i) {
+        seen += counts[i];
+        if (seen >= rank) return std::min(upperBound(i), max);
+      }
+      return max;
+    }
+
+    uint64_t mean() const { return count ? sum / count : 0; }
+  };
+
+  void record(uint64_t value) {
+    value = std::min(value, kMaxValue);
+    buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t prev = max_.load(std::memory_order_relaxed);
+    while (value > prev && !max_.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  // 누적값을 읽고 0 으로 되돌린다 (주기별 통계용). 동시에 record 된 값은 이번 또는 다음 주기에 들어간다.
+  void drain(Snapshot& out) {
+    for (std::size_t i = 0; i < kNumBuckets; ++i) {
+      out.counts[i] = buckets_[i].exchange(0, std::memory_order_relaxed);
+    }
+    out.count = count_.exchange(0, std::memory_order_relaxed);
+    out.sum = sum_.exchange(0, std::memory_order_relaxed);
+    out.max = max_.exchange(0, std::memory_order_relaxed);
+  }
+
+  static std::size_t bucketIndex(uint64_t value) {
+    if (value < kSubBuckets) return static_cast<std::size_t>(value);
+    const int msb = 63 - __builtin_clzll(value);
+    const int shift = msb - kSubBucketBits;
+    const uint64_t sub = (value >> shift) - kSubBuckets;
+    return static_cast<std::size_t>((shift + 1) * kSubBuckets + sub);
+  }
+
+  static uint64_t upperBound(std::size_t index) {
+    if (index < kSubBuckets) return index;
+    const int shift = static_cast<int>(index / kSubBuckets) - 1;
+    const uint64_t sub = index % kSubBuckets;
+    return ((kSubBuckets + sub + 1) << shift) - 1;
+  }
+
+private:
+  std::array<std::atomic<uint64_t>, kNumBuckets> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+}  // namespace app_common
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "common/utils/overflow_policy.hpp"
+
+namespace app_common {
+
+// 다중 생산자 / 단일 소비자 고정 크기 큐 (슬롯별 시퀀스 번호 방식).
+// 생산자는 tail 을, 소비자는 head 를 CAS 로 점유한다.
+// DropOldest 모드에서 생산자는 head 에서 하나를 버리고 다시 넣는다.
+template <typename T>
+class MpscQueue {
+public:
+  explicit MpscQueue(std::size_t capacity, OverflowPolicy policy = OverflowPolicy::DropOldest)
+      : capacity_(capacity), mask_(capacity - 1), policy_(policy) {
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+      throw std::invalid_argument("MpscQueue capacity must be a power of two >= 2");
+    }
+    slots_ = std::make_unique<Slot[]>(capacity);
+    for (std::size_t i = 0; i < capacity; ++i) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  // 생산자. 실패(버려짐) 시 value 는 그대로 남는다.
+  bool push(T&& value) { return push(std::move(value), policy_.load(std::memory_order_relaxed)); }
+
+  bool push(T&& value, OverflowPolicy policy) {
+    if (tryPush(value)) return true;
+
+    if (policy == OverflowPolicy::DropOldest) {
+      // 비운 자리를 다른 생산자가 먼저 차지할 수 있으므로 넣을 때까지 다시 버린다.
+      // 버린 메시지는 각각 한 번만 dropped_oldest_ 로 센다
+      T discarded;
+      for (std::size_t attempt = 0; attempt < capacity_; ++attempt) {
+        if (tryPop(discarded)) dropped_oldest_.fetch_add(1, std::memory_order_relaxed);
+        if (tryPush(value)) return true;
+      }
+    }
+
+    dropped_newest_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // 소비자
+  bool pop(T& out) { return tryPop(out); }
+
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) >= tail_.load(std::memory_order_acquire);
+  }
+
+  std::size_t capacity() const { return capacity_; }
+  uint64_t droppedOldest() const { return dropped_oldest_.load(std::memory_order_relaxed); }
+  uint64_t droppedNewest() const { return dropped_newest_.load(std::memory_order_relaxed); }
+  uint64_t dropped() const { return droppedOldest() + droppedNewest(); }
+
+private:
+  struct alignas(64) Slot {
+    std::atomic<std::size_t> seq{0};
+    T value{};
+  };
+
+  bool tryPush(T& value) {
+    std::size_t pos = tail_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+
+    while (true) {
+      slot = &slots_[pos & mask_];
+      const std::size_t seq = slot->seq.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->value = std::move(value);
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool tryPop(T& out) {
+    std::size_t pos = head_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+
+    while (true) {
+      slot = &slots_[pos & mask_];
+      const std::size_t seq = slot->seq.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+
+    out = std::move(slot->value);
+    slot->seq.store(pos + capacity_, std::memory_order_release);
+    return true;
+  }
+
+  const std::size_t capacity_;
+  const std::size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<OverflowPolicy> policy_;
+
+  alignas(64) std::atomic<std::size_t> head_{0};
+  alignas(64) std::atomic<std::size_t> tail_{0};
+
+  alignas(64) std::atomic<uint64_t> dropped_oldest_{0};
+  std::atomic<uint64_t> dropped_newest_{0};
+};
+
+}  // namespace app_common
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace app_common {
+
+// 고정 크기 큐가 가득 찼을 때 어떤 항목을 버릴지
+enum class OverflowPolicy { DropOldest, DropNewest };
+
+}  // namespace app_common
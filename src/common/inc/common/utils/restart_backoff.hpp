@@ -0,0 +1,36 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+namespace app_common {
+
+// 재시작 간격. 실패가 이어질 때마다 initial 에서 두 배씩 늘려 max 에서 멈춘다.
+// 마지막 재시작 뒤로 정상 동작했으면(healthy) 그 실패는 처음 실패로 보고 initial 부터 다시 센다.
+class RestartBackoff {
+public:
+  using Duration = std::chrono::milliseconds;
+
+  RestartBackoff(Duration initial, Duration max) : initial_(initial), max_(std::max(initial, max)) {}
+
+  // 실패 하나를 기록하고 다음 재시작까지 기다릴 시간을 돌려준다.
+  Duration next(bool healthy) {
+    if (healthy) failures_ = 0;
+    Duration delay = initial_;
+    for (uint32_t i = 0; i < failures_ && delay < max_; ++i) delay *= 2;
+    ++failures_;
+    return std::min(delay, max_);
+  }
+
+  void reset() { failures_ = 0; }
+  // 연속 실패 수
+  uint32_t failures() const { return failures_; }
+
+private:
+  Duration initial_;
+  Duration max_;
+  uint32_t failures_{0};
+};
+
+}  // namespace app_common
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace app_common {
+
+// 작업을 넣은 순서대로 하나씩 실행하는 전용 스레드.
+// 같은 대상에 대한 작업은 직렬화하고, 서로 다른 SerialWorker 끼리는 병렬로 진행된다.
+class SerialWorker {
+public:
+  using Task = std::function<void()>;
+
+  SerialWorker() : thread_([this] { run(); }) {}
+
+  // 남은 작업을 모두 실행한 뒤 종료한다.
+  ~SerialWorker() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+  }
+
+  SerialWorker(const SerialWorker&) = delete;
+  SerialWorker& operator=(const SerialWorker&) = delete;
+
+  void post(Task task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+  }
+
+private:
+  void run() {
+    while (true) {
+      Task task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty()) return;
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Task> tasks_;
+  bool stopping_{false};
+  std::thread thread_;
+};
+
+}  // namespace app_common
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <tbb/concurrent_queue.h>
+#include <tbb/flow_graph.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace app_common {
+
+// source 별로 같은 단계 체인(lane)을 하나씩 두는 TBB flow graph.
+// 단계마다 serial function_node 라서 같은 source 의 job 은 들어온 순서대로 모든 단계를 지나고,
+// 서로 다른 source 의 job, 같은 source 라도 서로 다른 단계에 있는 job 은 동시에 실행된다.
+// 따라서 단계 함수가 source 별 상태를 쓴다면 그 상태는 한 단계에서만 만져야 한다.
+//
+// job 은 생성 시 만든 풀에서 acquire() 로 꺼내고, 마지막 단계가 끝나면 풀로 돌아간다.
+// 풀이 비면 acquire() 가 nullptr 를 돌려주므로 호출자가 버리거나 기다리는 정책을 정한다.
+// TBB worker 가 없는 환경(단일 코어)에서는 wait() 를 부르는 스레드가 단계를 직접 실행하므로,
+// 넣는 쪽은 할 일이 없을 때 wait() 로 남은 job 을 처리해 주어야 한다.
+template <typename Job>
+class SourceLanes {
+public:
+  // false 를 반환하면 그 job 은 남은 단계를 건너뛰고 풀로 돌아간다
+  using Stage = std::function<bool(uint32_t source_id, Job& job)>;
+
+  SourceLanes(std::size_t num_sources, std::size_t pool_size, std::vector<Stage> stages,
+              std::function<void()> on_release = {})
+      : stages_(std::move(stages)), on_release_(std::move(on_release)) {
+    pool_.reserve(pool_size);
+    for (std::size_t i = 0; i < pool_size; ++i) {
+      pool_.push_back(std::make_unique<Job>());
+      free_.push(pool_.back().get());
+    }
+
+    release_node_ = std::make_unique<ReleaseNode>(graph_, tbb::flow::unlimited, [this](const Token& token) {
+      release(token.job);
+      return tbb::flow::continue_msg{};
+    });
+
+    lanes_.resize(num_sources);
+    for (std::size_t source = 0; source < num_sources; ++source) {
+      auto& lane = lanes_[source];
+      for (std::size_t i = 0; i < stages_.size(); ++i) {
+        const Stage& stage = stages_[i];
+        const auto source_id = static_cast<uint32_t>(source);
+        lane.push_back(std::make_unique<StageNode>(graph_, tbb::flow::serial, [&stage, source_id](Token token) {
+          if (token.active) token.active = stage(source_id, *token.job);
+          return token;
+        }));
+        if (i > 0) tbb::flow::make_edge(*lane[i - 1], *lane[i]);
+      }
+      if (!lane.empty()) tbb::flow::make_edge(*lane.back(), *release_node_);
+    }
+  }
+
+  ~SourceLanes() { wait(); }
+
+  SourceLanes(const SourceLanes&) = delete;
+  SourceLanes& operator=(const SourceLanes&) = delete;
+
+  Job* acquire() {
+    Job* job = nullptr;
+    return free_.try_pop(job) ? job : nullptr;
+  }
+
+  // 보내지 않은 job 을 돌려줄 때
+  void release(Job* job) {
+    free_.push(job);
+    if (on_release_) on_release_();
+  }
+
+  // source_id 가 범위를 벗어나면 job 을 풀로 돌려주고 false
+  bool submit(uint32_t source_id, Job* job) {
+    if (source_id >= lanes_.size() || lanes_[source_id].empty()) {
+      release(job);
+      return false;
+    }
+    lanes_[source_id].front()->try_put(Token{job, true});
+    return true;
+  }
+
+  // 넣은 job 이 모두 끝날 때까지 기다린다
+  void wait() { graph_.wait_for_all(); }
+
+  std::size_t numSources() const { return lanes_.size(); }
+  std::size_t poolSize() const { return pool_.size(); }
+
+private:
+  struct Token {
+    Job* job{nullptr};
+    bool active{true};
+  };
+  using StageNode = tbb::flow::function_node<Token, Token>;
+  using ReleaseNode = tbb::flow::function_node<Token, tbb::flow::continue_msg>;
+
+  std::vector<Stage> stages_;
+  std::function<void()> on_release_;
+  std::vector<std::unique_ptr<Job>> pool_;
+  tbb::concurrent_queue<Job*> free_;
+
+  // node 들은 graph 보다 먼저 소멸해야 한다
+  tbb::flow::graph graph_;
+  std::unique_ptr<ReleaseNode> release_node_;
+  std::vector<std::vector<std::unique_ptr<StageNode>>> lanes_;
+};
+
+}  // namespace app_common
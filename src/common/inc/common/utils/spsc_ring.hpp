@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include "common/utils/overflow_policy.hpp"
+
+namespace app_common {
+
+// 단일 생산자 / 단일 소비자 고정 크기 링 버퍼.
+// 슬롯은 생성 시 한 번만 할당되고, push/pop 은 슬롯 안에서 직접 쓰고 읽는다.
+// DropOldest 모드에서는 생산자가 가장 오래된 항목을 버리기 위해 head 를 함께 소비하므로
+// head 는 슬롯별 시퀀스 번호와 CAS 로 점유한다.
+template <typename T>
+class SpscRing {
+public:
+  explicit SpscRing(std::size_t capacity, OverflowPolicy policy = OverflowPolicy::DropOldest)
+      : capacity_(capacity), mask_(capacity - 1), policy_(policy) {
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+      throw std::invalid_argument("SpscRing capacity must be a power of two >= 2");
+    }
+    slots_ = std::make_unique<Slot[]>(capacity);
+    for (std::size_t i = 0; i < capacity; ++i) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  // 생산자 전용. fill(T&) 는 슬롯이 확보된 경우에만 호출된다.
+  template <typename Fill>
+  bool push(Fill&& fill) {
+    if (tryPush(fill)) return true;
+
+    if (policy_.load(std::memory_order_relaxed) == OverflowPolicy::DropOldest && tryPop([](const T&) {})) {
+      dropped_oldest_.fetch_add(1, std::memory_order_relaxed);
+      if (tryPush(fill)) return true;
+    }
+
+    dropped_newest_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // 소비자 전용. consume(const T&) 가 반환될 때까지 슬롯은 생산자에게 반환되지 않으므로
+  // consume 안에서는 필요한 값만 복사하고 바로 빠져나와야 한다.
+  template <typename Consume>
+  bool pop(Consume&& consume) {
+    return tryPop(consume);
+  }
+
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+  std::size_t capacity() const { return capacity_; }
+  OverflowPolicy policy() const { return policy_.load(std::memory_order_relaxed); }
+  void setPolicy(OverflowPolicy policy) { policy_.store(policy, std::memory_order_relaxed); }
+
+  uint64_t pushed() const { return pushed_.load(std::memory_order_relaxed); }
+  uint64_t droppedOldest() const { return dropped_oldest_.load(std::memory_order_relaxed); }
+  uint64_t droppedNewest() const { return dropped_newest_.load(std::memory_order_relaxed); }
+  uint64_t dropped() const { return droppedOldest() + droppedNewest(); }
+
+private:
+  struct alignas(64) Slot {
+    std::atomic<std::size_t> seq{0};
+    T value{};
+  };
+
+  template <typename Fill>
+  bool tryPush(Fill&& fill) {
+    const std::size_t pos = tail_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[pos & mask_];
+    if (slot.seq.load(std::memory_order_acquire) != pos) return false;
+
+    fill(slot.value);
+    slot.seq.store(pos + 1, std::memory_order_release);
+    tail_.store(pos + 1, std::memory_order_release);
+    pushed_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  template <typename Consume>
+  bool tryPop(Consume&& consume) {
+    std::size_t pos = head_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+
+    while (true) {
+      slot = &slots_[pos & mask_];
+      const std::size_t seq = slot->seq.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+
+    consume(static_cast<const T&>(slot->value));
+    slot->seq.store(pos + capacity_, std::memory_order_release);
+    return true;
+  }
+
+  const std::size_t capacity_;
+  const std::size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<OverflowPolicy> policy_;
+
+  alignas(64) std::atomic<std::size_t> head_{0};
+  alignas(64) std::atomic<std::size_t> tail_{0};
+
+  alignas(64) std::atomic<uint64_t> pushed_{0};
+  std::atomic<uint64_t> dropped_oldest_{0};
+  std::atomic<uint64_t> dropped_newest_{0};
+};
+
+}  // namespace app_common
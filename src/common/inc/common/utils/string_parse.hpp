@@ -0,0 +1,37 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace app_common {
+
+// 설정 문자열("0:0.5;2:0.7", "x:y:w:h" 등)의 숫자 하나. 앞뒤 공백이나 남는 문자가 있으면 실패한다.
+
+template <typename Int>
+bool parseInt(std::string_view text, Int& value) {
+  static_assert(std::is_integral_v<Int>, "parseInt needs an integer type");
+  const char* end = text.data() + text.size();
+  auto [ptr, ec] = std::from_chars(text.data(), end, value);
+  return ec == std::errc() && ptr == end;
+}
+
+// 유한한 값만 받는다
+inline bool parseFloat(std::string_view text, float& value) {
+  // float 용 from_chars 가 없는 툴체인(gcc < 11)도 있어 strtof 를 쓴다
+  const std::string copy(text);
+  char* end = nullptr;
+  value = std::strtof(copy.c_str(), &end);
+  return !copy.empty() && end == copy.c_str() + copy.size() && std::isfinite(value);
+}
+
+inline std::string_view trim(std::string_view text) {
+  while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+  while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+  return text;
+}
+
+}  // namespace app_common
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace app_common {
+
+enum class SimdLevel { Scalar, Sse2, Avx2, Neon };
+
+// 현재 CPU 에서 쓸 수 있는 가장 빠른 구현
+SimdLevel bestSimdLevel();
+bool simdLevelSupported(SimdLevel level);
+const char* simdLevelName(SimdLevel level);
+
+// 두 버퍼의 바이트별 절대차 합 (SAD). 지원하지 않는 level 이면 Scalar 로 계산한다.
+uint64_t sumAbsDiff(const uint8_t* a, const uint8_t* b, std::size_t size, SimdLevel level);
+uint64_t sumAbsDiff(const uint8_t* a, const uint8_t* b, std::size_t size);
+
+// luma plane 을 row_step 줄마다 하나씩 골라 참조 프레임과의 픽셀당 평균 절대차(0..255)를 구한다.
+// 참조는 골라낸 줄만 복사해 두므로 1080p, row_step=8 이면 약 260KB 이다.
+class FrameDiffScorer {
+public:
+  explicit FrameDiffScorer(int row_step = 8, SimdLevel level = bestSimdLevel());
+
+  // 참조가 없거나 크기가 바뀌었으면 음수를 돌려준다.
+  double score(const uint8_t* luma, int width, int height, int stride) const;
+  void setReference(const uint8_t* luma, int width, int height, int stride);
+  bool hasReference() const { return !reference_.empty(); }
+  void reset();
+
+private:
+  int row_step_;
+  SimdLevel level_;
+  int width_{0};
+  int height_{0};
+  std::vector<uint8_t> reference_;
+};
+
+}  // namespace app_common
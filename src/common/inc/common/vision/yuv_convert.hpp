@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/infer/roi.hpp"
+#include "common/vision/frame_diff.hpp"
+
+namespace app_common {
+
+enum class PixelFormat { Nv12, I420, Rgba };
+// limited range YUV 의 변환 행렬 (SD 는 BT.601, HD 는 보통 BT.709)
+enum class YuvMatrix { Bt601, Bt709 };
+
+// 영상 한 장. Nv12 는 plane 0(Y)/1(UV), I420 은 0/1/2, Rgba 는 0 만 쓴다.
+struct ImageView {
+  PixelFormat format{PixelFormat::Nv12};
+  int width{0};
+  int height{0};
+  uint8_t* data[3]{};
+  int stride[3]{};
+};
+
+// 한 줄 단위 커널. 지원하지 않는 level 이면 Scalar 로 계산하며, 모든 level 의 결과는 비트 단위로 같다.
+// u/v 는 가로 절반 해상도이고 픽셀 x 는 u[x / 2] 를 쓴다.
+void yuvToRgbaRow(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* rgba, int width, YuvMatrix matrix,
+                  SimdLevel level);
+// NV12 의 UV 를 U / V 로 나누거나 합친다. count 는 UV 쌍의 수.
+void splitUvRow(const uint8_t* uv, uint8_t* u, uint8_t* v, int count, SimdLevel level);
+void mergeUvRow(const uint8_t* u, const uint8_t* v, uint8_t* uv, int count, SimdLevel level);
+
+// NV12/I420 -> NV12/I420/RGBA 변환과 최근접 스케일을 한 번에 한다.
+// crop 은 src 좌표의 원본 영역으로, 시작점은 짝수로 내리고 프레임 안으로 자른다 (폭이나 높이가 0 이면 전체).
+// 스케일이 없는 줄은 복사 없이 SIMD 커널에 바로 넘기고, 스케일이 있으면 대응표로 줄을 모은 뒤 넘긴다.
+// 대응표와 줄 버퍼를 재사용하므로 한 인스턴스는 한 스레드에서만 써야 한다.
+class YuvConverter {
+public:
+  explicit YuvConverter(SimdLevel level = bestSimdLevel());
+
+  // 형식이나 크기가 맞지 않으면 false
+  bool convert(const ImageView& src, const ImageView& dst, RoiRect crop = {}, YuvMatrix matrix = YuvMatrix::Bt601);
+  SimdLevel level() const { return level_; }
+
+private:
+  struct Layout {
+    RoiRect crop;
+    int src_width{0};
+    int src_height{0};
+    int dst_width{0};
+    int dst_height{0};
+    bool operator==(const Layout& other) const {
+      return crop == other.crop && src_width == other.src_width && src_height == other.src_height &&
+             dst_width == other.dst_width && dst_height == other.dst_height;
+    }
+  };
+
+  void prepare(const Layout& layout);
+  const uint8_t* lumaRow(const ImageView& src, int dst_row);
+  void chromaRows(const ImageView& src, int dst_chroma_row, const uint8_t*& u, const uint8_t*& v);
+
+  SimdLevel level_;
+  Layout layout_;
+  bool scale_x_{false};
+  std::vector<int> x_map_, y_map_;    // 출력 luma 열/행 -> 원본 열/행
+  std::vector<int> cx_map_, cy_map_;  // 출력 chroma 열/행 -> 원본 chroma 열/행
+  std::vector<uint8_t> y_row_, u_row_, v_row_;
+};
+
+}  // namespace app_common
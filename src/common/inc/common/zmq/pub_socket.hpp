@@ -1,19 +1,141 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include <zmq.hpp>
 
+#include "common/utils/mpsc_queue.hpp"
+
+// 여러 스레드에서 publish 할 수 있는 XPUB 소켓.
+// publish 는 메시지를 큐에 넣기만 하고, zmq 소켓은 전용 송신 스레드 하나만 사용한다.
+// 송신 스레드는 구독/해지 메시지도 받아 토픽별 구독자 수를 관리하므로,
+// 생산자는 hasSubscribers() 로 아무도 받지 않는 토픽의 직렬화를 건너뛸 수 있다.
+//
+// 구독자는 "<topic>@<hz>" 를 추가로 구독해 해당 토픽의 전송률을 낮춰 달라고 요청할 수 있다
+// (예: "det" 와 "det@5"). 이 토픽으로는 아무것도 발행되지 않는다.
+//
+// High 메시지는 그보다 늦게 넣은 Normal 메시지보다 항상 먼저 나간다.
+//
+// 모든 메시지는 [topic][payload][seq] 3 프레임으로 전송된다. seq 는 토픽별로 1 부터 증가하는
+// uint64 (little-endian 8 bytes) 로, 구독자는 이 값으로 유실을 감지할 수 있다.
+// cache_last 토픽은 마지막 메시지를 보관해 두고 snapshot() 으로 돌려준다.
 class PubSocket {
 public:
-  PubSocket(zmq::context_t& ctx, const std::string_view endpoint);
+  enum class Priority { High, Normal };
+
+  struct TopicPolicy {
+    Priority priority{Priority::Normal};
+    app_common::OverflowPolicy overflow{app_common::OverflowPolicy::DropOldest};
+    bool cache_last{false};
+  };
+
+  struct CachedMessage {
+    std::string topic;
+    uint64_t seq{0};
+    std::string payload;
+  };
+
+  using TopicId = int;
+  static constexpr TopicId kUnregisteredTopic = -1;
+  static constexpr std::size_t kMaxTopics = 32;
+  static constexpr std::size_t kDefaultQueueCapacity = 256;
+
+  PubSocket(zmq::context_t& ctx, const std::string_view endpoint, std::size_t queue_capacity = kDefaultQueueCapacity);
+  ~PubSocket();
+
+  // 토픽 프레임을 미리 만들어 두고 id 를 돌려준다. 같은 이름이면 정책만 갱신한다.
+  // 등록은 한 스레드(초기화 시점의 main)에서만 해야 한다.
+  TopicId registerTopic(const std::string_view topic, TopicPolicy policy);
+  TopicId findTopic(const std::string_view topic) const;
+  // 등록된 토픽이면 그 id 를, 아니면 기본 정책으로 등록한 id 를 돌려준다.
+  TopicId ensureTopic(const std::string_view topic);
+
+  // 전송이 끝난 payload 버퍼를 비워서 돌려준다. 남은 버퍼가 없으면 빈 문자열.
+  // 여기에 직렬화해서 publish 하면 메시지마다 버퍼를 새로 할당하지 않는다.
+  std::string acquirePayload();
+
+  // 큐가 가득 차 DropNewest 정책으로 이 메시지를 버렸으면 false. seq 는 이미 쓰였으므로 구독자에게는 유실로 보인다.
+  // payload 를 복사해서 보낸다.
+  bool publish(const std::string_view topic, const std::string_view msg);
+  // payload 의 소유권을 넘겨받아 복사 없이 zmq 메시지로 보낸다.
+  bool publish(const std::string_view topic, std::string&& msg);
+  bool publish(TopicId topic, std::string&& msg);
+
+  uint64_t dropped(Priority priority) const;
 
-  void publish(const std::string_view topic, const std::string_view msg);
+  bool hasSubscribers(TopicId topic) const;
+  bool hasSubscribers(const std::string_view topic) const;
+  // 구독자들이 요청한 최대 전송률(Hz). 0 이면 제한 없음.
+  uint32_t requestedRate(TopicId topic) const;
+  // 해당 토픽에 새 구독이 생길 때마다 증가한다 (스냅샷 재전송 판단용).
+  uint64_t subscriptionVersion(TopicId topic) const;
+  // 구독자가 있거나 last-value 캐시 대상이라 발행할 의미가 있는 토픽인지.
+  bool wantsPublish(const std::string_view topic) const;
+
+  // cache_last 토픽 중 이름이 prefix 로 시작하는 토픽의 마지막 메시지들.
+  std::vector<CachedMessage> snapshot(const std::string_view prefix = {}) const;
 
   PubSocket(const PubSocket&) = delete;
   PubSocket& operator=(const PubSocket&) = delete;
-  PubSocket(PubSocket&&) noexcept = default;
-  PubSocket& operator=(PubSocket&&) noexcept = default;
+  PubSocket(PubSocket&&) = delete;
+  PubSocket& operator=(PubSocket&&) = delete;
 
 private:
+  struct Topic {
+    std::string name;
+    TopicPolicy policy;
+    zmq::message_t frame;
+    std::atomic<int> subscribers{0};
+    std::atomic<uint32_t> requested_rate{0};
+    std::atomic<uint64_t> subscription_version{0};
+    std::atomic<uint64_t> last_seq{0};
+  };
+
+  class PayloadPool;
+
+  struct OutgoingMessage {
+    TopicId topic_id{kUnregisteredTopic};
+    uint64_t seq{0};
+    std::string topic;  // 미등록 토픽일 때만 사용
+    std::string payload;
+  };
+
+  bool enqueue(OutgoingMessage&& message, const TopicPolicy& policy);
+  void cacheLastValue(const Topic& topic, uint64_t seq, const std::string& payload);
+  const TopicPolicy& policyFor(TopicId topic) const;
+  app_common::MpscQueue<OutgoingMessage>& queueFor(Priority priority);
+  void run();
+  void send(OutgoingMessage& message);
+  void receiveSubscriptions();
+  void updateSubscriberCounts();
+  bool isValid(TopicId topic) const;
+  void wakeSender();
+  void waitForMessages();
+
   zmq::socket_t socket_;
+  std::array<Topic, kMaxTopics> topics_;
+  std::atomic<std::size_t> num_topics_{0};
+  TopicPolicy default_policy_;
+  std::map<std::string, int> subscriptions_;  // 송신 스레드 전용: 구독 prefix -> 구독 수
+  // 토픽 표가 가득 차 등록하지 못한 토픽의 이름 -> 마지막 seq
+  std::mutex unregistered_mutex_;
+  std::map<std::string, uint64_t, std::less<>> unregistered_seq_;
+  std::shared_ptr<PayloadPool> payload_pool_;
+
+  mutable std::mutex cache_mutex_;
+  std::map<std::string, CachedMessage, std::less<>> last_values_;
+
+  app_common::MpscQueue<OutgoingMessage> high_queue_;
+  app_common::MpscQueue<OutgoingMessage> normal_queue_;
+
+  int wake_fd_{-1};
+  std::atomic<bool> sender_waiting_{false};
+  std::atomic<bool> running_{true};
+  std::thread sender_thread_;
 };
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+// REQ/DEALER 클라이언트 여럿을 받는 ROUTER 소켓.
+// 요청마다 라우팅 envelope 를 보관해 두었다가 같은 envelope 로 응답한다.
+// 소켓은 한 스레드에서만 사용해야 한다.
+class RouterSocket {
+public:
+  struct Request {
+    std::vector<zmq::message_t> envelope;  // identity (+ REQ 의 빈 delimiter)
+    std::string body;
+  };
+
+  RouterSocket(zmq::context_t& ctx, const std::string_view endpoint);
+
+  std::optional<Request> receive();
+  void send(Request& request, const std::string_view msg);
+  void* handle() { return static_cast<void*>(socket_); }
+
+  RouterSocket(const RouterSocket&) = delete;
+  RouterSocket& operator=(const RouterSocket&) = delete;
+
+private:
+  zmq::socket_t socket_;
+};
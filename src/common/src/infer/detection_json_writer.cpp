@@ -0,0 +1,161 @@
+#include "common/infer/detection_json_writer.hpp"
+
+#include <fmt/format.h>
+
+#include <cmath>
+
+namespace app_common {
+
+namespace {
+constexpr std::size_t kInitialCapacity = 4096;
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+void appendUint(std::string& out, uint64_t value) {
+  fmt::format_int formatted(value);
+  out.append(formatted.data(), formatted.size());
+}
+
+void appendInt(std::string& out, int32_t value) {
+  fmt::format_int formatted(value);
+  out.append(formatted.data(), formatted.size());
+}
+
+// nlohmann 과 동일하게 NaN/Inf 는 null 로 기록
+void appendFloat(std::string& out, float value) {
+  if (!std::isfinite(value)) {
+    out.append("null");
+    return;
+  }
+  char buf[32];
+  auto* end = fmt::format_to(buf, "{}", value);
+  out.append(buf, static_cast<std::size_t>(end - buf));
+}
+
+void appendString(std::string& out, const char* str) {
+  out.push_back('"');
+  for (const char* p = str; *p != '\0'; ++p) {
+    const auto c = static_cast<unsigned char>(*p);
+    switch (c) {
+      case '"':
+        out.append("\\\"");
+        break;
+      case '\\':
+        out.append("\\\\");
+        break;
+      case '\n':
+        out.append("\\n");
+        break;
+      case '\r':
+        out.append("\\r");
+        break;
+      case '\t':
+        out.append("\\t");
+        break;
+      default:
+        if (c < 0x20) {
+          const char escaped[] = {'\\', 'u', '0', '0', kHexDigits[c >> 4], kHexDigits[c & 0x0f]};
+          out.append(escaped, sizeof(escaped));
+        } else {
+          out.push_back(static_cast<char>(c));
+        }
+        break;
+    }
+  }
+  out.push_back('"');
+}
+
+void appendBox(std::string& out, const Detection& det) {
+  out.append("\"box\":{\"x\":");
+  appendFloat(out, det.x);
+  out.append(",\"y\":");
+  appendFloat(out, det.y);
+  out.append(",\"w\":");
+  appendFloat(out, det.w);
+  out.append(",\"h\":");
+  appendFloat(out, det.h);
+  out.push_back('}');
+}
+
+void appendObject(std::string& out, const Detection& det) {
+  out.append("{\"class_id\":");
+  appendInt(out, det.class_id);
+  if (det.track_id != 0) {
+    out.append(",\"track_id\":");
+    appendUint(out, det.track_id);
+  }
+  out.append(",\"label\":");
+  appendString(out, det.label);
+  out.append(",\"confidence\":");
+  appendFloat(out, det.confidence);
+  out.push_back(',');
+  appendBox(out, det);
+  out.push_back('}');
+}
+
+void appendFrameHeader(std::string& out, const DetectionFrame& frame) {
+  out.append("{\"frame_number\":");
+  appendUint(out, frame.frame_number);
+  out.append(",\"timestamp\":");
+  appendUint(out, frame.timestamp);
+  out.append(",\"source_id\":");
+  appendUint(out, frame.source_id);
+}
+}  // namespace
+
+void writeDetectionJson(const DetectionFrame& frame, std::string& out) {
+  out.clear();
+
+  appendFrameHeader(out, frame);
+  out.append(",\"objects\":[");
+
+  for (uint32_t i = 0; i < frame.num_objects; ++i) {
+    if (i > 0) out.push_back(',');
+    appendObject(out, frame.objects[i]);
+  }
+
+  out.append("]}");
+}
+
+void writeTrackDeltaJson(const DetectionFrame& frame, const TrackDelta& delta, bool sync, std::string& out) {
+  out.clear();
+
+  appendFrameHeader(out, frame);
+  if (sync) out.append(",\"sync\":true");
+
+  out.append(",\"born\":[");
+  for (std::size_t i = 0; i < delta.born.size(); ++i) {
+    if (i > 0) out.push_back(',');
+    appendObject(out, frame.objects[delta.born[i]]);
+  }
+
+  out.append("],\"moved\":[");
+  for (std::size_t i = 0; i < delta.moved.size(); ++i) {
+    const Detection& det = frame.objects[delta.moved[i]];
+    if (i > 0) out.push_back(',');
+    out.append("{\"track_id\":");
+    appendUint(out, det.track_id);
+    out.push_back(',');
+    appendBox(out, det);
+    out.push_back('}');
+  }
+
+  out.append("],\"died\":[");
+  for (std::size_t i = 0; i < delta.died.size(); ++i) {
+    if (i > 0) out.push_back(',');
+    appendUint(out, delta.died[i]);
+  }
+  out.append("]}");
+}
+
+std::string_view writeDetectionJson(const DetectionFrame& frame) {
+  thread_local std::string buffer = [] {
+    std::string s;
+    s.reserve(kInitialCapacity);
+    return s;
+  }();
+
+  writeDetectionJson(frame, buffer);
+  return buffer;
+}
+
+}  // namespace app_common
@@ -0,0 +1,65 @@
+#include "common/infer/detection_wire_encoder.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace app_common::wire {
+
+namespace {
+template <typename T>
+void appendPod(std::string& out, const T& value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+Header makeHeader(MessageKind kind, uint32_t count) {
+  Header header;
+  header.magic[0] = kMagic[0];
+  header.magic[1] = kMagic[1];
+  header.version = kVersion;
+  header.kind = static_cast<uint8_t>(kind);
+  header.count = count;
+  return header;
+}
+}  // namespace
+
+bool DetectionWireEncoder::encodeFrame(const DetectionFrame& frame, std::string& out) {
+  const uint32_t count = std::min<uint32_t>(frame.num_objects, kMaxDetectionsPerFrame);
+  out.resize(kFrameHeaderSize + count * sizeof(WireDetection));
+  char* dst = out.data();
+
+  const Header header = makeHeader(MessageKind::Frame, count);
+  std::memcpy(dst, &header, sizeof(header));
+
+  const FrameInfo info{frame.frame_number, frame.timestamp, frame.source_id, 0};
+  std::memcpy(dst + sizeof(Header), &info, sizeof(info));
+
+  bool labels_changed = false;
+  dst += kFrameHeaderSize;
+  for (uint32_t i = 0; i < count; ++i) {
+    const Detection& det = frame.objects[i];
+    labels_changed |= learnLabel(det);
+
+    const WireDetection wire{det.class_id, det.confidence, det.x, det.y, det.w, det.h};
+    std::memcpy(dst, &wire, sizeof(wire));
+    dst += sizeof(wire);
+  }
+  return labels_changed;
+}
+
+void DetectionWireEncoder::encodeLabels(std::string& out) const {
+  out.clear();
+  appendPod(out, makeHeader(MessageKind::Labels, static_cast<uint32_t>(labels_.size())));
+
+  for (const auto& [class_id, label] : labels_) {
+    appendPod(out, class_id);
+    out.push_back(static_cast<char>(static_cast<uint8_t>(label.size())));
+    out.append(label);
+  }
+}
+
+bool DetectionWireEncoder::learnLabel(const Detection& det) {
+  // 라벨 길이는 kMaxLabelLength 미만이므로 uint8 길이 필드에 들어간다
+  return labels_.try_emplace(det.class_id, det.label).second;
+}
+
+}  // namespace app_common::wire
@@ -0,0 +1,302 @@
+#include "common/infer/post_filter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "common/utils/string_parse.hpp"
+
+namespace app_common {
+
+namespace {
+constexpr float kRejectAll = std::numeric_limits<float>::infinity();
+
+bool validUnit(float value) { return value >= 0.0f && value <= 1.0f; }
+
+// 범위 밖의 class_id 는 임계값 표에 들어가지 못해 조용히 무시되므로 설정 단계에서 거절한다
+bool validClass(int32_t class_id, std::string& error) {
+  if (class_id >= 0 && class_id < kMaxFilterClasses) return true;
+  error = "class id " + std::to_string(class_id) + " is out of range [0, " + std::to_string(kMaxFilterClasses) + ")";
+  return false;
+}
+
+// ';' 로 나뉜 항목마다 fn(item) 을 부른다. 하나라도 false 면 멈춘다.
+template <typename Fn>
+bool forEachItem(std::string_view text, Fn&& fn) {
+  while (!text.empty()) {
+    const auto pos = text.find(';');
+    if (!fn(text.substr(0, pos))) return false;
+    text.remove_prefix(pos == std::string_view::npos ? text.size() : pos + 1);
+  }
+  return true;
+}
+
+struct BoxView {
+  const float* x1;
+  const float* y1;
+  const float* x2;
+  const float* y2;
+  const float* area;
+  const int32_t* class_id;
+};
+
+// 박스 i 와 같은 클래스이면서 IoU 가 iou 를 넘는 [begin, num) 의 박스를 지운다.
+void suppressScalar(std::size_t i, std::size_t begin, std::size_t num, const BoxView& b, float iou, int32_t* alive) {
+  const float ix1 = b.x1[i], iy1 = b.y1[i], ix2 = b.x2[i], iy2 = b.y2[i], iarea = b.area[i];
+  const int32_t iclass = b.class_id[i];
+  for (std::size_t j = begin; j < num; ++j) {
+    const float w = std::max(0.0f, std::min(ix2, b.x2[j]) - std::max(ix1, b.x1[j]));
+    const float h = std::max(0.0f, std::min(iy2, b.y2[j]) - std::max(iy1, b.y1[j]));
+    const float inter = w * h;
+    const float uni = iarea + b.area[j] - inter;
+    const int32_t overlap = (b.class_id[j] == iclass) & (inter > iou * uni);
+    alive[j] &= overlap ^ 1;
+  }
+}
+
+#if defined(__SSE2__)
+void suppressAfter(std::size_t i, std::size_t num, const BoxView& b, float iou, int32_t* alive) {
+  const __m128 ix1 = _mm_set1_ps(b.x1[i]), iy1 = _mm_set1_ps(b.y1[i]);
+  const __m128 ix2 = _mm_set1_ps(b.x2[i]), iy2 = _mm_set1_ps(b.y2[i]);
+  const __m128 iarea = _mm_set1_ps(b.area[i]), viou = _mm_set1_ps(iou), zero = _mm_setzero_ps();
+  const __m128i iclass = _mm_set1_epi32(b.class_id[i]);
+
+  std::size_t j = i + 1;
+  for (; j + 4 <= num; j += 4) {
+    const __m128 w = _mm_max_ps(zero, _mm_sub_ps(_mm_min_ps(ix2, _mm_loadu_ps(b.x2 + j)),
+                                                 _mm_max_ps(ix1, _mm_loadu_ps(b.x1 + j))));
+    const __m128 h = _mm_max_ps(zero, _mm_sub_ps(_mm_min_ps(iy2, _mm_loadu_ps(b.y2 + j)),
+                                                 _mm_max_ps(iy1, _mm_loadu_ps(b.y1 + j))));
+    const __m128 inter = _mm_mul_ps(w, h);
+    const __m128 uni = _mm_sub_ps(_mm_add_ps(iarea, _mm_loadu_ps(b.area + j)), inter);
+    const __m128i overlap = _mm_castps_si128(_mm_cmpgt_ps(inter, _mm_mul_ps(viou, uni)));
+    const __m128i same = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b.class_id + j)), iclass);
+    auto* dst = reinterpret_cast<__m128i*>(alive + j);
+    _mm_storeu_si128(dst, _mm_andnot_si128(_mm_and_si128(overlap, same), _mm_loadu_si128(dst)));
+  }
+  suppressScalar(i, j, num, b, iou, alive);
+}
+#elif defined(__ARM_NEON)
+void suppressAfter(std::size_t i, std::size_t num, const BoxView& b, float iou, int32_t* alive) {
+  const float32x4_t ix1 = vdupq_n_f32(b.x1[i]), iy1 = vdupq_n_f32(b.y1[i]);
+  const float32x4_t ix2 = vdupq_n_f32(b.x2[i]), iy2 = vdupq_n_f32(b.y2[i]);
+  const float32x4_t iarea = vdupq_n_f32(b.area[i]), viou = vdupq_n_f32(iou), zero = vdupq_n_f32(0.0f);
+  const int32x4_t iclass = vdupq_n_s32(b.class_id[i]);
+
+  std::size_t j = i + 1;
+  for (; j + 4 <= num; j += 4) {
+    const float32x4_t w =
+        vmaxq_f32(zero, vsubq_f32(vminq_f32(ix2, vld1q_f32(b.x2 + j)), vmaxq_f32(ix1, vld1q_f32(b.x1 + j))));
+    const float32x4_t h =
+        vmaxq_f32(zero, vsubq_f32(vminq_f32(iy2, vld1q_f32(b.y2 + j)), vmaxq_f32(iy1, vld1q_f32(b.y1 + j))));
+    const float32x4_t inter = vmulq_f32(w, h);
+    const float32x4_t uni = vsubq_f32(vaddq_f32(iarea, vld1q_f32(b.area + j)), inter);
+    const uint32x4_t suppress =
+        vandq_u32(vcgtq_f32(inter, vmulq_f32(viou, uni)), vceqq_s32(vld1q_s32(b.class_id + j), iclass));
+    vst1q_s32(alive + j, vbicq_s32(vld1q_s32(alive + j), vreinterpretq_s32_u32(suppress)));
+  }
+  suppressScalar(i, j, num, b, iou, alive);
+}
+#else
+void suppressAfter(std::size_t i, std::size_t num, const BoxView& b, float iou, int32_t* alive) {
+  suppressScalar(i, i + 1, num, b, iou, alive);
+}
+#endif
+}  // namespace
+
+bool parseClassThresholds(std::string_view text, std::vector<std::pair<int32_t, float>>& thresholds,
+                          std::string& error) {
+  thresholds.clear();
+  return forEachItem(text, [&](std::string_view item) {
+    const auto pos = item.find(':');
+    int32_t class_id = 0;
+    float confidence = 0.0f;
+    if (pos == std::string_view::npos || !parseInt(item.substr(0, pos), class_id) ||
+        !parseFloat(item.substr(pos + 1), confidence)) {
+      error = "invalid class threshold '" + std::string(item) + "' (expected class:confidence)";
+      return false;
+    }
+    if (!validClass(class_id, error)) return false;
+    if (!validUnit(confidence)) {
+      error = "confidence for class " + std::to_string(class_id) + " must be in [0, 1]";
+      return false;
+    }
+    thresholds.emplace_back(class_id, confidence);
+    return true;
+  });
+}
+
+std::string formatClassThresholds(const std::vector<std::pair<int32_t, float>>& thresholds) {
+  std::string text;
+  for (const auto& [class_id, confidence] : thresholds) {
+    if (!text.empty()) text += ';';
+    char value[32];
+    std::snprintf(value, sizeof(value), "%g", confidence);
+    text += std::to_string(class_id) + ":" + value;
+  }
+  return text;
+}
+
+bool parseClassList(std::string_view text, std::vector<int32_t>& classes, std::string& error) {
+  classes.clear();
+  return forEachItem(text, [&](std::string_view item) {
+    int32_t class_id = 0;
+    if (!parseInt(item, class_id)) {
+      error = "invalid class id '" + std::string(item) + "'";
+      return false;
+    }
+    if (!validClass(class_id, error)) return false;
+    classes.push_back(class_id);
+    return true;
+  });
+}
+
+std::string formatClassList(const std::vector<int32_t>& classes) {
+  std::string text;
+  for (int32_t class_id : classes) {
+    if (!text.empty()) text += ';';
+    text += std::to_string(class_id);
+  }
+  return text;
+}
+
+bool validatePostFilter(const PostFilterConfig& config, std::string& error) {
+  if (!validUnit(config.min_confidence)) {
+    error = "min_confidence must be in [0, 1]";
+    return false;
+  }
+  if (!(config.min_area >= 0.0f)) {
+    error = "min_area must not be negative";
+    return false;
+  }
+  if (!validUnit(config.nms_iou)) {
+    error = "nms_iou must be in [0, 1]";
+    return false;
+  }
+  for (const auto& [class_id, confidence] : config.class_confidence) {
+    if (!validClass(class_id, error)) return false;
+    if (!validUnit(confidence)) {
+      error = "confidence for class " + std::to_string(class_id) + " must be in [0, 1]";
+      return false;
+    }
+  }
+  for (int32_t class_id : config.allowed_classes) {
+    if (!validClass(class_id, error)) return false;
+  }
+  return true;
+}
+
+PostFilter::PostFilter(const PostFilterConfig& config) : config_(config) {
+  // 범위 밖 class_id 는 허용 목록이 없을 때만 기본 임계값으로 통과할 수 있다
+  const bool allow_list = !config_.allowed_classes.empty();
+  default_threshold_ = allow_list ? kRejectAll : config_.min_confidence;
+
+  class_threshold_.assign(kMaxFilterClasses, default_threshold_);
+  for (int32_t class_id : config_.allowed_classes) {
+    if (class_id >= 0 && class_id < kMaxFilterClasses) class_threshold_[class_id] = config_.min_confidence;
+  }
+  // 허용 목록 밖의 클래스에 임계값을 줘도 허용되지는 않는다
+  for (const auto& [class_id, confidence] : config_.class_confidence) {
+    if (class_id < 0 || class_id >= kMaxFilterClasses) continue;
+    if (!allow_list || class_threshold_[class_id] != kRejectAll) class_threshold_[class_id] = confidence;
+  }
+
+  pass_through_ = !allow_list && config_.class_confidence.empty() && config_.min_confidence <= 0.0f &&
+                  config_.min_area <= 0.0f && config_.nms_iou <= 0.0f;
+}
+
+void PostFilter::Boxes::resize(std::size_t count) {
+  x1.resize(count);
+  y1.resize(count);
+  x2.resize(count);
+  y2.resize(count);
+  area.resize(count);
+  class_id.resize(count);
+}
+
+void PostFilter::load(const DetectionFrame& frame, std::size_t count) {
+  boxes_.resize(count);
+  confidence_.resize(count);
+  threshold_.resize(count);
+  keep_.resize(count);
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const Detection& det = frame.objects[i];
+    boxes_.x1[i] = det.x;
+    boxes_.y1[i] = det.y;
+    boxes_.x2[i] = det.x + det.w;
+    boxes_.y2[i] = det.y + det.h;
+    boxes_.area[i] = det.w * det.h;
+    boxes_.class_id[i] = det.class_id;
+    confidence_[i] = det.confidence;
+    threshold_[i] = static_cast<uint32_t>(det.class_id) < static_cast<uint32_t>(kMaxFilterClasses)
+                        ? class_threshold_[det.class_id]
+                        : default_threshold_;
+  }
+}
+
+// 임계값을 통과한 박스를 confidence 내림차순으로 sorted_ 에 모은 뒤, 앞의 살아 있는 박스마다
+// 뒤쪽의 같은 클래스 박스와의 IoU 를 4 개씩(SSE2/NEON) 계산해 겹치는 것을 지운다.
+// IoU > t 는 나눗셈 없이 inter > t * union 으로 비교한다.
+// 지워진 박스는 다른 박스를 지우지 않는다.
+void PostFilter::suppressOverlaps(std::size_t count) {
+  order_.clear();
+  for (uint32_t i = 0; i < count; ++i) {
+    if (keep_[i]) order_.push_back(i);
+  }
+  std::stable_sort(order_.begin(), order_.end(),
+                   [this](uint32_t a, uint32_t b) { return confidence_[a] > confidence_[b]; });
+
+  const std::size_t num = order_.size();
+  sorted_.resize(num);
+  for (std::size_t r = 0; r < num; ++r) {
+    const uint32_t i = order_[r];
+    sorted_.x1[r] = boxes_.x1[i];
+    sorted_.y1[r] = boxes_.y1[i];
+    sorted_.x2[r] = boxes_.x2[i];
+    sorted_.y2[r] = boxes_.y2[i];
+    sorted_.area[r] = boxes_.area[i];
+    sorted_.class_id[r] = boxes_.class_id[i];
+  }
+  alive_.assign(num, 1);
+
+  const BoxView view{sorted_.x1.data(),   sorted_.y1.data(),   sorted_.x2.data(),
+                     sorted_.y2.data(),   sorted_.area.data(), sorted_.class_id.data()};
+  for (std::size_t i = 0; i < num; ++i) {
+    if (alive_[i]) suppressAfter(i, num, view, config_.nms_iou, alive_.data());
+  }
+
+  for (std::size_t r = 0; r < num; ++r) keep_[order_[r]] = static_cast<uint8_t>(alive_[r]);
+}
+
+uint32_t PostFilter::apply(DetectionFrame& frame) {
+  if (pass_through_) return 0;
+  const std::size_t count = std::min<std::size_t>(frame.num_objects, kMaxDetectionsPerFrame);
+  if (count == 0) return 0;
+
+  load(frame, count);
+  const float min_area = config_.min_area;
+  for (std::size_t i = 0; i < count; ++i) {
+    keep_[i] = static_cast<uint8_t>((confidence_[i] >= threshold_[i]) & (boxes_.area[i] >= min_area));
+  }
+  if (config_.nms_iou > 0.0f) suppressOverlaps(count);
+
+  uint32_t kept = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (!keep_[i]) continue;
+    if (kept != i) frame.objects[kept] = frame.objects[i];
+    ++kept;
+  }
+  const uint32_t removed = static_cast<uint32_t>(count) - kept;
+  frame.num_objects = kept;
+  return removed;
+}
+
+}  // namespace app_common
@@ -0,0 +1,118 @@
+#include "common/infer/roi.hpp"
+
+#include <algorithm>
+
+#include "common/utils/string_parse.hpp"
+
+namespace app_common {
+
+namespace {
+bool parseRoi(std::string_view text, RoiRect& roi) {
+  int values[4];
+  for (int i = 0; i < 4; ++i) {
+    const auto pos = text.find(':');
+    if ((pos == std::string_view::npos) != (i == 3)) return false;
+    if (!parseInt(text.substr(0, pos), values[i])) return false;
+    if (pos != std::string_view::npos) text.remove_prefix(pos + 1);
+  }
+  roi = {values[0], values[1], values[2], values[3]};
+  return true;
+}
+}  // namespace
+
+bool parseRois(std::string_view text, std::vector<RoiRect>& rois, std::string& error) {
+  rois.clear();
+  while (!text.empty()) {
+    const auto pos = text.find(';');
+    const auto item = text.substr(0, pos);
+    RoiRect roi;
+    if (!parseRoi(item, roi)) {
+      error = "invalid roi '" + std::string(item) + "' (expected x:y:w:h)";
+      return false;
+    }
+    rois.push_back(roi);
+    text.remove_prefix(pos == std::string_view::npos ? text.size() : pos + 1);
+  }
+  return true;
+}
+
+std::string formatRoi(const RoiRect& roi) {
+  return std::to_string(roi.x) + ":" + std::to_string(roi.y) + ":" + std::to_string(roi.width) + ":" +
+         std::to_string(roi.height);
+}
+
+std::string formatRois(const std::vector<RoiRect>& rois) {
+  std::string text;
+  for (const auto& roi : rois) {
+    if (!text.empty()) text += ';';
+    text += formatRoi(roi);
+  }
+  return text;
+}
+
+bool normalizeRoi(RoiRect& roi, int frame_width, int frame_height) {
+  int left = std::clamp(roi.x, 0, frame_width) & ~1;
+  int top = std::clamp(roi.y, 0, frame_height) & ~1;
+  int right = std::clamp(roi.x + roi.width, 0, frame_width) & ~1;
+  int bottom = std::clamp(roi.y + roi.height, 0, frame_height) & ~1;
+  if (right - left < kMinRoiSize || bottom - top < kMinRoiSize) return false;
+
+  roi = {left, top, right - left, bottom - top};
+  return true;
+}
+
+uint32_t mergeRoiDetections(DetectionFrame& frame, uint32_t first_roi_object, float min_overlap) {
+  auto overlap = [](const Detection& a, const Detection& b) {
+    const float w = std::min(a.x + a.w, b.x + b.w) - std::max(a.x, b.x);
+    const float h = std::min(a.y + a.h, b.y + b.h) - std::max(a.y, b.y);
+    const float smaller = std::min(a.w * a.h, b.w * b.h);
+    return (w > 0.0f && h > 0.0f && smaller > 0.0f) ? w * h / smaller : 0.0f;
+  };
+
+  uint32_t kept = std::min<uint32_t>(first_roi_object, frame.num_objects);
+  for (uint32_t j = kept; j < frame.num_objects; ++j) {
+    const Detection& det = frame.objects[j];
+    bool merged = false;
+    for (uint32_t i = 0; i < kept && !merged; ++i) {
+      Detection& prev = frame.objects[i];
+      if (prev.class_id != det.class_id || overlap(prev, det) < min_overlap) continue;
+      if (det.confidence > prev.confidence) prev = det;
+      merged = true;
+    }
+    if (!merged) frame.objects[kept++] = det;
+  }
+  const uint32_t removed = frame.num_objects - kept;
+  frame.num_objects = kept;
+  return removed;
+}
+
+void groupBatchFrames(const BatchFrame* frames, std::size_t count, const std::vector<RoiTransform>& by_pad,
+                      int* group) {
+  auto known = [&](std::size_t i) { return frames[i].pad_index < by_pad.size(); };
+  for (std::size_t i = 0; i < count; ++i) {
+    group[i] = known(i) ? kBatchRepresentative : kBatchDropped;
+    if (!known(i)) continue;
+    const uint32_t source_id = by_pad[frames[i].pad_index].source_id;
+    for (std::size_t j = 0; j < i; ++j) {
+      if (group[j] != kBatchRepresentative || frames[j].pts != frames[i].pts) continue;
+      if (by_pad[frames[j].pad_index].source_id == source_id) {
+        group[i] = static_cast<int>(j);
+        break;
+      }
+    }
+  }
+}
+
+RoiTransform roiTransform(const RoiRect& roi, int frame_width, int frame_height, int mux_width, int mux_height,
+                          uint32_t source_id) {
+  // mux 좌표 m -> 원본 픽셀 roi.x + m * roi.w / mux_w -> 전체 프레임 mux 좌표 * mux_w / frame_w
+  RoiTransform transform;
+  transform.source_id = source_id;
+  transform.offset_x = static_cast<float>(roi.x) * mux_width / frame_width;
+  transform.offset_y = static_cast<float>(roi.y) * mux_height / frame_height;
+  transform.scale_x = static_cast<float>(roi.width) / frame_width;
+  transform.scale_y = static_cast<float>(roi.height) / frame_height;
+  return transform;
+}
+
+}  // namespace app_common
@@ -0,0 +1,141 @@
+#include "common/infer/synthetic_detections.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "common/utils/string_parse.hpp"
+
+namespace app_common {
+
+namespace {
+constexpr std::size_t kScriptFields = 6;
+
+void setLabel(Detection& det) { std::snprintf(det.label, kMaxLabelLength, "class%d", det.class_id); }
+
+bool parseObject(std::string_view item, Detection& det) {
+  std::string_view fields[kScriptFields];
+  for (std::size_t i = 0; i < kScriptFields; ++i) {
+    const auto pos = item.find(':');
+    if ((pos == std::string_view::npos) != (i == kScriptFields - 1)) return false;
+    fields[i] = item.substr(0, pos);
+    item.remove_prefix(pos == std::string_view::npos ? item.size() : pos + 1);
+  }
+  if (!parseInt(fields[0], det.class_id) || !parseFloat(fields[1], det.confidence) || !parseFloat(fields[2], det.x) ||
+      !parseFloat(fields[3], det.y) || !parseFloat(fields[4], det.w) || !parseFloat(fields[5], det.h)) {
+    return false;
+  }
+  setLabel(det);
+  det.track_id = 0;
+  return det.w >= 0.0f && det.h >= 0.0f;
+}
+}  // namespace
+
+bool parseSyntheticScript(std::string_view text, std::vector<std::vector<Detection>>& frames, std::string& error) {
+  std::vector<std::vector<Detection>> parsed;
+  std::size_t line_number = 0;
+  while (!text.empty()) {
+    const auto eol = text.find('\n');
+    const std::string_view line = trim(text.substr(0, eol));
+    text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+    ++line_number;
+    if (!line.empty() && line.front() == '#') continue;
+
+    auto& objects = parsed.emplace_back();
+    std::string_view rest = line;
+    while (!rest.empty()) {
+      const auto pos = rest.find(';');
+      const std::string_view item = trim(rest.substr(0, pos));
+      rest.remove_prefix(pos == std::string_view::npos ? rest.size() : pos + 1);
+      if (objects.size() == kMaxDetectionsPerFrame) {
+        error = "line " + std::to_string(line_number) + ": too many objects";
+        return false;
+      }
+      Detection det{};
+      if (!parseObject(item, det)) {
+        error = "line " + std::to_string(line_number) + ": invalid object '" + std::string(item) + "'";
+        return false;
+      }
+      objects.push_back(det);
+    }
+  }
+  if (parsed.empty()) {
+    error = "script has no frames";
+    return false;
+  }
+  frames = std::move(parsed);
+  return true;
+}
+
+SyntheticDetector::SyntheticDetector(const SyntheticConfig& config) : config_(config) {
+  config_.objects_per_frame =
+      std::min<uint32_t>(config_.objects_per_frame, static_cast<uint32_t>(kMaxDetectionsPerFrame));
+  config_.num_classes = std::max<uint32_t>(config_.num_classes, 1);
+  config_.frame_width = std::max(config_.frame_width, 1.0f);
+  config_.frame_height = std::max(config_.frame_height, 1.0f);
+  reset();
+}
+
+void SyntheticDetector::reset() {
+  state_ = config_.seed;
+  frames_ = 0;
+  movers_.assign(config_.script.empty() ? config_.objects_per_frame : 0, Mover{});
+  for (auto& mover : movers_) spawn(mover);
+}
+
+// splitmix64. std 분포는 표준 라이브러리마다 결과가 달라 직접 변환한다.
+uint64_t SyntheticDetector::nextRandom() {
+  uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+float SyntheticDetector::uniform(float lo, float hi) {
+  const float unit = static_cast<float>(nextRandom() >> 40) * (1.0f / 16777216.0f);
+  return lo + (hi - lo) * unit;
+}
+
+void SyntheticDetector::spawn(Mover& mover) {
+  auto& det = mover.det;
+  det.class_id = static_cast<int32_t>(nextRandom() % config_.num_classes);
+  det.w = uniform(0.03f, 0.15f) * config_.frame_width;
+  det.h = uniform(0.05f, 0.25f) * config_.frame_height;
+  det.x = uniform(0.0f, config_.frame_width - det.w);
+  det.y = uniform(0.0f, config_.frame_height - det.h);
+  det.track_id = 0;
+  setLabel(det);
+  mover.vx = uniform(-8.0f, 8.0f);
+  mover.vy = uniform(-4.0f, 4.0f);
+}
+
+void SyntheticDetector::next(DetectionFrame& frame) {
+  if (!config_.script.empty()) {
+    const auto& objects = config_.script[frames_ % config_.script.size()];
+    frame.num_objects = static_cast<uint32_t>(objects.size());
+    std::copy(objects.begin(), objects.end(), frame.objects);
+    ++frames_;
+    return;
+  }
+
+  for (auto& mover : movers_) {
+    auto& det = mover.det;
+    det.x += mover.vx;
+    det.y += mover.vy;
+    if (det.x < 0.0f || det.x + det.w > config_.frame_width) {
+      mover.vx = -mover.vx;
+      det.x = std::clamp(det.x, 0.0f, config_.frame_width - det.w);
+    }
+    if (det.y < 0.0f || det.y + det.h > config_.frame_height) {
+      mover.vy = -mover.vy;
+      det.y = std::clamp(det.y, 0.0f, config_.frame_height - det.h);
+    }
+    det.confidence = uniform(0.3f, 1.0f);
+  }
+
+  frame.num_objects = static_cast<uint32_t>(movers_.size());
+  for (std::size_t i = 0; i < movers_.size(); ++i) frame.objects[i] = movers_[i].det;
+  ++frames_;
+}
+
+}  // namespace app_common
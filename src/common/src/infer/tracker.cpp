@@ -0,0 +1,239 @@
+#include "common/infer/tracker.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace app_common {
+
+namespace {
+// DeepSORT 와 같은 박스 높이 비례 잡음 (위치 1/20, 속도 1/160)
+constexpr float kStdWeightPosition = 1.0f / 20.0f;
+constexpr float kStdWeightVelocity = 1.0f / 160.0f;
+constexpr float kMinBoxSize = 1.0f;
+
+enum Dim { kCx = 0, kCy = 1, kW = 2, kH = 3 };
+
+float square(float v) { return v * v; }
+
+void measurement(const Detection& det, float (&z)[4]) {
+  z[kCx] = det.x + det.w * 0.5f;
+  z[kCy] = det.y + det.h * 0.5f;
+  z[kW] = det.w;
+  z[kH] = det.h;
+}
+}  // namespace
+
+Tracker::Tracker(const TrackerConfig& config) : config_(config) {}
+
+void Tracker::reset() {
+  while (!ids_.empty()) remove(ids_.size() - 1);
+}
+
+void Tracker::predict() {
+  const std::size_t n = ids_.size();
+  const float* h = mean_[kH].data();
+  for (int d = 0; d < kDims; ++d) {
+    float* mean = mean_[d].data();
+    const float* vel = velocity_[d].data();
+    float* p00 = var_pos_[d].data();
+    float* p01 = cov_pos_vel_[d].data();
+    float* p11 = var_vel_[d].data();
+    for (std::size_t t = 0; t < n; ++t) {
+      const float q_pos = square(kStdWeightPosition * h[t]);
+      const float q_vel = square(kStdWeightVelocity * h[t]);
+      mean[t] += vel[t];
+      p00[t] += 2.0f * p01[t] + p11[t] + q_pos;
+      p01[t] += p11[t];
+      p11[t] += q_vel;
+    }
+  }
+  for (int d : {kW, kH}) {
+    for (auto& v : mean_[d]) v = std::max(v, kMinBoxSize);
+  }
+}
+
+std::size_t Tracker::spawn(const Detection& det) {
+  float z[kDims];
+  measurement(det, z);
+  const float h = std::max(z[kH], kMinBoxSize);
+
+  ids_.push_back(next_id_++);
+  class_ids_.push_back(det.class_id);
+  hits_.push_back(1);
+  misses_.push_back(0);
+  confirmed_.push_back(0);
+  for (int d = 0; d < kDims; ++d) {
+    mean_[d].push_back(z[d]);
+    velocity_[d].push_back(0.0f);
+    var_pos_[d].push_back(square(2.0f * kStdWeightPosition * h));
+    cov_pos_vel_[d].push_back(0.0f);
+    var_vel_[d].push_back(square(10.0f * kStdWeightVelocity * h));
+    published_[d].push_back(0.0f);
+  }
+  published_confidence_.push_back(0.0f);
+  labels_.emplace_back();
+  std::memcpy(labels_.back().data(), det.label, kMaxLabelLength);
+  return ids_.size() - 1;
+}
+
+void Tracker::correct(std::size_t track, const Detection& det) {
+  float z[kDims];
+  measurement(det, z);
+  const float r = square(kStdWeightPosition * mean_[kH][track]);
+
+  for (int d = 0; d < kDims; ++d) {
+    float& p00 = var_pos_[d][track];
+    float& p01 = cov_pos_vel_[d][track];
+    float& p11 = var_vel_[d][track];
+    const float s = p00 + r;
+    const float k0 = p00 / s;
+    const float k1 = p01 / s;
+    const float innovation = z[d] - mean_[d][track];
+
+    mean_[d][track] += k0 * innovation;
+    velocity_[d][track] += k1 * innovation;
+    p11 -= k1 * p01;
+    p00 *= 1.0f - k0;
+    p01 *= 1.0f - k0;
+  }
+  std::memcpy(labels_[track].data(), det.label, kMaxLabelLength);
+}
+
+void Tracker::remove(std::size_t track) {
+  const std::size_t last = ids_.size() - 1;
+  auto erase = [track, last](auto& values) {
+    if (track != last) values[track] = std::move(values[last]);
+    values.pop_back();
+  };
+
+  erase(ids_);
+  erase(class_ids_);
+  erase(hits_);
+  erase(misses_);
+  erase(confirmed_);
+  for (int d = 0; d < kDims; ++d) {
+    erase(mean_[d]);
+    erase(velocity_[d]);
+    erase(var_pos_[d]);
+    erase(cov_pos_vel_[d]);
+    erase(var_vel_[d]);
+    erase(published_[d]);
+  }
+  erase(published_confidence_);
+  erase(labels_);
+}
+
+void Tracker::publishBox(std::size_t track, const Detection& det) {
+  published_[0][track] = det.x;
+  published_[1][track] = det.y;
+  published_[2][track] = det.w;
+  published_[3][track] = det.h;
+  published_confidence_[track] = det.confidence;
+}
+
+bool Tracker::movedSincePublished(std::size_t track, const Detection& det) const {
+  const float w = std::max(published_[2][track], kMinBoxSize);
+  const float h = std::max(published_[3][track], kMinBoxSize);
+  const float limit = config_.delta_threshold;
+  return std::abs(det.x - published_[0][track]) > limit * w || std::abs(det.y - published_[1][track]) > limit * h ||
+         std::abs(det.w - published_[2][track]) > limit * w || std::abs(det.h - published_[3][track]) > limit * h;
+}
+
+void Tracker::update(DetectionFrame& frame, TrackDelta* delta) {
+  if (delta) delta->clear();
+  predict();
+
+  const std::size_t num_tracks = ids_.size();
+  const uint32_t num_dets = frame.num_objects;
+
+  // 예측 박스와 검출의 IoU. track 축 배열을 순서대로 읽는다.
+  candidates_.clear();
+  const float* cx = mean_[kCx].data();
+  const float* cy = mean_[kCy].data();
+  const float* w = mean_[kW].data();
+  const float* h = mean_[kH].data();
+  for (uint32_t i = 0; i < num_dets; ++i) {
+    const Detection& det = frame.objects[i];
+    const float det_area = det.w * det.h;
+    for (std::size_t t = 0; t < num_tracks; ++t) {
+      if (class_ids_[t] != det.class_id) continue;
+      const float left = std::max(cx[t] - w[t] * 0.5f, det.x);
+      const float top = std::max(cy[t] - h[t] * 0.5f, det.y);
+      const float right = std::min(cx[t] + w[t] * 0.5f, det.x + det.w);
+      const float bottom = std::min(cy[t] + h[t] * 0.5f, det.y + det.h);
+      const float inter = std::max(0.0f, right - left) * std::max(0.0f, bottom - top);
+      const float uni = w[t] * h[t] + det_area - inter;
+      const float iou = uni > 0.0f ? inter / uni : 0.0f;
+      if (iou >= config_.iou_threshold) candidates_.push_back({iou, static_cast<uint32_t>(t), i});
+    }
+  }
+
+  std::sort(candidates_.begin(), candidates_.end(),
+            [](const Candidate& a, const Candidate& b) { return a.iou > b.iou; });
+  det_track_.assign(num_dets, -1);
+  track_matched_.assign(num_tracks, 0);
+  for (const auto& candidate : candidates_) {
+    if (track_matched_[candidate.track] || det_track_[candidate.det] >= 0) continue;
+    track_matched_[candidate.track] = 1;
+    det_track_[candidate.det] = static_cast<int32_t>(candidate.track);
+  }
+
+  for (std::size_t t = 0; t < num_tracks; ++t) {
+    if (track_matched_[t]) {
+      ++hits_[t];
+      misses_[t] = 0;
+    } else {
+      ++misses_[t];
+    }
+  }
+
+  for (uint32_t i = 0; i < num_dets; ++i) {
+    Detection& det = frame.objects[i];
+    std::size_t track;
+    if (det_track_[i] >= 0) {
+      track = static_cast<std::size_t>(det_track_[i]);
+      correct(track, det);
+    } else {
+      track = spawn(det);
+    }
+    det.track_id = ids_[track];
+
+    if (!confirmed_[track]) {
+      if (hits_[track] >= config_.min_hits) {
+        confirmed_[track] = 1;
+        publishBox(track, det);
+        if (delta) delta->born.push_back(i);
+      }
+    } else if (movedSincePublished(track, det)) {
+      publishBox(track, det);
+      if (delta) delta->moved.push_back(i);
+    }
+  }
+
+  // 확정 전 track 은 한 번만 놓쳐도 지운다. id 는 이미 채웠으므로 지우면서 자리가 바뀌어도 상관없다.
+  for (std::size_t t = num_tracks; t-- > 0;) {
+    const bool expired = confirmed_[t] ? misses_[t] > config_.max_age : misses_[t] > 0;
+    if (!expired) continue;
+    if (confirmed_[t] && delta) delta->died.push_back(ids_[t]);
+    remove(t);
+  }
+}
+
+void Tracker::snapshot(DetectionFrame& frame) const {
+  frame.num_objects = 0;
+  for (std::size_t t = 0; t < ids_.size() && frame.num_objects < kMaxDetectionsPerFrame; ++t) {
+    if (!confirmed_[t]) continue;
+    Detection& det = frame.objects[frame.num_objects++];
+    det.class_id = class_ids_[t];
+    det.confidence = published_confidence_[t];
+    det.x = published_[0][t];
+    det.y = published_[1][t];
+    det.w = published_[2][t];
+    det.h = published_[3][t];
+    std::memcpy(det.label, labels_[t].data(), kMaxLabelLength);
+    det.track_id = ids_[t];
+  }
+}
+
+}  // namespace app_common
@@ -0,0 +1,247 @@
+#include "common/pipeline/pipeline_spec.hpp"
+
+#include <algorithm>
+#include <set>
+
+#include "common/pipeline/spec_value.hpp"
+#include "common/utils/json.hpp"
+
+namespace app_common {
+
+namespace {
+// 속성 순서를 지키기 위해 ordered_json 을 쓴다
+using OrderedJson = nlohmann::ordered_json;
+
+// '.' 은 실행 중 설정의 "<요소>.<속성>" 구분자라 이름에 쓸 수 없다
+bool validName(std::string_view name) {
+  return !name.empty() && std::all_of(name.begin(), name.end(), [](char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+  });
+}
+
+bool readString(const OrderedJson& object, const char* key, bool required, std::string& out, const std::string& where,
+                std::string& error) {
+  const auto it = object.find(key);
+  if (it == object.end()) return !required || failAt(error, where, std::string("missing \"") + key + "\"");
+  if (!it->is_string()) return failAt(error, where + "." + key, "must be a string");
+  out = it->get<std::string>();
+  return true;
+}
+
+bool parseElement(const OrderedJson& item, const std::string& where, ElementSpec& element, std::string& error) {
+  if (!item.is_object()) return failAt(error, where, "must be an object");
+  if (!readString(item, "name", true, element.name, where, error) ||
+      !readString(item, "factory", true, element.factory, where, error)) {
+    return false;
+  }
+
+  const auto props = item.find("properties");
+  if (props == item.end()) return true;
+  if (!props->is_object()) return failAt(error, where + ".properties", "must be an object");
+  for (const auto& [key, value] : props->items()) {
+    std::string text;
+    if (!propertyValueString(value, text)) {
+      return failAt(error, where + ".properties." + key, "must be a string, number or bool");
+    }
+    element.properties.emplace_back(key, std::move(text));
+  }
+  return true;
+}
+
+bool parseLink(const OrderedJson& item, const std::string& where, std::vector<LinkSpec>& links, std::string& error) {
+  if (!item.is_object()) return failAt(error, where, "must be an object");
+
+  const auto chain = item.find("chain");
+  if (chain != item.end()) {
+    if (!chain->is_array() || chain->size() < 2) return failAt(error, where + ".chain", "needs at least two elements");
+    for (std::size_t i = 0; i < chain->size(); ++i) {
+      if (!(*chain)[i].is_string()) return failAt(error, where + ".chain", "must list element names");
+    }
+    for (std::size_t i = 0; i + 1 < chain->size(); ++i) {
+      LinkSpec link;
+      link.src = (*chain)[i].get<std::string>();
+      link.sink = (*chain)[i + 1].get<std::string>();
+      links.push_back(std::move(link));
+    }
+    return true;
+  }
+
+  LinkSpec link;
+  if (!readString(item, "from", true, link.src, where, error) ||
+      !readString(item, "from_pad", false, link.src_pad, where, error) ||
+      !readString(item, "to", true, link.sink, where, error) ||
+      !readString(item, "to_pad", false, link.sink_pad, where, error) ||
+      !readString(item, "caps", false, link.caps, where, error)) {
+    return false;
+  }
+  const auto dynamic = item.find("dynamic");
+  if (dynamic != item.end()) {
+    if (!dynamic->is_boolean()) return failAt(error, where + ".dynamic", "must be a bool");
+    link.dynamic = dynamic->get<bool>();
+  }
+  links.push_back(std::move(link));
+  return true;
+}
+
+}  // namespace
+
+std::string describe(const LinkSpec& link) {
+  std::string text = link.src;
+  if (!link.src_pad.empty()) text += "." + link.src_pad;
+  text += " -> " + link.sink;
+  if (!link.sink_pad.empty()) text += "." + link.sink_pad;
+  return text;
+}
+
+const ElementSpec* PipelineSpec::find(std::string_view element_name) const {
+  const auto it = std::find_if(elements.begin(), elements.end(),
+                               [&](const ElementSpec& element) { return element.name == element_name; });
+  return it == elements.end() ? nullptr : &*it;
+}
+
+ElementSpec* PipelineSpec::find(std::string_view element_name) {
+  return const_cast<ElementSpec*>(static_cast<const PipelineSpec*>(this)->find(element_name));
+}
+
+bool PipelineSpec::setProperty(std::string_view element_name, const std::string& key, std::string value) {
+  ElementSpec* element = find(element_name);
+  if (!element) return false;
+  for (auto& [name, current] : element->properties) {
+    if (name == key) {
+      current = std::move(value);
+      return true;
+    }
+  }
+  element->properties.emplace_back(key, std::move(value));
+  return true;
+}
+
+bool parsePipelineSpec(std::string_view text, PipelineSpec& spec, std::string& error) {
+  const auto root = OrderedJson::parse(text, nullptr, false);
+  if (root.is_discarded()) return failAt(error, "pipeline", "invalid JSON");
+  if (!root.is_object()) return failAt(error, "pipeline", "must be an object");
+
+  PipelineSpec parsed;
+  const auto version = root.find("version");
+  if (version == root.end() || !version->is_number_integer()) {
+    return failAt(error, "version", "missing or not an integer");
+  }
+  parsed.version = version->get<int>();
+  if (!readString(root, "name", false, parsed.name, "pipeline", error)) return false;
+
+  const auto elements = root.find("elements");
+  if (elements == root.end() || !elements->is_array()) return failAt(error, "elements", "missing or not an array");
+  for (std::size_t i = 0; i < elements->size(); ++i) {
+    ElementSpec element;
+    if (!parseElement((*elements)[i], "elements[" + std::to_string(i) + "]", element, error)) return false;
+    parsed.elements.push_back(std::move(element));
+  }
+
+  const auto links = root.find("links");
+  if (links != root.end()) {
+    if (!links->is_array()) return failAt(error, "links", "must be an array");
+    for (std::size_t i = 0; i < links->size(); ++i) {
+      if (!parseLink((*links)[i], "links[" + std::to_string(i) + "]", parsed.links, error)) return false;
+    }
+  }
+
+  if (!validatePipelineSpec(parsed, error)) return false;
+  spec = std::move(parsed);
+  return true;
+}
+
+bool validatePipelineSpec(const PipelineSpec& spec, std::string& error) {
+  if (spec.version != kPipelineSpecVersion) {
+    return failAt(error, "version",
+                std::to_string(spec.version) + " is not supported (expected " + std::to_string(kPipelineSpecVersion) +
+                    ")");
+  }
+  if (spec.elements.empty()) return failAt(error, "elements", "pipeline has no elements");
+
+  std::set<std::string_view> names;
+  for (std::size_t i = 0; i < spec.elements.size(); ++i) {
+    const auto& element = spec.elements[i];
+    const std::string where = "elements[" + std::to_string(i) + "]";
+    if (!validName(element.name)) return failAt(error, where + ".name", "'" + element.name + "' is not a valid name");
+    if (element.factory.empty()) return failAt(error, where + ".factory", "is empty");
+    if (!names.insert(element.name).second) return failAt(error, where + ".name", "duplicate '" + element.name + "'");
+
+    std::set<std::string_view> keys;
+    for (const auto& [key, value] : element.properties) {
+      if (key.empty() || key == "name") return failAt(error, where + ".properties", "invalid property '" + key + "'");
+      if (!keys.insert(key).second) return failAt(error, where + ".properties", "duplicate property '" + key + "'");
+    }
+  }
+
+  for (std::size_t i = 0; i < spec.links.size(); ++i) {
+    const auto& link = spec.links[i];
+    const std::string where = "links[" + std::to_string(i) + "] (" + describe(link) + ")";
+    if (!names.count(link.src)) return failAt(error, where, "unknown element '" + link.src + "'");
+    if (!names.count(link.sink)) return failAt(error, where, "unknown element '" + link.sink + "'");
+    if (link.src == link.sink) return failAt(error, where, "element is linked to itself");
+    if (!link.caps.empty() && !link.dynamic) {
+      return failAt(error, where, "caps filter is only allowed on dynamic links");
+    }
+    if (link.dynamic && !link.src_pad.empty()) return failAt(error, where, "dynamic links take the pad from pad-added");
+  }
+  return true;
+}
+
+std::string pipelineSpecToJson(const PipelineSpec& spec, int indent) {
+  OrderedJson root;
+  root["version"] = spec.version;
+  if (!spec.name.empty()) root["name"] = spec.name;
+
+  root["elements"] = OrderedJson::array();
+  for (const auto& element : spec.elements) {
+    OrderedJson item;
+    item["name"] = element.name;
+    item["factory"] = element.factory;
+    if (!element.properties.empty()) {
+      OrderedJson props = OrderedJson::object();
+      for (const auto& [key, value] : element.properties) props[key] = value;
+      item["properties"] = std::move(props);
+    }
+    root["elements"].push_back(std::move(item));
+  }
+
+  root["links"] = OrderedJson::array();
+  for (const auto& link : spec.links) {
+    OrderedJson item;
+    item["from"] = link.src;
+    if (!link.src_pad.empty()) item["from_pad"] = link.src_pad;
+    item["to"] = link.sink;
+    if (!link.sink_pad.empty()) item["to_pad"] = link.sink_pad;
+    if (link.dynamic) item["dynamic"] = true;
+    if (!link.caps.empty()) item["caps"] = link.caps;
+    root["links"].push_back(std::move(item));
+  }
+  return root.dump(indent);
+}
+
+bool expandPipelineSpec(PipelineSpec& spec, const std::map<std::string, std::string>& vars, std::string& error) {
+  for (auto& element : spec.elements) {
+    for (auto& [key, value] : element.properties) {
+      std::string expanded;
+      std::size_t pos = 0;
+      while (true) {
+        const auto start = value.find("${", pos);
+        if (start == std::string::npos) break;
+        const auto end = value.find('}', start);
+        if (end == std::string::npos) break;
+        const std::string var = value.substr(start + 2, end - start - 2);
+        const auto it = vars.find(var);
+        if (it == vars.end()) {
+          return failAt(error, element.name + "." + key, "undefined variable '${" + var + "}'");
+        }
+        expanded.append(value, pos, start - pos).append(it->second);
+        pos = end + 1;
+      }
+      if (pos == 0) continue;
+      value = expanded.append(value, pos, std::string::npos);
+    }
+  }
+  return true;
+}
+
+}  // namespace app_common
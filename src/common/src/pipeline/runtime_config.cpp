@@ -0,0 +1,65 @@
+#include "common/pipeline/runtime_config.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include "common/pipeline/spec_value.hpp"
+#include "common/utils/json.hpp"
+#include "common/utils/logging.hpp"
+
+namespace app_common {
+
+namespace {
+using OrderedJson = nlohmann::ordered_json;
+
+bool validLevel(const std::string& level) {
+  return level == "off" || spdlog::level::from_str(level) != spdlog::level::off;
+}
+}  // namespace
+
+bool parseRuntimeConfig(std::string_view text, std::vector<RuntimeSetting>& settings, std::string& error) {
+  const auto root = OrderedJson::parse(text, nullptr, false);
+  if (root.is_discarded()) return failAt(error, "config", "invalid JSON");
+  if (!root.is_object()) return failAt(error, "config", "must be an object");
+
+  std::vector<RuntimeSetting> parsed;
+  for (const auto& [target, entries] : root.items()) {
+    if (target.empty()) return failAt(error, "config", "empty element name");
+    if (!entries.is_object()) return failAt(error, target, "must be an object");
+    for (const auto& [key, value] : entries.items()) {
+      RuntimeSetting setting{target, key, {}};
+      if (key.empty()) return failAt(error, target, "empty property name");
+      if (!propertyValueString(value, setting.value)) {
+        return failAt(error, setting.path(), "must be a string, number or bool");
+      }
+      if (target == kLogTarget && !validLevel(setting.value)) {
+        return failAt(error, setting.path(), "unknown log level '" + setting.value + "'");
+      }
+      parsed.push_back(std::move(setting));
+    }
+  }
+  settings = std::move(parsed);
+  return true;
+}
+
+bool parseRuntimeSetting(std::string_view path, std::string value, RuntimeSetting& setting, std::string& error) {
+  const auto dot = path.find('.');
+  if (dot == std::string_view::npos || dot == 0 || dot + 1 == path.size()) {
+    return failAt(error, std::string(path), "expected <element>.<property> or log.<logger>");
+  }
+  RuntimeSetting parsed{std::string(path.substr(0, dot)), std::string(path.substr(dot + 1)), std::move(value)};
+  if (parsed.target == kLogTarget && !validLevel(parsed.value)) {
+    return failAt(error, parsed.path(), "unknown log level '" + parsed.value + "'");
+  }
+  setting = std::move(parsed);
+  return true;
+}
+
+bool setLogLevel(const std::string& logger, const std::string& level, std::string& error) {
+  if (!validLevel(level)) return failAt(error, "log." + logger, "unknown log level '" + level + "'");
+  auto target = getLogger(logger);
+  if (!target) return failAt(error, "log." + logger, "no such logger");
+  target->set_level(spdlog::level::from_str(level));
+  return true;
+}
+
+}  // namespace app_common
@@ -0,0 +1,23 @@
+#include "common/pipeline/spec_value.hpp"
+
+namespace app_common {
+
+bool propertyValueString(const nlohmann::ordered_json& value, std::string& out) {
+  if (value.is_string()) {
+    out = value.get<std::string>();
+  } else if (value.is_boolean()) {
+    out = value.get<bool>() ? "true" : "false";
+  } else if (value.is_number()) {
+    out = value.dump();
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool failAt(std::string& error, const std::string& where, const std::string& what) {
+  error = where + ": " + what;
+  return false;
+}
+
+}  // namespace app_common
@@ -0,0 +1,171 @@
+#include "common/vision/frame_diff.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define APP_COMMON_X86 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__aarch64__)
+#include <arm_neon.h>
+#define APP_COMMON_NEON 1
+#endif
+
+namespace app_common {
+namespace {
+
+uint64_t sadScalar(const uint8_t* a, const uint8_t* b, std::size_t size) {
+  uint64_t sum = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    sum += static_cast<uint64_t>(std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])));
+  }
+  return sum;
+}
+
+#ifdef APP_COMMON_X86
+__attribute__((target("sse2"))) uint64_t sadSse2(const uint8_t* a, const uint8_t* b, std::size_t size) {
+  __m128i acc = _mm_setzero_si128();
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    acc = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+  }
+  const uint64_t lo = static_cast<uint64_t>(_mm_cvtsi128_si64(acc));
+  const uint64_t hi = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(acc, acc)));
+  return lo + hi + sadScalar(a + i, b + i, size - i);
+}
+
+__attribute__((target("avx2"))) uint64_t sadAvx2(const uint8_t* a, const uint8_t* b, std::size_t size) {
+  __m256i acc = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(va, vb));
+  }
+  alignas(32) uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sadScalar(a + i, b + i, size - i);
+}
+#endif
+
+#ifdef APP_COMMON_NEON
+uint64_t sadNeon(const uint8_t* a, const uint8_t* b, std::size_t size) {
+  uint64x2_t acc = vdupq_n_u64(0);
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const uint8x16_t diff = vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+    // u8 -> u16 -> u32 -> u64 로 쌍끼리 더해 넘침 없이 누적
+    acc = vpadalq_u32(acc, vpaddlq_u16(vpaddlq_u8(diff)));
+  }
+  return vgetq_lane_u64(acc, 0) + vgetq_lane_u64(acc, 1) + sadScalar(a + i, b + i, size - i);
+}
+#endif
+
+}  // namespace
+
+bool simdLevelSupported(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::Scalar:
+      return true;
+#ifdef APP_COMMON_X86
+    case SimdLevel::Sse2:
+      return __builtin_cpu_supports("sse2");
+    case SimdLevel::Avx2:
+      return __builtin_cpu_supports("avx2");
+#endif
+#ifdef APP_COMMON_NEON
+    case SimdLevel::Neon:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+SimdLevel bestSimdLevel() {
+  static const SimdLevel level = [] {
+    for (SimdLevel candidate : {SimdLevel::Avx2, SimdLevel::Neon, SimdLevel::Sse2}) {
+      if (simdLevelSupported(candidate)) return candidate;
+    }
+    return SimdLevel::Scalar;
+  }();
+  return level;
+}
+
+const char* simdLevelName(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::Scalar:
+      return "scalar";
+    case SimdLevel::Sse2:
+      return "sse2";
+    case SimdLevel::Avx2:
+      return "avx2";
+    case SimdLevel::Neon:
+      return "neon";
+  }
+  return "unknown";
+}
+
+uint64_t sumAbsDiff(const uint8_t* a, const uint8_t* b, std::size_t size, SimdLevel level) {
+  if (!simdLevelSupported(level)) level = SimdLevel::Scalar;
+  switch (level) {
+#ifdef APP_COMMON_X86
+    case SimdLevel::Sse2:
+      return sadSse2(a, b, size);
+    case SimdLevel::Avx2:
+      return sadAvx2(a, b, size);
+#endif
+#ifdef APP_COMMON_NEON
+    case SimdLevel::Neon:
+      return sadNeon(a, b, size);
+#endif
+    default:
+      return sadScalar(a, b, size);
+  }
+}
+
+uint64_t sumAbsDiff(const uint8_t* a, const uint8_t* b, std::size_t size) {
+  return sumAbsDiff(a, b, size, bestSimdLevel());
+}
+
+FrameDiffScorer::FrameDiffScorer(int row_step, SimdLevel level) : row_step_(std::max(1, row_step)), level_(level) {}
+
+double FrameDiffScorer::score(const uint8_t* luma, int width, int height, int stride) const {
+  if (reference_.empty() || width != width_ || height != height_) return -1.0;
+
+  uint64_t sum = 0;
+  std::size_t samples = 0;
+  const uint8_t* ref = reference_.data();
+  for (int y = 0; y < height; y += row_step_) {
+    sum += sumAbsDiff(luma + static_cast<std::size_t>(y) * stride, ref, static_cast<std::size_t>(width), level_);
+    ref += width;
+    samples += static_cast<std::size_t>(width);
+  }
+  return samples ? static_cast<double>(sum) / static_cast<double>(samples) : 0.0;
+}
+
+void FrameDiffScorer::setReference(const uint8_t* luma, int width, int height, int stride) {
+  width_ = width;
+  height_ = height;
+  const std::size_t rows = static_cast<std::size_t>((height + row_step_ - 1) / row_step_);
+  reference_.resize(rows * static_cast<std::size_t>(width));
+
+  uint8_t* ref = reference_.data();
+  for (int y = 0; y < height; y += row_step_) {
+    std::memcpy(ref, luma + static_cast<std::size_t>(y) * stride, static_cast<std::size_t>(width));
+    ref += width;
+  }
+}
+
+void FrameDiffScorer::reset() {
+  reference_.clear();
+  width_ = 0;
+  height_ = 0;
+}
+
+}  // namespace app_common
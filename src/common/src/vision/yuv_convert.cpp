@@ -0,0 +1,455 @@
+#include "common/vision/yuv_convert.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define APP_COMMON_X86 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__aarch64__)
+#include <arm_neon.h>
+#define APP_COMMON_NEON 1
+#endif
+
+namespace app_common {
+namespace {
+
+// 6 비트 고정소수점 계수 (x64). limited range: Y 16..235, UV 16..240.
+struct Coefficients {
+  int16_t yg, rv, gu, gv, bu;
+};
+constexpr Coefficients kBt601{75, 102, 25, 52, 129};
+constexpr Coefficients kBt709{75, 115, 14, 34, 135};
+
+const Coefficients& coefficientsFor(YuvMatrix matrix) { return matrix == YuvMatrix::Bt709 ? kBt709 : kBt601; }
+
+// SIMD 의 포화 덧셈(int16)을 그대로 흉내 내야 모든 level 의 결과가 같다
+inline int sat16(int value) { return std::clamp(value, -32768, 32767); }
+inline uint8_t clampByte(int value) { return static_cast<uint8_t>(std::clamp(value, 0, 255)); }
+
+void yuvToRgbaScalar(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* rgba, int begin, int end,
+                     const Coefficients& k) {
+  for (int x = begin; x < end; ++x) {
+    const int yv = (y[x] - 16) * k.yg;
+    const int cu = u[x / 2] - 128;
+    const int cv = v[x / 2] - 128;
+    uint8_t* px = rgba + 4 * x;
+    px[0] = clampByte(sat16(sat16(yv + cv * k.rv) + 32) >> 6);
+    px[1] = clampByte(sat16(sat16(sat16(yv - cu * k.gu) - cv * k.gv) + 32) >> 6);
+    px[2] = clampByte(sat16(sat16(yv + cu * k.bu) + 32) >> 6);
+    px[3] = 255;
+  }
+}
+
+void splitUvScalar(const uint8_t* uv, uint8_t* u, uint8_t* v, int begin, int end) {
+  for (int i = begin; i < end; ++i) {
+    u[i] = uv[2 * i];
+    v[i] = uv[2 * i + 1];
+  }
+}
+
+void mergeUvScalar(const uint8_t* u, const uint8_t* v, uint8_t* uv, int begin, int end) {
+  for (int i = begin; i < end; ++i) {
+    uv[2 * i] = u[i];
+    uv[2 * i + 1] = v[i];
+  }
+}
+
+#ifdef APP_COMMON_X86
+__attribute__((target("sse2"))) void yuvToRgbaSse2(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                                                   uint8_t* rgba, int width, const Coefficients& k) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i k16 = _mm_set1_epi16(16), k128 = _mm_set1_epi16(128), round = _mm_set1_epi16(32);
+  const __m128i yg = _mm_set1_epi16(k.yg), rv = _mm_set1_epi16(k.rv), gu = _mm_set1_epi16(k.gu);
+  const __m128i gv = _mm_set1_epi16(k.gv), bu = _mm_set1_epi16(k.bu);
+  const __m128i alpha = _mm_set1_epi8(-1);
+
+  int x = 0;
+  for (; x + 16 <= width; x += 16) {
+    const __m128i y8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x));
+    __m128i u8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + x / 2));
+    __m128i v8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(v + x / 2));
+    u8 = _mm_unpacklo_epi8(u8, u8);  // 두 픽셀이 chroma 하나를 나눠 쓴다
+    v8 = _mm_unpacklo_epi8(v8, v8);
+
+    __m128i r[2], g[2], b[2];
+    for (int half = 0; half < 2; ++half) {
+      const __m128i y16 = half ? _mm_unpackhi_epi8(y8, zero) : _mm_unpacklo_epi8(y8, zero);
+      const __m128i u16 = _mm_sub_epi16(half ? _mm_unpackhi_epi8(u8, zero) : _mm_unpacklo_epi8(u8, zero), k128);
+      const __m128i v16 = _mm_sub_epi16(half ? _mm_unpackhi_epi8(v8, zero) : _mm_unpacklo_epi8(v8, zero), k128);
+      const __m128i yv = _mm_mullo_epi16(_mm_sub_epi16(y16, k16), yg);
+      r[half] = _mm_srai_epi16(_mm_adds_epi16(_mm_adds_epi16(yv, _mm_mullo_epi16(v16, rv)), round), 6);
+      g[half] = _mm_srai_epi16(
+          _mm_adds_epi16(_mm_subs_epi16(_mm_subs_epi16(yv, _mm_mullo_epi16(u16, gu)), _mm_mullo_epi16(v16, gv)),
+                         round),
+          6);
+      b[half] = _mm_srai_epi16(_mm_adds_epi16(_mm_adds_epi16(yv, _mm_mullo_epi16(u16, bu)), round), 6);
+    }
+    const __m128i r8 = _mm_packus_epi16(r[0], r[1]);
+    const __m128i g8 = _mm_packus_epi16(g[0], g[1]);
+    const __m128i b8 = _mm_packus_epi16(b[0], b[1]);
+
+    const __m128i rg_lo = _mm_unpacklo_epi8(r8, g8), rg_hi = _mm_unpackhi_epi8(r8, g8);
+    const __m128i ba_lo = _mm_unpacklo_epi8(b8, alpha), ba_hi = _mm_unpackhi_epi8(b8, alpha);
+    auto* out = reinterpret_cast<__m128i*>(rgba + 4 * x);
+    _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(rg_lo, ba_lo));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(rg_lo, ba_lo));
+    _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(rg_hi, ba_hi));
+    _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(rg_hi, ba_hi));
+  }
+  yuvToRgbaScalar(y, u, v, rgba, x, width, k);
+}
+
+__attribute__((target("avx2"))) void yuvToRgbaAvx2(const uint8_t* y, const uint8_t* u, const uint8_t* v,
+                                                   uint8_t* rgba, int width, const Coefficients& k) {
+  const __m256i k16 = _mm256_set1_epi16(16), k128 = _mm256_set1_epi16(128), round = _mm256_set1_epi16(32);
+  const __m256i yg = _mm256_set1_epi16(k.yg), rv = _mm256_set1_epi16(k.rv), gu = _mm256_set1_epi16(k.gu);
+  const __m256i gv = _mm256_set1_epi16(k.gv), bu = _mm256_set1_epi16(k.bu);
+  const __m256i alpha = _mm256_set1_epi8(-1);
+
+  int x = 0;
+  for (; x + 32 <= width; x += 32) {
+    const __m128i y_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x));
+    const __m128i y_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x + 16));
+    const __m128i u8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(u + x / 2));
+    const __m128i v8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(v + x / 2));
+
+    __m256i r[2], g[2], b[2];
+    for (int half = 0; half < 2; ++half) {
+      const __m256i y16 = _mm256_cvtepu8_epi16(half ? y_hi : y_lo);
+      const __m128i u_dup = half ? _mm_unpackhi_epi8(u8, u8) : _mm_unpacklo_epi8(u8, u8);
+      const __m128i v_dup = half ? _mm_unpackhi_epi8(v8, v8) : _mm_unpacklo_epi8(v8, v8);
+      const __m256i u16 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(u_dup), k128);
+      const __m256i v16 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(v_dup), k128);
+      const __m256i yv = _mm256_mullo_epi16(_mm256_sub_epi16(y16, k16), yg);
+      r[half] = _mm256_srai_epi16(_mm256_adds_epi16(_mm256_adds_epi16(yv, _mm256_mullo_epi16(v16, rv)), round), 6);
+      g[half] = _mm256_srai_epi16(
+          _mm256_adds_epi16(
+              _mm256_subs_epi16(_mm256_subs_epi16(yv, _mm256_mullo_epi16(u16, gu)), _mm256_mullo_epi16(v16, gv)),
+              round),
+          6);
+      b[half] = _mm256_srai_epi16(_mm256_adds_epi16(_mm256_adds_epi16(yv, _mm256_mullo_epi16(u16, bu)), round), 6);
+    }
+    // packus 는 128 비트 lane 단위로 섞이므로 64 비트 블록 순서를 되돌린다
+    const __m256i r8 = _mm256_permute4x64_epi64(_mm256_packus_epi16(r[0], r[1]), 0xD8);
+    const __m256i g8 = _mm256_permute4x64_epi64(_mm256_packus_epi16(g[0], g[1]), 0xD8);
+    const __m256i b8 = _mm256_permute4x64_epi64(_mm256_packus_epi16(b[0], b[1]), 0xD8);
+
+    const __m256i rg_lo = _mm256_unpacklo_epi8(r8, g8), rg_hi = _mm256_unpackhi_epi8(r8, g8);
+    const __m256i ba_lo = _mm256_unpacklo_epi8(b8, alpha), ba_hi = _mm256_unpackhi_epi8(b8, alpha);
+    const __m256i q0 = _mm256_unpacklo_epi16(rg_lo, ba_lo);  // 픽셀 0-3 | 16-19
+    const __m256i q1 = _mm256_unpackhi_epi16(rg_lo, ba_lo);  // 4-7 | 20-23
+    const __m256i q2 = _mm256_unpacklo_epi16(rg_hi, ba_hi);  // 8-11 | 24-27
+    const __m256i q3 = _mm256_unpackhi_epi16(rg_hi, ba_hi);  // 12-15 | 28-31
+    auto* out = reinterpret_cast<__m256i*>(rgba + 4 * x);
+    _mm256_storeu_si256(out + 0, _mm256_permute2x128_si256(q0, q1, 0x20));
+    _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(q2, q3, 0x20));
+    _mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(q0, q1, 0x31));
+    _mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(q2, q3, 0x31));
+  }
+  yuvToRgbaScalar(y, u, v, rgba, x, width, k);
+}
+
+__attribute__((target("sse2"))) void splitUvSse2(const uint8_t* uv, uint8_t* u, uint8_t* v, int count) {
+  const __m128i mask = _mm_set1_epi16(0x00FF);
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uv + 2 * i));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uv + 2 * i + 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(u + i),
+                     _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(v + i), _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+  }
+  splitUvScalar(uv, u, v, i, count);
+}
+
+__attribute__((target("avx2"))) void splitUvAvx2(const uint8_t* uv, uint8_t* u, uint8_t* v, int count) {
+  const __m256i mask = _mm256_set1_epi16(0x00FF);
+  int i = 0;
+  for (; i + 32 <= count; i += 32) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(uv + 2 * i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(uv + 2 * i + 32));
+    const __m256i us = _mm256_packus_epi16(_mm256_and_si256(a, mask), _mm256_and_si256(b, mask));
+    const __m256i vs = _mm256_packus_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(u + i), _mm256_permute4x64_epi64(us, 0xD8));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(v + i), _mm256_permute4x64_epi64(vs, 0xD8));
+  }
+  splitUvScalar(uv, u, v, i, count);
+}
+
+__attribute__((target("sse2"))) void mergeUvSse2(const uint8_t* u, const uint8_t* v, uint8_t* uv, int count) {
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m128i us = _mm_loadu_si128(reinterpret_cast<const __m128i*>(u + i));
+    const __m128i vs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(v + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(uv + 2 * i), _mm_unpacklo_epi8(us, vs));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(uv + 2 * i + 16), _mm_unpackhi_epi8(us, vs));
+  }
+  mergeUvScalar(u, v, uv, i, count);
+}
+
+__attribute__((target("avx2"))) void mergeUvAvx2(const uint8_t* u, const uint8_t* v, uint8_t* uv, int count) {
+  int i = 0;
+  for (; i + 32 <= count; i += 32) {
+    const __m256i us = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(u + i));
+    const __m256i vs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v + i));
+    const __m256i lo = _mm256_unpacklo_epi8(us, vs);  // 0-7 | 16-23
+    const __m256i hi = _mm256_unpackhi_epi8(us, vs);  // 8-15 | 24-31
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(uv + 2 * i), _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(uv + 2 * i + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+  }
+  mergeUvScalar(u, v, uv, i, count);
+}
+#endif
+
+#ifdef APP_COMMON_NEON
+void yuvToRgbaNeon(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* rgba, int width,
+                   const Coefficients& k) {
+  const int16x8_t k16 = vdupq_n_s16(16), k128 = vdupq_n_s16(128), round = vdupq_n_s16(32);
+  const int16x8_t yg = vdupq_n_s16(k.yg), rv = vdupq_n_s16(k.rv), gu = vdupq_n_s16(k.gu);
+  const int16x8_t gv = vdupq_n_s16(k.gv), bu = vdupq_n_s16(k.bu);
+
+  int x = 0;
+  for (; x + 16 <= width; x += 16) {
+    const uint8x16_t y8 = vld1q_u8(y + x);
+    const uint8x8x2_t u_dup = vzip_u8(vld1_u8(u + x / 2), vld1_u8(u + x / 2));
+    const uint8x8x2_t v_dup = vzip_u8(vld1_u8(v + x / 2), vld1_u8(v + x / 2));
+
+    uint8x8_t r[2], g[2], b[2];
+    for (int half = 0; half < 2; ++half) {
+      const uint8x8_t y_half = half ? vget_high_u8(y8) : vget_low_u8(y8);
+      const int16x8_t y16 = vreinterpretq_s16_u16(vmovl_u8(y_half));
+      const int16x8_t u16 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u_dup.val[half])), k128);
+      const int16x8_t v16 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v_dup.val[half])), k128);
+      const int16x8_t yv = vmulq_s16(vsubq_s16(y16, k16), yg);
+      r[half] = vqmovun_s16(vshrq_n_s16(vqaddq_s16(vqaddq_s16(yv, vmulq_s16(v16, rv)), round), 6));
+      g[half] = vqmovun_s16(
+          vshrq_n_s16(vqaddq_s16(vqsubq_s16(vqsubq_s16(yv, vmulq_s16(u16, gu)), vmulq_s16(v16, gv)), round), 6));
+      b[half] = vqmovun_s16(vshrq_n_s16(vqaddq_s16(vqaddq_s16(yv, vmulq_s16(u16, bu)), round), 6));
+    }
+    uint8x16x4_t out;
+    out.val[0] = vcombine_u8(r[0], r[1]);
+    out.val[1] = vcombine_u8(g[0], g[1]);
+    out.val[2] = vcombine_u8(b[0], b[1]);
+    out.val[3] = vdupq_n_u8(255);
+    vst4q_u8(rgba + 4 * x, out);
+  }
+  yuvToRgbaScalar(y, u, v, rgba, x, width, k);
+}
+
+void splitUvNeon(const uint8_t* uv, uint8_t* u, uint8_t* v, int count) {
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const uint8x16x2_t pair = vld2q_u8(uv + 2 * i);
+    vst1q_u8(u + i, pair.val[0]);
+    vst1q_u8(v + i, pair.val[1]);
+  }
+  splitUvScalar(uv, u, v, i, count);
+}
+
+void mergeUvNeon(const uint8_t* u, const uint8_t* v, uint8_t* uv, int count) {
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    uint8x16x2_t pair;
+    pair.val[0] = vld1q_u8(u + i);
+    pair.val[1] = vld1q_u8(v + i);
+    vst2q_u8(uv + 2 * i, pair);
+  }
+  mergeUvScalar(u, v, uv, i, count);
+}
+#endif
+
+// 출력 index i 의 픽셀 중심이 떨어지는 원본 index
+int nearest(int i, int out_size, int in_size, int offset) {
+  return offset + static_cast<int>((static_cast<int64_t>(2 * i + 1) * in_size) / (2 * static_cast<int64_t>(out_size)));
+}
+
+void buildMap(std::vector<int>& map, int out_size, int in_size, int offset) {
+  map.resize(static_cast<std::size_t>(out_size));
+  for (int i = 0; i < out_size; ++i) map[static_cast<std::size_t>(i)] = nearest(i, out_size, in_size, offset);
+}
+
+inline int half(int size) { return (size + 1) / 2; }
+
+}  // namespace
+
+void yuvToRgbaRow(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* rgba, int width, YuvMatrix matrix,
+                  SimdLevel level) {
+  const Coefficients& k = coefficientsFor(matrix);
+  if (!simdLevelSupported(level)) level = SimdLevel::Scalar;
+  switch (level) {
+#ifdef APP_COMMON_X86
+    case SimdLevel::Sse2:
+      return yuvToRgbaSse2(y, u, v, rgba, width, k);
+    case SimdLevel::Avx2:
+      return yuvToRgbaAvx2(y, u, v, rgba, width, k);
+#endif
+#ifdef APP_COMMON_NEON
+    case SimdLevel::Neon:
+      return yuvToRgbaNeon(y, u, v, rgba, width, k);
+#endif
+    default:
+      return yuvToRgbaScalar(y, u, v, rgba, 0, width, k);
+  }
+}
+
+void splitUvRow(const uint8_t* uv, uint8_t* u, uint8_t* v, int count, SimdLevel level) {
+  if (!simdLevelSupported(level)) level = SimdLevel::Scalar;
+  switch (level) {
+#ifdef APP_COMMON_X86
+    case SimdLevel::Sse2:
+      return splitUvSse2(uv, u, v, count);
+    case SimdLevel::Avx2:
+      return splitUvAvx2(uv, u, v, count);
+#endif
+#ifdef APP_COMMON_NEON
+    case SimdLevel::Neon:
+      return splitUvNeon(uv, u, v, count);
+#endif
+    default:
+      return splitUvScalar(uv, u, v, 0, count);
+  }
+}
+
+void mergeUvRow(const uint8_t* u, const uint8_t* v, uint8_t* uv, int count, SimdLevel level) {
+  if (!simdLevelSupported(level)) level = SimdLevel::Scalar;
+  switch (level) {
+#ifdef APP_COMMON_X86
+    case SimdLevel::Sse2:
+      return mergeUvSse2(u, v, uv, count);
+    case SimdLevel::Avx2:
+      return mergeUvAvx2(u, v, uv, count);
+#endif
+#ifdef APP_COMMON_NEON
+    case SimdLevel::Neon:
+      return mergeUvNeon(u, v, uv, count);
+#endif
+    default:
+      return mergeUvScalar(u, v, uv, 0, count);
+  }
+}
+
+YuvConverter::YuvConverter(SimdLevel level) : level_(simdLevelSupported(level) ? level : SimdLevel::Scalar) {}
+
+void YuvConverter::prepare(const Layout& layout) {
+  if (layout == layout_ && !y_map_.empty()) return;
+  layout_ = layout;
+
+  const RoiRect& crop = layout.crop;
+  const int chroma_x = crop.x / 2;
+  const int chroma_y = crop.y / 2;
+  scale_x_ = layout.dst_width != crop.width;
+  buildMap(x_map_, layout.dst_width, crop.width, crop.x);
+  buildMap(y_map_, layout.dst_height, crop.height, crop.y);
+  buildMap(cx_map_, half(layout.dst_width), half(crop.width), chroma_x);
+  buildMap(cy_map_, half(layout.dst_height), half(crop.height), chroma_y);
+
+  y_row_.resize(static_cast<std::size_t>(layout.dst_width));
+  u_row_.resize(static_cast<std::size_t>(half(layout.dst_width)));
+  v_row_.resize(static_cast<std::size_t>(half(layout.dst_width)));
+}
+
+const uint8_t* YuvConverter::lumaRow(const ImageView& src, int dst_row) {
+  const auto src_row = static_cast<std::ptrdiff_t>(y_map_[static_cast<std::size_t>(dst_row)]);
+  const uint8_t* row = src.data[0] + src_row * src.stride[0];
+  if (!scale_x_) return row + layout_.crop.x;
+  for (std::size_t x = 0; x < y_row_.size(); ++x) y_row_[x] = row[x_map_[x]];
+  return y_row_.data();
+}
+
+void YuvConverter::chromaRows(const ImageView& src, int dst_chroma_row, const uint8_t*& u, const uint8_t*& v) {
+  const std::ptrdiff_t src_row = cy_map_[static_cast<std::size_t>(dst_chroma_row)];
+  const int count = static_cast<int>(u_row_.size());
+  const int chroma_x = layout_.crop.x / 2;
+
+  if (src.format == PixelFormat::Nv12) {
+    const uint8_t* uv = src.data[1] + src_row * src.stride[1];
+    if (!scale_x_) {
+      splitUvRow(uv + 2 * chroma_x, u_row_.data(), v_row_.data(), count, level_);
+    } else {
+      for (int i = 0; i < count; ++i) {
+        const int x = cx_map_[static_cast<std::size_t>(i)];
+        u_row_[static_cast<std::size_t>(i)] = uv[2 * x];
+        v_row_[static_cast<std::size_t>(i)] = uv[2 * x + 1];
+      }
+    }
+    u = u_row_.data();
+    v = v_row_.data();
+    return;
+  }
+
+  const uint8_t* u_src = src.data[1] + src_row * src.stride[1];
+  const uint8_t* v_src = src.data[2] + src_row * src.stride[2];
+  if (!scale_x_) {
+    u = u_src + chroma_x;
+    v = v_src + chroma_x;
+    return;
+  }
+  for (int i = 0; i < count; ++i) {
+    const int x = cx_map_[static_cast<std::size_t>(i)];
+    u_row_[static_cast<std::size_t>(i)] = u_src[x];
+    v_row_[static_cast<std::size_t>(i)] = v_src[x];
+  }
+  u = u_row_.data();
+  v = v_row_.data();
+}
+
+bool YuvConverter::convert(const ImageView& src, const ImageView& dst, RoiRect crop, YuvMatrix matrix) {
+  if (src.format == PixelFormat::Rgba || src.width <= 0 || src.height <= 0 || dst.width <= 0 || dst.height <= 0) {
+    return false;
+  }
+
+  if (crop.width <= 0 || crop.height <= 0) crop = {0, 0, src.width, src.height};
+  crop.x = std::clamp(crop.x, 0, src.width - 1) & ~1;
+  crop.y = std::clamp(crop.y, 0, src.height - 1) & ~1;
+  crop.width = std::min(crop.width, src.width - crop.x);
+  crop.height = std::min(crop.height, src.height - crop.y);
+  prepare({crop, src.width, src.height, dst.width, dst.height});
+
+  const auto row_bytes = static_cast<std::size_t>(dst.width);
+  const uint8_t* u = nullptr;
+  const uint8_t* v = nullptr;
+
+  if (dst.format == PixelFormat::Rgba) {
+    int chroma_row = -1;
+    for (int y = 0; y < dst.height; ++y) {
+      if (y / 2 != chroma_row) {
+        chroma_row = y / 2;
+        chromaRows(src, chroma_row, u, v);
+      }
+      yuvToRgbaRow(lumaRow(src, y), u, v, dst.data[0] + static_cast<std::ptrdiff_t>(y) * dst.stride[0], dst.width,
+                   matrix, level_);
+    }
+    return true;
+  }
+
+  for (int y = 0; y < dst.height; ++y) {
+    std::memcpy(dst.data[0] + static_cast<std::ptrdiff_t>(y) * dst.stride[0], lumaRow(src, y), row_bytes);
+  }
+
+  const int chroma_width = half(dst.width);
+  for (int cy = 0; cy < half(dst.height); ++cy) {
+    if (dst.format == PixelFormat::Nv12) {
+      uint8_t* uv = dst.data[1] + static_cast<std::ptrdiff_t>(cy) * dst.stride[1];
+      if (src.format == PixelFormat::Nv12 && !scale_x_) {
+        // 같은 형식이면 나누었다 합칠 필요 없이 줄째로 옮긴다
+        const uint8_t* src_uv = src.data[1] + static_cast<std::ptrdiff_t>(cy_map_[static_cast<std::size_t>(cy)]) *
+                                                  src.stride[1];
+        std::memcpy(uv, src_uv + 2 * (crop.x / 2), 2 * static_cast<std::size_t>(chroma_width));
+        continue;
+      }
+      chromaRows(src, cy, u, v);
+      mergeUvRow(u, v, uv, chroma_width, level_);
+      continue;
+    }
+    chromaRows(src, cy, u, v);
+    const auto row = static_cast<std::ptrdiff_t>(cy);
+    std::memcpy(dst.data[1] + row * dst.stride[1], u, static_cast<std::size_t>(chroma_width));
+    std::memcpy(dst.data[2] + row * dst.stride[2], v, static_cast<std::size_t>(chroma_width));
+  }
+  return true;
+}
+
+}  // namespace app_common
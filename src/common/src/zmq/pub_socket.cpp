@@ -1,22 +1,388 @@
 #include "common/zmq/pub_socket.hpp"
 
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
 #include "common/utils/logging.hpp"
 
-PubSocket::PubSocket(zmq::context_t& ctx, const std::string_view endpoint) : socket_(ctx, zmq::socket_type::pub) {
+namespace {
+constexpr auto kWaitTimeout = std::chrono::milliseconds(100);
+constexpr char kRateHintSeparator = '@';
+
+constexpr std::size_t kMaxSpareBuffers = 64;
+
+bool startsWith(const std::string& str, const std::string& prefix) {
+  return str.compare(0, prefix.size(), prefix) == 0;
+}
+}  // namespace
+
+// zmq 가 다 보낸 payload 버퍼를 모아 두었다가 다음 메시지에 다시 쓴다.
+// free 콜백은 zmq I/O 스레드에서, 소켓이 닫힌 뒤에도 불릴 수 있으므로 보내는 중인 슬롯이 풀을 붙잡아 둔다.
+class PubSocket::PayloadPool : public std::enable_shared_from_this<PayloadPool> {
+public:
+  struct Slot {
+    std::shared_ptr<PayloadPool> pool;
+    std::string data;
+  };
+
+  PayloadPool() { spare_.reserve(kMaxSpareBuffers); }
+
+  std::string acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (spare_.empty()) return {};
+    std::string buffer = std::move(spare_.back());
+    spare_.pop_back();
+    return buffer;
+  }
+
+  // payload 를 슬롯으로 옮긴다. payload 는 빈 문자열이 된다.
+  Slot* hold(std::string& payload) {
+    Slot* slot;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (free_slots_.empty()) {
+        slots_.push_back(std::make_unique<Slot>());
+        slot = slots_.back().get();
+      } else {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+      }
+    }
+    slot->pool = shared_from_this();
+    slot->data.swap(payload);
+    return slot;
+  }
+
+  static void release(void* /*data*/, void* hint) {
+    auto* slot = static_cast<Slot*>(hint);
+    const std::shared_ptr<PayloadPool> pool = std::move(slot->pool);
+    std::lock_guard<std::mutex> lock(pool->mutex_);
+    if (pool->spare_.size() < kMaxSpareBuffers) {
+      slot->data.clear();
+      pool->spare_.push_back(std::move(slot->data));
+    }
+    slot->data = std::string();
+    pool->free_slots_.push_back(slot);
+  }
+
+private:
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Slot>> slots_;
+  std::vector<Slot*> free_slots_;
+  std::vector<std::string> spare_;
+};
+
+PubSocket::PubSocket(zmq::context_t& ctx, const std::string_view endpoint, std::size_t queue_capacity)
+    : socket_(ctx, zmq::socket_type::xpub),
+      payload_pool_(std::make_shared<PayloadPool>()),
+      high_queue_(queue_capacity),
+      normal_queue_(queue_capacity) {
   try {
+    // 중복 구독/해지까지 모두 받아야 구독자 수를 셀 수 있다
+#ifdef ZMQ_XPUB_VERBOSER
+    socket_.set(zmq::sockopt::xpub_verboser, 1);
+#else
+    socket_.set(zmq::sockopt::xpub_verbose, 1);
+#endif
     socket_.bind(std::string(endpoint));
     SPDLOG_ZMQ_INFO("PubSocket bind: {}", endpoint);
   } catch (const zmq::error_t& e) {
     SPDLOG_ZMQ_ERROR("PubSocket init failed: {}", e.what());
   }
+
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wake_fd_ < 0) {
+    SPDLOG_ZMQ_ERROR("PubSocket eventfd failed, sender falls back to polling");
+  }
+
+  sender_thread_ = std::thread(&PubSocket::run, this);
+}
+
+PubSocket::~PubSocket() {
+  running_ = false;
+  wakeSender();
+  if (sender_thread_.joinable()) sender_thread_.join();
+  if (wake_fd_ >= 0) close(wake_fd_);
+}
+
+PubSocket::TopicId PubSocket::registerTopic(const std::string_view topic, TopicPolicy policy) {
+  TopicId existing = findTopic(topic);
+  if (existing != kUnregisteredTopic) {
+    topics_[existing].policy = policy;
+    return existing;
+  }
+
+  std::size_t index = num_topics_.load(std::memory_order_relaxed);
+  if (index == kMaxTopics) {
+    SPDLOG_ZMQ_ERROR("PubSocket topic table full, {} is sent unregistered", topic);
+    return kUnregisteredTopic;
+  }
+
+  Topic& entry = topics_[index];
+  entry.name = std::string(topic);
+  entry.policy = policy;
+  entry.frame = zmq::message_t(topic.data(), topic.size());
+  num_topics_.store(index + 1, std::memory_order_release);
+  return static_cast<TopicId>(index);
+}
+
+PubSocket::TopicId PubSocket::findTopic(const std::string_view topic) const {
+  const std::size_t count = num_topics_.load(std::memory_order_acquire);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (topics_[i].name == topic) return static_cast<TopicId>(i);
+  }
+  return kUnregisteredTopic;
+}
+
+PubSocket::TopicId PubSocket::ensureTopic(const std::string_view topic) {
+  TopicId existing = findTopic(topic);
+  return existing != kUnregisteredTopic ? existing : registerTopic(topic, default_policy_);
+}
+
+std::string PubSocket::acquirePayload() { return payload_pool_->acquire(); }
+
+bool PubSocket::publish(const std::string_view topic, const std::string_view msg) {
+  std::string payload = acquirePayload();
+  payload.assign(msg.data(), msg.size());
+  return publish(topic, std::move(payload));
+}
+
+bool PubSocket::publish(const std::string_view topic, std::string&& msg) {
+  TopicId id = findTopic(topic);
+  if (id != kUnregisteredTopic) return publish(id, std::move(msg));
+
+  uint64_t seq;
+  {
+    std::lock_guard<std::mutex> lock(unregistered_mutex_);
+    auto it = unregistered_seq_.find(topic);
+    if (it == unregistered_seq_.end()) it = unregistered_seq_.emplace(std::string(topic), 0).first;
+    seq = ++it->second;
+  }
+  return enqueue({kUnregisteredTopic, seq, std::string(topic), std::move(msg)}, default_policy_);
+}
+
+bool PubSocket::publish(TopicId topic, std::string&& msg) {
+  if (!isValid(topic)) {
+    SPDLOG_ZMQ_ERROR("PubSocket publish with unknown topic id {}", topic);
+    return false;
+  }
+  Topic& entry = topics_[topic];
+  uint64_t seq = entry.last_seq.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (entry.policy.cache_last) cacheLastValue(entry, seq, msg);
+  return enqueue({topic, seq, std::string(), std::move(msg)}, entry.policy);
+}
+
+void PubSocket::cacheLastValue(const Topic& topic, uint64_t seq, const std::string& payload) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  auto it = last_values_.find(topic.name);
+  if (it == last_values_.end()) {
+    last_values_.emplace(topic.name, CachedMessage{topic.name, seq, payload});
+  } else if (seq > it->second.seq) {
+    it->second.seq = seq;
+    it->second.payload = payload;
+  }
+}
+
+std::vector<PubSocket::CachedMessage> PubSocket::snapshot(const std::string_view prefix) const {
+  std::vector<CachedMessage> result;
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  for (const auto& [name, cached] : last_values_) {
+    if (name.compare(0, prefix.size(), prefix) == 0) result.push_back(cached);
+  }
+  return result;
+}
+
+uint64_t PubSocket::dropped(Priority priority) const {
+  return priority == Priority::High ? high_queue_.dropped() : normal_queue_.dropped();
+}
+
+bool PubSocket::enqueue(OutgoingMessage&& message, const TopicPolicy& policy) {
+  if (!queueFor(policy.priority).push(std::move(message), policy.overflow)) {
+    SPDLOG_ZMQ_DEBUG("PubSocket queue full, dropped newest message");
+    return false;
+  }
+  wakeSender();
+  return true;
+}
+
+bool PubSocket::hasSubscribers(TopicId topic) const {
+  return isValid(topic) && topics_[topic].subscribers.load(std::memory_order_relaxed) > 0;
+}
+
+bool PubSocket::hasSubscribers(const std::string_view topic) const { return hasSubscribers(findTopic(topic)); }
+
+uint32_t PubSocket::requestedRate(TopicId topic) const {
+  return isValid(topic) ? topics_[topic].requested_rate.load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t PubSocket::subscriptionVersion(TopicId topic) const {
+  return isValid(topic) ? topics_[topic].subscription_version.load(std::memory_order_relaxed) : 0;
+}
+
+bool PubSocket::wantsPublish(const std::string_view topic) const {
+  TopicId id = findTopic(topic);
+  return hasSubscribers(id) || (isValid(id) && topics_[id].policy.cache_last);
+}
+
+bool PubSocket::isValid(TopicId topic) const {
+  return topic >= 0 && static_cast<std::size_t>(topic) < num_topics_.load(std::memory_order_acquire);
 }
 
-void PubSocket::publish(const std::string_view topic, const std::string_view msg) {
+const PubSocket::TopicPolicy& PubSocket::policyFor(TopicId topic) const {
+  return isValid(topic) ? topics_[topic].policy : default_policy_;
+}
+
+app_common::MpscQueue<PubSocket::OutgoingMessage>& PubSocket::queueFor(Priority priority) {
+  return priority == Priority::High ? high_queue_ : normal_queue_;
+}
+
+void PubSocket::run() {
+  OutgoingMessage message;
+
+  while (running_) {
+    receiveSubscriptions();
+
+    // High 큐를 항상 먼저 비우고, Normal 은 한 번에 하나씩만 보낸다
+    bool sent = false;
+    while (high_queue_.pop(message)) {
+      send(message);
+      sent = true;
+    }
+    if (normal_queue_.pop(message)) {
+      // 이 Normal 메시지보다 먼저 넣은 High 메시지(예: 그 bdet 가 쓰는 라벨 테이블)가 앞서 나가도록 한 번 더 비운다
+      OutgoingMessage high;
+      while (high_queue_.pop(high)) send(high);
+      send(message);
+      sent = true;
+    }
+
+    if (!sent) waitForMessages();
+  }
+
+  // 종료 전에 남은 메시지 전송
+  while (high_queue_.pop(message)) send(message);
+  while (normal_queue_.pop(message)) send(message);
+}
+
+void PubSocket::send(OutgoingMessage& message) {
   try {
-    socket_.send(zmq::buffer(topic), zmq::send_flags::sndmore);
-    socket_.send(zmq::buffer(msg), zmq::send_flags::none);
-    SPDLOG_ZMQ_DEBUG("PubSocket published: topic={}, msg={}", topic, msg);
+    if (message.topic_id != kUnregisteredTopic) {
+      zmq::message_t topic_frame;
+      topic_frame.copy(topics_[message.topic_id].frame);
+      socket_.send(topic_frame, zmq::send_flags::sndmore);
+    } else {
+      socket_.send(zmq::buffer(message.topic), zmq::send_flags::sndmore);
+    }
+
+    // payload 버퍼는 zmq 가 다 쓰고 나면 free 콜백에서 풀로 돌아간다
+    PayloadPool::Slot* slot = payload_pool_->hold(message.payload);
+    const std::size_t size = slot->data.size();
+    zmq::message_t body(slot->data.data(), size, &PayloadPool::release, slot);
+    socket_.send(body, zmq::send_flags::sndmore);
+
+    zmq::message_t seq_frame(&message.seq, sizeof(message.seq));
+    socket_.send(seq_frame, zmq::send_flags::none);
+    SPDLOG_ZMQ_DEBUG("PubSocket published: topic_id={}, seq={}, size={}", message.topic_id, message.seq, size);
   } catch (const zmq::error_t& e) {
     SPDLOG_ZMQ_ERROR("PubSocket failed to publish: {}", e.what());
   }
 }
+
+void PubSocket::receiveSubscriptions() {
+  bool changed = false;
+  zmq::message_t msg;
+
+  try {
+    while (socket_.recv(msg, zmq::recv_flags::dontwait)) {
+      if (msg.size() == 0) continue;
+
+      // 첫 바이트: 1 = 구독, 0 = 해지. 나머지는 토픽 prefix
+      const auto* data = msg.data<char>();
+      const bool subscribe = data[0] == 1;
+      std::string prefix(data + 1, msg.size() - 1);
+
+      if (subscribe) {
+        ++subscriptions_[prefix];
+        const std::size_t count = num_topics_.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; ++i) {
+          if (startsWith(topics_[i].name, prefix)) {
+            topics_[i].subscription_version.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      } else {
+        auto it = subscriptions_.find(prefix);
+        if (it != subscriptions_.end() && --it->second <= 0) subscriptions_.erase(it);
+      }
+      SPDLOG_ZMQ_DEBUG("PubSocket {}: '{}'", subscribe ? "subscribe" : "unsubscribe", prefix);
+      changed = true;
+    }
+  } catch (const zmq::error_t& e) {
+    SPDLOG_ZMQ_ERROR("PubSocket failed to receive subscription: {}", e.what());
+  }
+
+  if (changed) updateSubscriberCounts();
+}
+
+void PubSocket::updateSubscriberCounts() {
+  const std::size_t count = num_topics_.load(std::memory_order_acquire);
+  for (std::size_t i = 0; i < count; ++i) {
+    Topic& topic = topics_[i];
+    int subscribers = 0;
+    int rate_hints = 0;
+    uint32_t max_rate = 0;
+
+    for (const auto& [prefix, n] : subscriptions_) {
+      if (startsWith(topic.name, prefix)) {
+        subscribers += n;
+        continue;
+      }
+
+      // "<topic>@<hz>" 전송률 요청
+      if (prefix.size() > topic.name.size() + 1 && startsWith(prefix, topic.name) &&
+          prefix[topic.name.size()] == kRateHintSeparator) {
+        const long hz = std::strtol(prefix.c_str() + topic.name.size() + 1, nullptr, 10);
+        if (hz > 0) {
+          rate_hints += n;
+          max_rate = std::max(max_rate, static_cast<uint32_t>(hz));
+        }
+      }
+    }
+
+    // 전송률을 지정하지 않은 구독자가 하나라도 있으면 제한하지 않는다
+    topic.subscribers.store(subscribers, std::memory_order_relaxed);
+    topic.requested_rate.store(subscribers > rate_hints ? 0 : max_rate, std::memory_order_relaxed);
+  }
+}
+
+void PubSocket::wakeSender() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sender_waiting_.load() && wake_fd_ >= 0) {
+    uint64_t one = 1;
+    [[maybe_unused]] auto n = write(wake_fd_, &one, sizeof(one));
+  }
+}
+
+void PubSocket::waitForMessages() {
+  sender_waiting_.store(true);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (high_queue_.empty() && normal_queue_.empty() && running_) {
+    // 구독 메시지와 큐 알림(eventfd)을 함께 기다린다
+    zmq::pollitem_t items[] = {{static_cast<void*>(socket_), 0, ZMQ_POLLIN, 0}, {nullptr, wake_fd_, ZMQ_POLLIN, 0}};
+    try {
+      zmq::poll(items, wake_fd_ >= 0 ? 2 : 1, kWaitTimeout);
+    } catch (const zmq::error_t& e) {
+      SPDLOG_ZMQ_ERROR("PubSocket poll failed: {}", e.what());
+    }
+  }
+
+  if (wake_fd_ >= 0) {
+    uint64_t count;
+    [[maybe_unused]] auto n = read(wake_fd_, &count, sizeof(count));
+  }
+  sender_waiting_.store(false);
+}
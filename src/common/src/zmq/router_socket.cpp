@@ -0,0 +1,49 @@
+#include "common/zmq/router_socket.hpp"
+
+#include "common/utils/logging.hpp"
+
+RouterSocket::RouterSocket(zmq::context_t& ctx, const std::string_view endpoint)
+    : socket_(ctx, zmq::socket_type::router) {
+  try {
+    socket_.bind(std::string(endpoint));
+    SPDLOG_ZMQ_INFO("RouterSocket bind: {}", endpoint);
+  } catch (const zmq::error_t& e) {
+    SPDLOG_ZMQ_ERROR("RouterSocket init failed: {}", e.what());
+  }
+}
+
+std::optional<RouterSocket::Request> RouterSocket::receive() {
+  try {
+    Request request;
+    zmq::message_t frame;
+    do {
+      if (!socket_.recv(frame, zmq::recv_flags::none)) return std::nullopt;
+      request.envelope.push_back(std::move(frame));
+      frame = zmq::message_t();
+    } while (request.envelope.back().more());
+
+    // 마지막 프레임이 본문, 나머지는 응답할 때 그대로 돌려줄 envelope
+    if (request.envelope.size() < 2) {
+      SPDLOG_ZMQ_WARN("RouterSocket dropped request without envelope");
+      return std::nullopt;
+    }
+    request.body = request.envelope.back().to_string();
+    request.envelope.pop_back();
+    return request;
+  } catch (const zmq::error_t& e) {
+    SPDLOG_ZMQ_ERROR("RouterSocket receive error: {}", e.what());
+  }
+  return std::nullopt;
+}
+
+void RouterSocket::send(Request& request, const std::string_view msg) {
+  try {
+    for (auto& frame : request.envelope) {
+      socket_.send(frame, zmq::send_flags::sndmore);
+    }
+    socket_.send(zmq::buffer(msg), zmq::send_flags::none);
+    SPDLOG_ZMQ_DEBUG("RouterSocket sent reply: {}", msg);
+  } catch (const zmq::error_t& e) {
+    SPDLOG_ZMQ_ERROR("RouterSocket failed to send reply: {}", e.what());
+  }
+}
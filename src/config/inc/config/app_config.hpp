@@ -4,4 +4,8 @@
 
 namespace app_config {
 inline constexpr std::string_view kLogFile = "/var/log/vision/backend.log";
+
+// 실행 중 설정 파일 (app_common::parseRuntimeConfig 형식). 바뀌면 kRuntimeConfigPollMs 안에 다시 적용한다
+inline constexpr std::string_view kRuntimeConfigFile = "/etc/vision-backend/runtime.json";
+inline constexpr int kRuntimeConfigPollMs = 1000;
 }
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace app_config {
+// 입력 목록. 0 번은 input-selector / 미리보기(shm) 가 붙는 주 입력이고, 나머지는 추론 전용으로
+// streammux sink_<i> 에 바로 연결된다. 모든 입력은 하나의 nvinfer 엔진에서 배치로 추론된다.
+inline constexpr const char* kCameraSources[] = {
+    "https://cdn.pixabay.com/video/2016/02/14/2165-155327596_large.mp4",
+};
+inline constexpr std::size_t kMaxCameraSources = 8;
+
+// 빌드 프로파일 (CMake 옵션 VISION_WITH_DEEPSTREAM). 끄면 같은 토폴로지를 표준 요소로 구성한다:
+// nvvideoconvert -> visionconvert, nvstreammux -> funnel (배치 없이 입력마다 프레임 하나), nvinfer -> visionfakeinfer.
+#ifndef VISION_WITH_DEEPSTREAM
+#define VISION_WITH_DEEPSTREAM 1
+#endif
+inline constexpr bool kWithDeepStream = VISION_WITH_DEEPSTREAM;
+// visionconvert / visionfakeinfer 플러그인 경로 (CMake 가 정한다: 설치용 빌드는 설치 경로, 아니면 빌드 출력 경로).
+// gst_init 이 GST_PLUGIN_PATH 와 기본 경로를 훑은 뒤에 추가로 훑으므로, 같은 플러그인이 그쪽에 있으면 그것이 쓰인다.
+#ifndef VISION_PLUGIN_PATH
+#define VISION_PLUGIN_PATH ""
+#endif
+inline constexpr const char* kPluginPath = VISION_PLUGIN_PATH;
+
+// 추론 분기로 들어오는 원본 해상도와 streammux 출력 해상도
+inline constexpr int kInferenceFrameWidth = 1920;
+inline constexpr int kInferenceFrameHeight = 1080;
+inline constexpr int kStreammuxWidth = 960;
+inline constexpr int kStreammuxHeight = 544;
+
+#if VISION_WITH_DEEPSTREAM
+inline constexpr const char* kVideoConvertElement = "nvvideoconvert";
+inline constexpr const char* kStreamMuxElement = "nvstreammux";
+inline constexpr const char* kInferElement = "nvinfer";
+inline constexpr const char* kDecodedCaps = "video/x-raw(memory:NVMM)";
+inline constexpr const char* kMuxInputFormat = "video/x-raw(memory:NVMM),format=NV12";
+#else
+inline constexpr const char* kVideoConvertElement = "visionconvert";
+inline constexpr const char* kStreamMuxElement = "funnel";
+inline constexpr const char* kInferElement = "visionfakeinfer";
+inline constexpr const char* kDecodedCaps = "video/x-raw";
+inline constexpr const char* kMuxInputFormat = "video/x-raw,format=NV12";
+#endif
+// streammux 입력 caps. nvstreammux 는 스스로 스케일하므로 형식만 두고, funnel 은 스케일하지 않으므로
+// 모든 입력을 streammux 출력 크기로 맞춘다.
+inline std::string muxInputCaps() {
+  if (kWithDeepStream) return kMuxInputFormat;
+  return std::string(kMuxInputFormat) + ",width=" + std::to_string(kStreammuxWidth) +
+         ",height=" + std::to_string(kStreammuxHeight);
+}
+
+// 카메라 파이프라인 기술 파일 (app_common::PipelineSpec JSON). 없으면 코드에 든 기본 파이프라인을 쓴다.
+// 속성 값에는 ${source0_uri}, ${mux_batch}, ${infer_batch}, ${max_lateness} 를 쓸 수 있다.
+inline constexpr const char* kCameraPipelineFile = "/etc/vision-backend/camera_pipeline.json";
+inline constexpr const char* kInferConfigFile = "/etc/vision-backend/config_infer_primary.txt";
+// 실행 중 속성 변경을 buffer 사이에 적용하기까지 기다리는 최대 시간
+inline constexpr int32_t kLivePropertyTimeoutMs = 500;
+// 입력 / 파이프라인 재시작 간격. 실패가 이어지면 두 배씩 늘려 최대값에서 멈추고, 프레임이 다시 나오면 처음 값으로 돌아간다
+inline constexpr int32_t kRestartBackoffInitialMs = 500;
+inline constexpr int32_t kRestartBackoffMaxMs = 30000;
+
+// 추론 분기 큐(q2) 깊이와 streammux batched-push-timeout 의 기본값 / 자동 조정 범위
+inline constexpr uint32_t kInferenceQueueDepth = 5;
+inline constexpr uint32_t kInferenceQueueDepthMin = 2;
+inline constexpr uint32_t kInferenceQueueDepthMax = 10;
+inline constexpr int32_t kBatchedPushTimeoutUs = 33000;
+inline constexpr int32_t kBatchedPushTimeoutUsMin = 16000;
+inline constexpr int32_t kBatchedPushTimeoutUsMax = 66000;
+
+// 자동 조정 목표: 1 초 동안 q2 로 들어온 프레임 중 버려지는 비율
+inline constexpr double kTargetDropRate = 0.01;
+inline constexpr bool kAdaptiveQueueTuning = false;
+
+// 캡처 후 이 시간이 지난 프레임은 streammux 전에 버린다 (0 이면 끔)
+inline constexpr int32_t kInferenceDeadlineMs = 200;
+// appsink 의 QoS 이벤트를 tee 너머(디코더)까지 보낼지. 디코더는 프론트 미리보기와 공유하므로 기본은 추론 분기에서 멈춘다.
+inline constexpr bool kPropagateQosPastTee = false;
+
+// 객체가 이 시간 동안 보이지 않으면 추론 분기의 fps 를 kActivityIdleFps 로 낮춘다 (미리보기 분기는 그대로)
+inline constexpr bool kActivityControl = true;
+inline constexpr int kActivityIdleFps = 2;
+inline constexpr int32_t kActivityIdleAfterMs = 10000;
+
+// 마지막으로 추론한 프레임과의 luma 평균 절대 차이가 kMotionThreshold 미만인 프레임이
+// kMotionStaticFrames 번 이어지면 추론을 건너뛴다. kMotionMaxSkipFrames 프레임마다 한 번은 추론한다.
+inline constexpr bool kMotionGate = true;
+inline constexpr double kMotionThreshold = 2.0;
+inline constexpr int kMotionRowStep = 8;
+inline constexpr uint32_t kMotionStaticFrames = 3;
+inline constexpr uint32_t kMotionMaxSkipFrames = 30;
+
+// 전체 프레임과 함께 streammux 로 배치할 관심 영역 ("x:y:w:h;..." 원본 픽셀 좌표, 빈 문자열이면 없음).
+// nvinfer batch-size 는 입력 수 + kInferenceMaxRois 로 설정되므로 엔진도 그 배치 크기로 만들어야 한다.
+// ROI 는 0 번 입력에만 적용된다.
+inline constexpr uint32_t kInferenceMaxRois = 3;
+inline constexpr const char* kInferenceRois = "";
+// 전체 프레임과 ROI (또는 겹치는 ROI 끼리) 에서 같은 class 박스가 작은 박스 넓이의 이 비율 이상 겹치면 한 객체로 합친다
+inline constexpr float kRoiMergeOverlap = 0.7f;
+}  // namespace app_config
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+namespace app_config {
+// AiService 의 SORT 추적기. 끄면 det 에 track_id 가 실리지 않는다.
+inline constexpr bool kTrackerEnabled = true;
+inline constexpr float kTrackerIouThreshold = 0.3f;
+inline constexpr uint32_t kTrackerMaxAge = 5;
+inline constexpr uint32_t kTrackerMinHits = 3;
+// delta 출력에서 박스가 자기 크기의 이 비율 이상 움직여야 moved 로 보낸다
+inline constexpr float kTrackDeltaThreshold = 0.05f;
+// true 이면 det(JSON) 대신 trk 로 추적 변화만 보낸다
+inline constexpr bool kTrackDeltaOutput = false;
+
+// 검출 후처리 필터 (추적/발행 전에 적용). AI_FILTER 로 실행 중에 바꿀 수 있다.
+inline constexpr float kPostFilterMinConfidence = 0.0f;
+inline constexpr const char* kPostFilterClassConfidence = "";  // "class:conf;class:conf"
+inline constexpr const char* kPostFilterClasses = "";          // "class;class", 비어 있으면 모두 허용
+inline constexpr float kPostFilterMinArea = 0.0f;              // streammux 좌표 px^2
+inline constexpr float kPostFilterNmsIou = 0.0f;               // 0 이면 NMS 끔
+}  // namespace app_config
@@ -9,6 +9,11 @@ inline constexpr std::string_view kEventEndpoint = "ipc:///tmp/app.events";
 
 // Topics
 inline constexpr std::string_view kTopicDetections = "det";
+inline constexpr std::string_view kTopicDetectionsBinary = "bdet";
+inline constexpr std::string_view kTopicDetectionLabels = "bdet.labels";
+inline constexpr std::string_view kTopicTracks = "trk";
 inline constexpr std::string_view kTopicBluetooth = "blt";
 inline constexpr std::string_view kTopicTrackChanged = "TRACK_CHANGED";
+inline constexpr std::string_view kTopicJob = "job";
+inline constexpr std::string_view kTopicMetrics = "metrics";
 }  // namespace app_config
@@ -0,0 +1,43 @@
+#pragma once
+
+// DeepStream SDK 가 없는 환경을 위한 gstnvdsmeta.h 대체본 (nvdsmeta.h 참고).
+
+#include <gst/gst.h>
+
+#include "nvdsmeta.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NVDS_GST_CUSTOM_META 4096
+
+typedef enum {
+  NVDS_GST_INVALID_META = -1,
+  NVDS_BATCH_GST_META = NVDS_GST_CUSTOM_META + 1,
+} GstNvDsMetaType;
+
+typedef struct _NvDsMeta {
+  GstMeta meta;
+  gpointer meta_data;
+  gpointer user_data;
+  gint meta_type;
+  NvDsMetaCopyFunc copyfunc;
+  NvDsMetaReleaseFunc freefunc;
+} NvDsMeta;
+
+GType nvds_meta_api_get_type(void);
+#define NVDS_META_API_TYPE (nvds_meta_api_get_type())
+const GstMetaInfo* nvds_meta_get_info(void);
+
+NvDsMeta* gst_buffer_add_nvds_meta(GstBuffer* buffer, gpointer meta_data, gpointer user_data,
+                                   NvDsMetaCopyFunc copy_func, NvDsMetaReleaseFunc release_func);
+NvDsBatchMeta* gst_buffer_get_nvds_batch_meta(GstBuffer* buffer);
+
+// NvDsMeta 에 NvDsBatchMeta 를 실을 때 쓰는 복사/해제 함수
+gpointer nvds_batch_meta_copy_func(gpointer data, gpointer user_data);
+void nvds_batch_meta_release_func(gpointer data, gpointer user_data);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,96 @@
+#pragma once
+
+// DeepStream SDK 가 없는 환경을 위한 nvdsmeta.h 대체본.
+// 이 저장소가 쓰는 필드와 함수만 같은 이름으로 옮겨 왔다. 소스 호환이지 ABI 호환은 아니므로
+// DeepStream 라이브러리와 섞어 링크하면 안 된다. 풀(pool) 없이 필요할 때마다 할당한다.
+
+#include <glib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAX_LABEL_SIZE 128
+#define UNTRACKED_OBJECT_ID 0xFFFFFFFFFFFFFFFF
+
+typedef GList NvDsMetaList;
+typedef NvDsMetaList NvDsFrameMetaList;
+typedef NvDsMetaList NvDsObjectMetaList;
+
+typedef enum {
+  NVDS_INVALID_META = -1,
+  NVDS_BATCH_META = 1,
+  NVDS_FRAME_META,
+  NVDS_OBJ_META,
+} NvDsMetaType;
+
+typedef gpointer (*NvDsMetaCopyFunc)(gpointer data, gpointer user_data);
+typedef void (*NvDsMetaReleaseFunc)(gpointer data, gpointer user_data);
+
+struct _NvDsBatchMeta;
+
+typedef struct _NvDsBaseMeta {
+  struct _NvDsBatchMeta* batch_meta;
+  NvDsMetaType meta_type;
+  void* uContext;
+  NvDsMetaCopyFunc copy_func;
+  NvDsMetaReleaseFunc release_func;
+} NvDsBaseMeta;
+
+typedef struct _NvOSD_RectParams {
+  float left;
+  float top;
+  float width;
+  float height;
+  unsigned int border_width;
+} NvOSD_RectParams;
+
+typedef struct _NvDsObjectMeta {
+  NvDsBaseMeta base_meta;
+  struct _NvDsObjectMeta* parent;
+  gint unique_component_id;
+  gint class_id;
+  guint64 object_id;
+  gfloat confidence;
+  gfloat tracker_confidence;
+  NvOSD_RectParams rect_params;
+  gchar obj_label[MAX_LABEL_SIZE];
+} NvDsObjectMeta;
+
+typedef struct _NvDsFrameMeta {
+  NvDsBaseMeta base_meta;
+  guint pad_index;
+  guint batch_id;
+  gint frame_num;
+  guint64 buf_pts;
+  guint64 ntp_timestamp;
+  guint source_id;
+  gint num_surfaces_per_frame;
+  guint source_frame_width;
+  guint source_frame_height;
+  guint surface_index;
+  guint num_obj_meta;
+  gboolean bInferDone;
+  NvDsObjectMetaList* obj_meta_list;
+} NvDsFrameMeta;
+
+typedef struct _NvDsBatchMeta {
+  NvDsBaseMeta base_meta;
+  guint max_frames_in_batch;
+  guint num_frames_in_batch;
+  NvDsFrameMetaList* frame_meta_list;
+} NvDsBatchMeta;
+
+NvDsBatchMeta* nvds_create_batch_meta(guint max_batch_size);
+gboolean nvds_destroy_batch_meta(NvDsBatchMeta* batch_meta);
+
+NvDsFrameMeta* nvds_acquire_frame_meta_from_pool(NvDsBatchMeta* batch_meta);
+void nvds_add_frame_meta_to_batch(NvDsBatchMeta* batch_meta, NvDsFrameMeta* frame_meta);
+
+NvDsObjectMeta* nvds_acquire_obj_meta_from_pool(NvDsBatchMeta* batch_meta);
+// 객체는 목록 맨 앞에 붙는다 (긴 목록에서 append 의 O(n) 을 피하려고)
+void nvds_add_obj_meta_to_frame(NvDsFrameMeta* frame_meta, NvDsObjectMeta* obj_meta, NvDsObjectMeta* obj_parent);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,156 @@
+#include <gstnvdsmeta.h>
+#include <nvdsmeta.h>
+
+namespace {
+
+void freeFrame(NvDsFrameMeta* frame_meta) {
+  g_list_free_full(frame_meta->obj_meta_list, g_free);
+  g_free(frame_meta);
+}
+
+NvDsFrameMeta* copyFrame(const NvDsFrameMeta* src, NvDsBatchMeta* batch_meta) {
+  auto* dst = g_new(NvDsFrameMeta, 1);
+  *dst = *src;
+  dst->base_meta.batch_meta = batch_meta;
+  dst->obj_meta_list = nullptr;
+  for (NvDsMetaList* l = src->obj_meta_list; l != nullptr; l = l->next) {
+    auto* obj = g_new(NvDsObjectMeta, 1);
+    *obj = *static_cast<const NvDsObjectMeta*>(l->data);
+    obj->base_meta.batch_meta = batch_meta;
+    obj->parent = nullptr;
+    dst->obj_meta_list = g_list_prepend(dst->obj_meta_list, obj);
+  }
+  dst->obj_meta_list = g_list_reverse(dst->obj_meta_list);
+  return dst;
+}
+
+gboolean metaInit(GstMeta* meta, gpointer, GstBuffer*) {
+  auto* nvds_meta = reinterpret_cast<NvDsMeta*>(meta);
+  nvds_meta->meta_data = nullptr;
+  nvds_meta->user_data = nullptr;
+  nvds_meta->meta_type = NVDS_GST_INVALID_META;
+  nvds_meta->copyfunc = nullptr;
+  nvds_meta->freefunc = nullptr;
+  return TRUE;
+}
+
+void metaFree(GstMeta* meta, GstBuffer*) {
+  auto* nvds_meta = reinterpret_cast<NvDsMeta*>(meta);
+  if (nvds_meta->freefunc && nvds_meta->meta_data) nvds_meta->freefunc(nvds_meta->meta_data, nvds_meta->user_data);
+}
+
+// 버퍼가 복사될 때(make_writable 등)만 따라간다
+gboolean metaTransform(GstBuffer* dest, GstMeta* meta, GstBuffer*, GQuark type, gpointer) {
+  auto* src = reinterpret_cast<NvDsMeta*>(meta);
+  if (!GST_META_TRANSFORM_IS_COPY(type) || !src->copyfunc) return FALSE;
+
+  NvDsMeta* copy = gst_buffer_add_nvds_meta(dest, src->copyfunc(src->meta_data, src->user_data), src->user_data,
+                                            src->copyfunc, src->freefunc);
+  copy->meta_type = src->meta_type;
+  return TRUE;
+}
+
+}  // namespace
+
+extern "C" {
+
+NvDsBatchMeta* nvds_create_batch_meta(guint max_batch_size) {
+  auto* batch_meta = g_new0(NvDsBatchMeta, 1);
+  batch_meta->base_meta.batch_meta = batch_meta;
+  batch_meta->base_meta.meta_type = NVDS_BATCH_META;
+  batch_meta->max_frames_in_batch = max_batch_size;
+  return batch_meta;
+}
+
+gboolean nvds_destroy_batch_meta(NvDsBatchMeta* batch_meta) {
+  if (!batch_meta) return FALSE;
+  for (NvDsMetaList* l = batch_meta->frame_meta_list; l != nullptr; l = l->next) {
+    freeFrame(static_cast<NvDsFrameMeta*>(l->data));
+  }
+  g_list_free(batch_meta->frame_meta_list);
+  g_free(batch_meta);
+  return TRUE;
+}
+
+NvDsFrameMeta* nvds_acquire_frame_meta_from_pool(NvDsBatchMeta* batch_meta) {
+  auto* frame_meta = g_new0(NvDsFrameMeta, 1);
+  frame_meta->base_meta.batch_meta = batch_meta;
+  frame_meta->base_meta.meta_type = NVDS_FRAME_META;
+  frame_meta->num_surfaces_per_frame = 1;
+  return frame_meta;
+}
+
+void nvds_add_frame_meta_to_batch(NvDsBatchMeta* batch_meta, NvDsFrameMeta* frame_meta) {
+  batch_meta->frame_meta_list = g_list_append(batch_meta->frame_meta_list, frame_meta);
+  batch_meta->num_frames_in_batch++;
+}
+
+NvDsObjectMeta* nvds_acquire_obj_meta_from_pool(NvDsBatchMeta* batch_meta) {
+  auto* obj_meta = g_new0(NvDsObjectMeta, 1);
+  obj_meta->base_meta.batch_meta = batch_meta;
+  obj_meta->base_meta.meta_type = NVDS_OBJ_META;
+  obj_meta->object_id = UNTRACKED_OBJECT_ID;
+  return obj_meta;
+}
+
+void nvds_add_obj_meta_to_frame(NvDsFrameMeta* frame_meta, NvDsObjectMeta* obj_meta, NvDsObjectMeta* obj_parent) {
+  obj_meta->parent = obj_parent;
+  frame_meta->obj_meta_list = g_list_prepend(frame_meta->obj_meta_list, obj_meta);
+  frame_meta->num_obj_meta++;
+}
+
+gpointer nvds_batch_meta_copy_func(gpointer data, gpointer) {
+  const auto* src = static_cast<const NvDsBatchMeta*>(data);
+  NvDsBatchMeta* dst = nvds_create_batch_meta(src->max_frames_in_batch);
+  dst->base_meta.copy_func = src->base_meta.copy_func;
+  dst->base_meta.release_func = src->base_meta.release_func;
+  for (NvDsMetaList* l = src->frame_meta_list; l != nullptr; l = l->next) {
+    nvds_add_frame_meta_to_batch(dst, copyFrame(static_cast<const NvDsFrameMeta*>(l->data), dst));
+  }
+  return dst;
+}
+
+void nvds_batch_meta_release_func(gpointer data, gpointer) {
+  nvds_destroy_batch_meta(static_cast<NvDsBatchMeta*>(data));
+}
+
+GType nvds_meta_api_get_type(void) {
+  static gsize type = 0;
+  static const gchar* tags[] = {nullptr};
+  if (g_once_init_enter(&type)) {
+    g_once_init_leave(&type, gst_meta_api_type_register("NvDsMetaAPI", tags));
+  }
+  return static_cast<GType>(type);
+}
+
+const GstMetaInfo* nvds_meta_get_info(void) {
+  static gsize info = 0;
+  if (g_once_init_enter(&info)) {
+    const GstMetaInfo* registered =
+        gst_meta_register(NVDS_META_API_TYPE, "NvDsMeta", sizeof(NvDsMeta), metaInit, metaFree, metaTransform);
+    g_once_init_leave(&info, reinterpret_cast<gsize>(registered));
+  }
+  return reinterpret_cast<const GstMetaInfo*>(info);
+}
+
+NvDsMeta* gst_buffer_add_nvds_meta(GstBuffer* buffer, gpointer meta_data, gpointer user_data,
+                                   NvDsMetaCopyFunc copy_func, NvDsMetaReleaseFunc release_func) {
+  auto* meta = reinterpret_cast<NvDsMeta*>(gst_buffer_add_meta(buffer, nvds_meta_get_info(), nullptr));
+  meta->meta_data = meta_data;
+  meta->user_data = user_data;
+  meta->copyfunc = copy_func;
+  meta->freefunc = release_func;
+  return meta;
+}
+
+NvDsBatchMeta* gst_buffer_get_nvds_batch_meta(GstBuffer* buffer) {
+  gpointer state = nullptr;
+  GstMeta* meta = nullptr;
+  while ((meta = gst_buffer_iterate_meta_filtered(buffer, &state, NVDS_META_API_TYPE)) != nullptr) {
+    auto* nvds_meta = reinterpret_cast<NvDsMeta*>(meta);
+    if (nvds_meta->meta_type == NVDS_BATCH_GST_META) return static_cast<NvDsBatchMeta*>(nvds_meta->meta_data);
+  }
+  return nullptr;
+}
+
+}  // extern "C"
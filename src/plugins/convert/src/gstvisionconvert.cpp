@@ -0,0 +1,295 @@
+// visionconvert: nvvideoconvert 가 없는 환경(x86 재생/테스트 서버)을 위한 CPU 변환 요소.
+// NV12/I420 입력을 NV12/I420/RGBA 로 바꾸면서 최근접 스케일과 src-crop 을 한 번에 처리한다.
+// 줄 커널은 app_common::YuvConverter 의 SIMD(AVX2/SSE2/NEON) 구현을 쓴다.
+//
+//   gst-launch-1.0 videotestsrc ! video/x-raw,format=NV12,width=1920,height=1080
+//       ! visionconvert src-crop=480:270:960:540 ! video/x-raw,format=RGBA,width=960,height=544 ! fakesink
+//
+// 플러그인은 GST_PLUGIN_PATH 로 찾게 하거나 lib/gstreamer-1.0 에 설치해서 쓴다.
+
+#include <gst/gst.h>
+#include <gst/video/gstvideofilter.h>
+#include <gst/video/video.h>
+
+#include <cstdio>
+#include <memory>
+
+#include "common/vision/yuv_convert.hpp"
+
+GST_DEBUG_CATEGORY_STATIC(vision_convert_debug);
+#define GST_CAT_DEFAULT vision_convert_debug
+
+namespace {
+enum {
+  PROP_0,
+  PROP_SRC_CROP,
+};
+}  // namespace
+
+typedef struct _GstVisionConvert {
+  GstVideoFilter parent;
+
+  app_common::RoiRect crop;  // object lock 으로 보호. 비어 있으면 전체 프레임
+  app_common::YuvMatrix matrix;
+  app_common::YuvConverter* converter;
+} GstVisionConvert;
+
+typedef struct _GstVisionConvertClass {
+  GstVideoFilterClass parent_class;
+} GstVisionConvertClass;
+
+GType gst_vision_convert_get_type(void);
+G_DEFINE_TYPE(GstVisionConvert, gst_vision_convert, GST_TYPE_VIDEO_FILTER)
+
+#define GST_VISION_CONVERT(obj) (reinterpret_cast<GstVisionConvert*>(obj))
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE(
+    "sink", GST_PAD_SINK, GST_PAD_ALWAYS, GST_STATIC_CAPS(GST_VIDEO_CAPS_MAKE("{ NV12, I420 }")));
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE(
+    "src", GST_PAD_SRC, GST_PAD_ALWAYS, GST_STATIC_CAPS(GST_VIDEO_CAPS_MAKE("{ NV12, I420, RGBA }")));
+
+namespace {
+
+bool toPixelFormat(GstVideoFormat format, app_common::PixelFormat& out) {
+  switch (format) {
+    case GST_VIDEO_FORMAT_NV12:
+      out = app_common::PixelFormat::Nv12;
+      return true;
+    case GST_VIDEO_FORMAT_I420:
+      out = app_common::PixelFormat::I420;
+      return true;
+    case GST_VIDEO_FORMAT_RGBA:
+      out = app_common::PixelFormat::Rgba;
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool toImageView(GstVideoFrame* frame, app_common::ImageView& view) {
+  if (!toPixelFormat(GST_VIDEO_FRAME_FORMAT(frame), view.format)) return false;
+  view.width = GST_VIDEO_FRAME_WIDTH(frame);
+  view.height = GST_VIDEO_FRAME_HEIGHT(frame);
+  for (guint p = 0; p < GST_VIDEO_FRAME_N_PLANES(frame) && p < 3; ++p) {
+    view.data[p] = static_cast<uint8_t*>(GST_VIDEO_FRAME_PLANE_DATA(frame, p));
+    view.stride[p] = GST_VIDEO_FRAME_PLANE_STRIDE(frame, p);
+  }
+  return true;
+}
+
+// nvvideoconvert 의 src-crop 과 같은 "left:top:width:height" 형식. 빈 문자열이면 crop 해제
+bool parseCrop(const gchar* text, app_common::RoiRect& crop) {
+  if (!text || !*text) {
+    crop = {};
+    return true;
+  }
+  int left = 0, top = 0, width = 0, height = 0;
+  char tail = 0;
+  if (std::sscanf(text, "%d:%d:%d:%d%c", &left, &top, &width, &height, &tail) != 4) return false;
+  if (left < 0 || top < 0 || width < 0 || height < 0) return false;
+  crop = {left, top, width, height};
+  return true;
+}
+
+app_common::RoiRect currentCrop(GstVisionConvert* self) {
+  GST_OBJECT_LOCK(self);
+  const app_common::RoiRect crop = self->crop;
+  GST_OBJECT_UNLOCK(self);
+  return crop;
+}
+
+bool cropIsEmpty(const app_common::RoiRect& crop) { return crop.width <= 0 || crop.height <= 0; }
+
+}  // namespace
+
+// 크기와 형식은 자유롭게 바꿀 수 있으므로 그 필드를 지우고 템플릿과 맞춘다 (videoconvert + videoscale 과 같은 방식)
+static GstCaps* gst_vision_convert_transform_caps(GstBaseTransform* trans, GstPadDirection direction, GstCaps* caps,
+                                                  GstCaps* filter) {
+  GstCaps* result = gst_caps_new_empty();
+  const guint n = gst_caps_get_size(caps);
+  for (guint i = 0; i < n; ++i) {
+    GstStructure* structure = gst_caps_get_structure(caps, i);
+    GstCapsFeatures* features = gst_caps_get_features(caps, i);
+    if (i > 0 && gst_caps_is_subset_structure_full(result, structure, features)) continue;
+
+    structure = gst_structure_copy(structure);
+    gst_structure_set(structure, "width", GST_TYPE_INT_RANGE, 1, G_MAXINT, "height", GST_TYPE_INT_RANGE, 1, G_MAXINT,
+                      nullptr);
+    gst_structure_remove_fields(structure, "format", "colorimetry", "chroma-site", "pixel-aspect-ratio", nullptr);
+    gst_caps_append_structure_full(result, structure, gst_caps_features_copy(features));
+  }
+
+  GstPadTemplate* templ = gst_element_class_get_pad_template(GST_ELEMENT_GET_CLASS(trans),
+                                                             direction == GST_PAD_SINK ? "src" : "sink");
+  GstCaps* templ_caps = gst_pad_template_get_caps(templ);
+  GstCaps* allowed = gst_caps_intersect(result, templ_caps);
+  gst_caps_unref(templ_caps);
+  gst_caps_unref(result);
+
+  if (filter) {
+    GstCaps* filtered = gst_caps_intersect_full(filter, allowed, GST_CAPS_INTERSECT_FIRST);
+    gst_caps_unref(allowed);
+    allowed = filtered;
+  }
+  GST_DEBUG_OBJECT(trans, "transformed %" GST_PTR_FORMAT " into %" GST_PTR_FORMAT, caps, allowed);
+  return allowed;
+}
+
+// 다운스트림이 정하지 않았다면 입력(또는 crop) 크기와 입력 형식을 그대로 고른다
+static GstCaps* gst_vision_convert_fixate_caps(GstBaseTransform* trans, GstPadDirection direction, GstCaps* caps,
+                                               GstCaps* othercaps) {
+  othercaps = gst_caps_truncate(othercaps);
+  othercaps = gst_caps_make_writable(othercaps);
+  GstStructure* out = gst_caps_get_structure(othercaps, 0);
+  const GstStructure* in = gst_caps_get_structure(caps, 0);
+
+  gint width = 0, height = 0;
+  gst_structure_get_int(in, "width", &width);
+  gst_structure_get_int(in, "height", &height);
+  if (direction == GST_PAD_SINK) {
+    const app_common::RoiRect crop = currentCrop(GST_VISION_CONVERT(trans));
+    if (!cropIsEmpty(crop)) {
+      width = crop.width;
+      height = crop.height;
+    }
+  }
+  if (width > 0) gst_structure_fixate_field_nearest_int(out, "width", width);
+  if (height > 0) gst_structure_fixate_field_nearest_int(out, "height", height);
+
+  const gchar* format = gst_structure_get_string(in, "format");
+  if (format) gst_structure_fixate_field_string(out, "format", format);
+
+  othercaps = gst_caps_fixate(othercaps);
+  GST_DEBUG_OBJECT(trans, "fixated to %" GST_PTR_FORMAT, othercaps);
+  return othercaps;
+}
+
+static gboolean gst_vision_convert_set_info(GstVideoFilter* filter, GstCaps*, GstVideoInfo* in_info, GstCaps*,
+                                            GstVideoInfo* out_info) {
+  auto* self = GST_VISION_CONVERT(filter);
+  app_common::PixelFormat in_format{}, out_format{};
+  if (!toPixelFormat(GST_VIDEO_INFO_FORMAT(in_info), in_format) ||
+      !toPixelFormat(GST_VIDEO_INFO_FORMAT(out_info), out_format)) {
+    GST_ERROR_OBJECT(self, "unsupported conversion %s -> %s",
+                     gst_video_format_to_string(GST_VIDEO_INFO_FORMAT(in_info)),
+                     gst_video_format_to_string(GST_VIDEO_INFO_FORMAT(out_info)));
+    return FALSE;
+  }
+
+  self->matrix = in_info->colorimetry.matrix == GST_VIDEO_COLOR_MATRIX_BT709 ? app_common::YuvMatrix::Bt709
+                                                                           : app_common::YuvMatrix::Bt601;
+  const gboolean passthrough = in_format == out_format &&
+                               GST_VIDEO_INFO_WIDTH(in_info) == GST_VIDEO_INFO_WIDTH(out_info) &&
+                               GST_VIDEO_INFO_HEIGHT(in_info) == GST_VIDEO_INFO_HEIGHT(out_info) &&
+                               cropIsEmpty(currentCrop(self));
+  gst_base_transform_set_passthrough(GST_BASE_TRANSFORM(filter), passthrough);
+
+  GST_INFO_OBJECT(self, "%s %dx%d -> %s %dx%d%s, %s", gst_video_format_to_string(GST_VIDEO_INFO_FORMAT(in_info)),
+                  GST_VIDEO_INFO_WIDTH(in_info), GST_VIDEO_INFO_HEIGHT(in_info),
+                  gst_video_format_to_string(GST_VIDEO_INFO_FORMAT(out_info)), GST_VIDEO_INFO_WIDTH(out_info),
+                  GST_VIDEO_INFO_HEIGHT(out_info), passthrough ? " (passthrough)" : "",
+                  app_common::simdLevelName(self->converter->level()));
+  return TRUE;
+}
+
+static GstFlowReturn gst_vision_convert_transform_frame(GstVideoFilter* filter, GstVideoFrame* in_frame,
+                                                        GstVideoFrame* out_frame) {
+  auto* self = GST_VISION_CONVERT(filter);
+  app_common::ImageView src, dst;
+  if (!toImageView(in_frame, src) || !toImageView(out_frame, dst) ||
+      !self->converter->convert(src, dst, currentCrop(self), self->matrix)) {
+    GST_ELEMENT_ERROR(self, CORE, NOT_IMPLEMENTED, (nullptr), ("conversion failed"));
+    return GST_FLOW_ERROR;
+  }
+  return GST_FLOW_OK;
+}
+
+static void gst_vision_convert_set_property(GObject* object, guint prop_id, const GValue* value, GParamSpec* pspec) {
+  auto* self = GST_VISION_CONVERT(object);
+  switch (prop_id) {
+    case PROP_SRC_CROP: {
+      app_common::RoiRect crop;
+      if (!parseCrop(g_value_get_string(value), crop)) {
+        GST_WARNING_OBJECT(self, "ignoring invalid src-crop \"%s\" (expected left:top:width:height)",
+                           g_value_get_string(value));
+        break;
+      }
+      GST_OBJECT_LOCK(self);
+      self->crop = crop;
+      GST_OBJECT_UNLOCK(self);
+      // crop 크기가 출력 caps 에 반영되도록 다시 협상한다
+      if (!cropIsEmpty(crop)) gst_base_transform_set_passthrough(GST_BASE_TRANSFORM(self), FALSE);
+      gst_base_transform_reconfigure_src(GST_BASE_TRANSFORM(self));
+      break;
+    }
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+      break;
+  }
+}
+
+static void gst_vision_convert_get_property(GObject* object, guint prop_id, GValue* value, GParamSpec* pspec) {
+  auto* self = GST_VISION_CONVERT(object);
+  switch (prop_id) {
+    case PROP_SRC_CROP: {
+      const app_common::RoiRect crop = currentCrop(self);
+      if (cropIsEmpty(crop)) {
+        g_value_set_string(value, "");
+      } else {
+        g_value_take_string(value, g_strdup_printf("%d:%d:%d:%d", crop.x, crop.y, crop.width, crop.height));
+      }
+      break;
+    }
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+      break;
+  }
+}
+
+static void gst_vision_convert_finalize(GObject* object) {
+  delete GST_VISION_CONVERT(object)->converter;
+  G_OBJECT_CLASS(gst_vision_convert_parent_class)->finalize(object);
+}
+
+static void gst_vision_convert_class_init(GstVisionConvertClass* klass) {
+  auto* gobject_class = G_OBJECT_CLASS(klass);
+  auto* element_class = GST_ELEMENT_CLASS(klass);
+  auto* transform_class = GST_BASE_TRANSFORM_CLASS(klass);
+  auto* filter_class = GST_VIDEO_FILTER_CLASS(klass);
+
+  gobject_class->set_property = gst_vision_convert_set_property;
+  gobject_class->get_property = gst_vision_convert_get_property;
+  gobject_class->finalize = gst_vision_convert_finalize;
+
+  g_object_class_install_property(
+      gobject_class, PROP_SRC_CROP,
+      g_param_spec_string("src-crop", "Source crop", "Crop the input to \"left:top:width:height\" (empty = full frame)",
+                          "", static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                                        GST_PARAM_MUTABLE_PLAYING)));
+
+  gst_element_class_set_static_metadata(element_class, "Vision colour convert", "Filter/Converter/Video/Scaler",
+                                        "SIMD NV12/I420 to NV12/I420/RGBA conversion with crop and nearest scaling",
+                                        "vision-backend");
+  gst_element_class_add_static_pad_template(element_class, &sink_template);
+  gst_element_class_add_static_pad_template(element_class, &src_template);
+
+  transform_class->transform_caps = GST_DEBUG_FUNCPTR(gst_vision_convert_transform_caps);
+  transform_class->fixate_caps = GST_DEBUG_FUNCPTR(gst_vision_convert_fixate_caps);
+
+  filter_class->set_info = GST_DEBUG_FUNCPTR(gst_vision_convert_set_info);
+  filter_class->transform_frame = GST_DEBUG_FUNCPTR(gst_vision_convert_transform_frame);
+}
+
+static void gst_vision_convert_init(GstVisionConvert* self) {
+  self->crop = {};
+  self->matrix = app_common::YuvMatrix::Bt601;
+  self->converter = new app_common::YuvConverter();
+}
+
+static gboolean plugin_init(GstPlugin* plugin) {
+  GST_DEBUG_CATEGORY_INIT(vision_convert_debug, "visionconvert", 0, "SIMD colour conversion");
+  return gst_element_register(plugin, "visionconvert", GST_RANK_NONE, gst_vision_convert_get_type());
+}
+
+GST_PLUGIN_DEFINE(GST_VERSION_MAJOR, GST_VERSION_MINOR, visionconvert, "SIMD colour conversion for vision-backend",
+                  plugin_init, VISION_PLUGIN_VERSION, "Proprietary", "vision-backend", "vision-backend")
@@ -0,0 +1,382 @@
+// visionfakeinfer: GPU 없이 nvinfer 자리를 대신하는 GStreamer 요소.
+// 버퍼는 그대로 통과시키고 SyntheticDetector 가 만든 객체를 NvDsBatchMeta 로 붙인다.
+// 업스트림(nvstreammux)이 이미 batch meta 를 붙였다면 그 프레임들에 객체만 더하고,
+// 없으면 batch-size 개의 프레임 meta 를 새로 만들어 streammux 출력처럼 보이게 한다.
+//
+//   gst-launch-1.0 videotestsrc ! video/x-raw,width=320,height=240,framerate=1000/1
+//       ! visionfakeinfer objects-per-frame=50 batch-size=4 ! fakesink
+//   gst-launch-1.0 fakesrc sizetype=fixed sizemax=1 ! visionfakeinfer fps=2000 script-location=objs.txt ! fakesink
+//
+// 플러그인은 GST_PLUGIN_PATH 로 찾게 하거나 lib/gstreamer-1.0 에 설치해서 쓴다.
+
+#include <gst/base/gstbasetransform.h>
+#include <gst/gst.h>
+#include <gstnvdsmeta.h>
+#include <nvdsmeta.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/infer/synthetic_detections.hpp"
+
+GST_DEBUG_CATEGORY_STATIC(vision_fake_infer_debug);
+#define GST_CAT_DEFAULT vision_fake_infer_debug
+
+namespace {
+constexpr guint kDefaultObjectsPerFrame = 10;
+constexpr guint kDefaultNumClasses = 4;
+constexpr guint kMaxBatchSize = 64;
+constexpr guint kDefaultFrameWidth = 1920;
+constexpr guint kDefaultFrameHeight = 1080;
+constexpr gint kUniqueComponentId = 1;
+
+// start() 에서 만들고 stop() 에서 버리는 스트리밍 상태
+struct FakeInferState {
+  std::vector<app_common::SyntheticDetector> detectors;  // pad_index 별 생성기
+  std::unique_ptr<app_common::DetectionFrame> frame{std::make_unique<app_common::DetectionFrame>()};
+  std::chrono::steady_clock::time_point started{};
+  uint64_t buffers{0};
+};
+
+enum {
+  PROP_0,
+  PROP_OBJECTS_PER_FRAME,
+  PROP_NUM_CLASSES,
+  PROP_BATCH_SIZE,
+  PROP_FRAME_WIDTH,
+  PROP_FRAME_HEIGHT,
+  PROP_SEED,
+  PROP_FPS,
+  PROP_SCRIPT_LOCATION,
+};
+}  // namespace
+
+typedef struct _GstVisionFakeInfer {
+  GstBaseTransform parent;
+
+  guint objects_per_frame;
+  guint num_classes;
+  guint batch_size;
+  guint frame_width;
+  guint frame_height;
+  guint64 seed;
+  gdouble fps;  // 0 이면 업스트림 속도 그대로
+  gchar* script_location;
+
+  FakeInferState* state;
+} GstVisionFakeInfer;
+
+typedef struct _GstVisionFakeInferClass {
+  GstBaseTransformClass parent_class;
+} GstVisionFakeInferClass;
+
+GType gst_vision_fake_infer_get_type(void);
+G_DEFINE_TYPE(GstVisionFakeInfer, gst_vision_fake_infer, GST_TYPE_BASE_TRANSFORM)
+
+#define GST_VISION_FAKE_INFER(obj) (reinterpret_cast<GstVisionFakeInfer*>(obj))
+
+static GstStaticPadTemplate sink_template =
+    GST_STATIC_PAD_TEMPLATE("sink", GST_PAD_SINK, GST_PAD_ALWAYS, GST_STATIC_CAPS_ANY);
+static GstStaticPadTemplate src_template =
+    GST_STATIC_PAD_TEMPLATE("src", GST_PAD_SRC, GST_PAD_ALWAYS, GST_STATIC_CAPS_ANY);
+
+namespace {
+
+bool loadScript(GstVisionFakeInfer* self, app_common::SyntheticConfig& config) {
+  if (!self->script_location || !*self->script_location) return true;
+
+  gchar* contents = nullptr;
+  gsize length = 0;
+  GError* error = nullptr;
+  if (!g_file_get_contents(self->script_location, &contents, &length, &error)) {
+    GST_ELEMENT_ERROR(self, RESOURCE, READ, ("Could not read script \"%s\"", self->script_location),
+                      ("%s", error->message));
+    g_error_free(error);
+    return false;
+  }
+
+  std::string parse_error;
+  const bool ok = app_common::parseSyntheticScript(std::string_view(contents, length), config.script, parse_error);
+  g_free(contents);
+  if (!ok) {
+    GST_ELEMENT_ERROR(self, RESOURCE, SETTINGS, ("Invalid script \"%s\"", self->script_location),
+                      ("%s", parse_error.c_str()));
+  }
+  return ok;
+}
+
+// fps 가 정해져 있으면 첫 버퍼 기준으로 n / fps 시점까지 기다린다
+void pace(GstVisionFakeInfer* self, FakeInferState& state, uint64_t index) {
+  if (self->fps <= 0.0) return;
+  const auto now = std::chrono::steady_clock::now();
+  if (index == 0) {
+    state.started = now;
+    return;
+  }
+  const auto target =
+      state.started + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                          std::chrono::duration<double>(static_cast<double>(index) / self->fps));
+  if (target > now) std::this_thread::sleep_until(target);
+}
+
+void attachObjects(FakeInferState& state, app_common::SyntheticDetector& detector, NvDsBatchMeta* batch_meta,
+                   NvDsFrameMeta* frame_meta) {
+  auto& frame = *state.frame;
+  detector.next(frame);
+  // 거꾸로 넣어야 앞에 붙이는 구현에서 생성 순서가 유지된다 (순서는 계약이 아니다)
+  for (uint32_t i = frame.num_objects; i-- > 0;) {
+    const auto& det = frame.objects[i];
+    NvDsObjectMeta* obj_meta = nvds_acquire_obj_meta_from_pool(batch_meta);
+    obj_meta->unique_component_id = kUniqueComponentId;
+    obj_meta->class_id = det.class_id;
+    obj_meta->object_id = UNTRACKED_OBJECT_ID;
+    obj_meta->confidence = det.confidence;
+    obj_meta->rect_params.left = det.x;
+    obj_meta->rect_params.top = det.y;
+    obj_meta->rect_params.width = det.w;
+    obj_meta->rect_params.height = det.h;
+    g_strlcpy(obj_meta->obj_label, det.label, MAX_LABEL_SIZE);
+    nvds_add_obj_meta_to_frame(frame_meta, obj_meta, nullptr);
+  }
+  frame_meta->bInferDone = TRUE;
+}
+
+}  // namespace
+
+static gboolean gst_vision_fake_infer_start(GstBaseTransform* trans) {
+  auto* self = GST_VISION_FAKE_INFER(trans);
+
+  app_common::SyntheticConfig config;
+  config.objects_per_frame = self->objects_per_frame;
+  config.num_classes = self->num_classes;
+  config.frame_width = static_cast<float>(self->frame_width);
+  config.frame_height = static_cast<float>(self->frame_height);
+  if (!loadScript(self, config)) return FALSE;
+
+  auto state = std::make_unique<FakeInferState>();
+  state->detectors.reserve(self->batch_size);
+  for (guint i = 0; i < self->batch_size; ++i) {
+    config.seed = self->seed + i;  // source 마다 다른 장면
+    state->detectors.emplace_back(config);
+  }
+
+  delete self->state;
+  self->state = state.release();
+  GST_INFO_OBJECT(self, "%s mode, %u objects/frame, batch %u, fps %.1f",
+                  config.script.empty() ? "random" : "script", self->objects_per_frame, self->batch_size, self->fps);
+  return TRUE;
+}
+
+static gboolean gst_vision_fake_infer_stop(GstBaseTransform* trans) {
+  auto* self = GST_VISION_FAKE_INFER(trans);
+  delete self->state;
+  self->state = nullptr;
+  return TRUE;
+}
+
+static GstFlowReturn gst_vision_fake_infer_transform_ip(GstBaseTransform* trans, GstBuffer* buf) {
+  auto* self = GST_VISION_FAKE_INFER(trans);
+  auto& state = *self->state;
+  const uint64_t index = state.buffers++;
+  pace(self, state, index);
+
+  NvDsBatchMeta* batch_meta = gst_buffer_get_nvds_batch_meta(buf);
+  if (batch_meta) {
+    for (NvDsMetaList* l = batch_meta->frame_meta_list; l != nullptr; l = l->next) {
+      auto* frame_meta = static_cast<NvDsFrameMeta*>(l->data);
+      attachObjects(state, state.detectors[frame_meta->pad_index % state.detectors.size()], batch_meta, frame_meta);
+    }
+    return GST_FLOW_OK;
+  }
+
+  guint64 pts = index;
+  if (GST_BUFFER_PTS_IS_VALID(buf)) {
+    pts = GST_BUFFER_PTS(buf);
+  } else if (self->fps > 0.0) {
+    pts = static_cast<guint64>(static_cast<double>(index) * GST_SECOND / self->fps);
+  }
+
+  const guint batch_size = static_cast<guint>(state.detectors.size());
+  batch_meta = nvds_create_batch_meta(batch_size);
+  NvDsMeta* meta =
+      gst_buffer_add_nvds_meta(buf, batch_meta, nullptr, nvds_batch_meta_copy_func, nvds_batch_meta_release_func);
+  meta->meta_type = NVDS_BATCH_GST_META;
+  batch_meta->base_meta.batch_meta = batch_meta;
+  batch_meta->base_meta.copy_func = nvds_batch_meta_copy_func;
+  batch_meta->base_meta.release_func = nvds_batch_meta_release_func;
+  batch_meta->max_frames_in_batch = batch_size;
+
+  for (guint i = 0; i < batch_size; ++i) {
+    NvDsFrameMeta* frame_meta = nvds_acquire_frame_meta_from_pool(batch_meta);
+    frame_meta->pad_index = i;
+    frame_meta->batch_id = i;
+    frame_meta->source_id = i;
+    frame_meta->frame_num = static_cast<gint>(index);
+    frame_meta->buf_pts = pts;
+    frame_meta->ntp_timestamp = 0;
+    frame_meta->source_frame_width = self->frame_width;
+    frame_meta->source_frame_height = self->frame_height;
+    attachObjects(state, state.detectors[i], batch_meta, frame_meta);
+    nvds_add_frame_meta_to_batch(batch_meta, frame_meta);
+  }
+  return GST_FLOW_OK;
+}
+
+static void gst_vision_fake_infer_set_property(GObject* object, guint prop_id, const GValue* value,
+                                               GParamSpec* pspec) {
+  auto* self = GST_VISION_FAKE_INFER(object);
+  switch (prop_id) {
+    case PROP_OBJECTS_PER_FRAME:
+      self->objects_per_frame = g_value_get_uint(value);
+      break;
+    case PROP_NUM_CLASSES:
+      self->num_classes = g_value_get_uint(value);
+      break;
+    case PROP_BATCH_SIZE:
+      self->batch_size = g_value_get_uint(value);
+      break;
+    case PROP_FRAME_WIDTH:
+      self->frame_width = g_value_get_uint(value);
+      break;
+    case PROP_FRAME_HEIGHT:
+      self->frame_height = g_value_get_uint(value);
+      break;
+    case PROP_SEED:
+      self->seed = g_value_get_uint64(value);
+      break;
+    case PROP_FPS:
+      self->fps = g_value_get_double(value);
+      break;
+    case PROP_SCRIPT_LOCATION:
+      g_free(self->script_location);
+      self->script_location = g_value_dup_string(value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+      break;
+  }
+}
+
+static void gst_vision_fake_infer_get_property(GObject* object, guint prop_id, GValue* value, GParamSpec* pspec) {
+  auto* self = GST_VISION_FAKE_INFER(object);
+  switch (prop_id) {
+    case PROP_OBJECTS_PER_FRAME:
+      g_value_set_uint(value, self->objects_per_frame);
+      break;
+    case PROP_NUM_CLASSES:
+      g_value_set_uint(value, self->num_classes);
+      break;
+    case PROP_BATCH_SIZE:
+      g_value_set_uint(value, self->batch_size);
+      break;
+    case PROP_FRAME_WIDTH:
+      g_value_set_uint(value, self->frame_width);
+      break;
+    case PROP_FRAME_HEIGHT:
+      g_value_set_uint(value, self->frame_height);
+      break;
+    case PROP_SEED:
+      g_value_set_uint64(value, self->seed);
+      break;
+    case PROP_FPS:
+      g_value_set_double(value, self->fps);
+      break;
+    case PROP_SCRIPT_LOCATION:
+      g_value_set_string(value, self->script_location);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+      break;
+  }
+}
+
+static void gst_vision_fake_infer_finalize(GObject* object) {
+  auto* self = GST_VISION_FAKE_INFER(object);
+  delete self->state;
+  g_free(self->script_location);
+  G_OBJECT_CLASS(gst_vision_fake_infer_parent_class)->finalize(object);
+}
+
+static void gst_vision_fake_infer_class_init(GstVisionFakeInferClass* klass) {
+  auto* gobject_class = G_OBJECT_CLASS(klass);
+  auto* element_class = GST_ELEMENT_CLASS(klass);
+  auto* transform_class = GST_BASE_TRANSFORM_CLASS(klass);
+
+  gobject_class->set_property = gst_vision_fake_infer_set_property;
+  gobject_class->get_property = gst_vision_fake_infer_get_property;
+  gobject_class->finalize = gst_vision_fake_infer_finalize;
+
+  // 생성기는 start() 에서 만들어지므로 설정은 READY 이하에서만 바꿀 수 있다
+  const auto flags = static_cast<GParamFlags>(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GST_PARAM_MUTABLE_READY);
+  g_object_class_install_property(
+      gobject_class, PROP_OBJECTS_PER_FRAME,
+      g_param_spec_uint("objects-per-frame", "Objects per frame", "Objects generated per frame in random mode", 0,
+                        static_cast<guint>(app_common::kMaxDetectionsPerFrame), kDefaultObjectsPerFrame, flags));
+  g_object_class_install_property(
+      gobject_class, PROP_NUM_CLASSES,
+      g_param_spec_uint("num-classes", "Number of classes", "Class ids are drawn from [0, num-classes)", 1, G_MAXINT,
+                        kDefaultNumClasses, flags));
+  g_object_class_install_property(
+      gobject_class, PROP_BATCH_SIZE,
+      g_param_spec_uint("batch-size", "Batch size",
+                        "Frame metas per buffer when upstream attached none (one per simulated source)", 1,
+                        kMaxBatchSize, 1, flags));
+  g_object_class_install_property(
+      gobject_class, PROP_FRAME_WIDTH,
+      g_param_spec_uint("frame-width", "Frame width", "Width of the coordinate space boxes are placed in", 1,
+                        G_MAXINT, kDefaultFrameWidth, flags));
+  g_object_class_install_property(
+      gobject_class, PROP_FRAME_HEIGHT,
+      g_param_spec_uint("frame-height", "Frame height", "Height of the coordinate space boxes are placed in", 1,
+                        G_MAXINT, kDefaultFrameHeight, flags));
+  g_object_class_install_property(
+      gobject_class, PROP_SEED,
+      g_param_spec_uint64("seed", "Seed", "Random generator seed (source i uses seed + i)", 0, G_MAXUINT64, 1, flags));
+  g_object_class_install_property(
+      gobject_class, PROP_FPS,
+      g_param_spec_double("fps", "Frames per second", "Pace output to this rate (0 = as fast as upstream)", 0.0,
+                          G_MAXDOUBLE, 0.0, flags));
+  g_object_class_install_property(
+      gobject_class, PROP_SCRIPT_LOCATION,
+      g_param_spec_string("script-location", "Script location",
+                          "Detection script (one frame per line, \"class:conf:x:y:w:h;...\"); overrides random mode",
+                          nullptr, flags));
+
+  gst_element_class_set_static_metadata(element_class, "Vision synthetic inference", "Filter/Analyzer/Video",
+                                        "Attaches synthetic NvDsBatchMeta detections for GPU-free testing",
+                                        "vision-backend");
+  gst_element_class_add_static_pad_template(element_class, &sink_template);
+  gst_element_class_add_static_pad_template(element_class, &src_template);
+
+  transform_class->start = GST_DEBUG_FUNCPTR(gst_vision_fake_infer_start);
+  transform_class->stop = GST_DEBUG_FUNCPTR(gst_vision_fake_infer_stop);
+  transform_class->transform_ip = GST_DEBUG_FUNCPTR(gst_vision_fake_infer_transform_ip);
+}
+
+static void gst_vision_fake_infer_init(GstVisionFakeInfer* self) {
+  self->objects_per_frame = kDefaultObjectsPerFrame;
+  self->num_classes = kDefaultNumClasses;
+  self->batch_size = 1;
+  self->frame_width = kDefaultFrameWidth;
+  self->frame_height = kDefaultFrameHeight;
+  self->seed = 1;
+  self->fps = 0.0;
+  self->script_location = nullptr;
+  self->state = nullptr;
+
+  // 메타만 붙이므로 버퍼 내용은 건드리지 않는다
+  gst_base_transform_set_in_place(GST_BASE_TRANSFORM(self), TRUE);
+  gst_base_transform_set_passthrough(GST_BASE_TRANSFORM(self), FALSE);
+}
+
+static gboolean plugin_init(GstPlugin* plugin) {
+  GST_DEBUG_CATEGORY_INIT(vision_fake_infer_debug, "visionfakeinfer", 0, "Synthetic inference meta");
+  return gst_element_register(plugin, "visionfakeinfer", GST_RANK_NONE, gst_vision_fake_infer_get_type());
+}
+
+GST_PLUGIN_DEFINE(GST_VERSION_MAJOR, GST_VERSION_MINOR, visionfakeinfer, "Synthetic inference meta for vision-backend",
+                  plugin_init, VISION_PLUGIN_VERSION, "Proprietary", "vision-backend", "vision-backend")
@@ -18,7 +18,7 @@ public:
 
 private:
   std::string buildDeviceListJson();
-  void publishScanResult(const std::string& json_list);
+  void publishScanResult();
 
   std::unique_ptr<sdbus::IConnection> bus_;
   std::unique_ptr<sdbus::IProxy> om_proxy_;
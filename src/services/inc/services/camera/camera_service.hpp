@@ -3,11 +3,42 @@
 #include <gst/gst.h>
 
 #include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
-class CameraService {
+#include "common/infer/roi.hpp"
+#include "common/utils/json.hpp"
+#include "common/zmq/pub_socket.hpp"
+#include "services/config/live_property_target.hpp"
+
+class ActivityController;
+class DeadlineFilter;
+class MotionGate;
+class PadMetaTagger;
+class PipelineTracer;
+class QueueMonitor;
+class RoiCropper;
+class SourceBranch;
+class SourceSupervisor;
+
+class CameraService : public LivePropertyTarget {
 public:
-  CameraService();
+  // Frames: nvinfer 뒤에서 RGBA 로 변환해 appsink 로 전달
+  // MetadataOnly: 변환 없이 nvinfer 출력을 바로 appsink 로 연결 (배치 메타만 사용)
+  enum class InferenceSinkMode { Frames, MetadataOnly };
+  // streammux pad 번호 -> 그 입력의 검출을 전체 프레임 좌표로 옮기는 변환
+  using RoiListener = std::function<void(const std::vector<app_common::RoiTransform>& by_pad)>;
+
+  // source_uris 가 비어 있으면 config 의 kCameraSources 를 쓴다. 입력 i 는 streammux sink_i 로 들어가고
+  // 검출 결과의 source_id 가 된다. 입력이 없거나 kMaxCameraSources 를 넘으면 std::runtime_error.
+  explicit CameraService(PubSocket& pub_socket, InferenceSinkMode sink_mode = InferenceSinkMode::Frames,
+                         std::vector<std::string> source_uris = {});
   ~CameraService();
 
   void start();
@@ -15,47 +46,85 @@ public:
   void switchToCamera();
   void switchToTest();
   GstElement* getInferenceAppsink() { return inference_appsink_; }
+  InferenceSinkMode getInferenceSinkMode() const { return sink_mode_; }
+  uint32_t getSourceCount() const { return static_cast<uint32_t>(source_uris_.size()); }
+
+  // 구간별 지연/fps 측정. 끄면 pad probe 를 모두 떼어낸다.
+  void setTracingEnabled(bool enabled);
+  bool isTracingEnabled() const;
+  // 측정한 drop 률에 따라 q2 깊이와 streammux batched-push-timeout 을 조정한다.
+  void setAdaptiveTuning(bool enabled);
+  bool isAdaptiveTuning() const;
+  // appsink 에서 소비자가 꺼낸 sample 수와 꺼낸 뒤 버린 프레임 수. appsink drop 집계에 쓰인다.
+  void setConsumerCounters(std::function<uint64_t()> pulled, std::function<uint64_t()> dropped);
+  // 이보다 오래된 프레임은 추론 전에 버리고, appsink 도 이만큼 늦은 buffer 는 버리며 QoS 를 보낸다. 0 이면 끔.
+  void setInferenceDeadline(int32_t deadline_ms);
+  int32_t getInferenceDeadline() const;
+  // 추론 결과의 객체 수. 한동안 객체가 없으면 추론 fps 를 낮추고, 보이면 바로 되돌린다.
+  void onDetections(uint32_t num_objects);
+  void setActivityControl(bool enabled);
+  bool isActivityControl() const;
+  // 정적인 프레임은 추론에 보내지 않고 listener 에 PTS 만 알린다. threshold 가 0 이하이면 기존 값을 유지한다.
+  void setMotionGate(bool enabled, double threshold = 0.0);
+  bool isMotionGate() const;
+  double getMotionThreshold() const;
+  void setStaticFrameListener(std::function<void(uint64_t pts)> listener);
+  // 전체 프레임과 함께 추론할 관심 영역. 실패하면 error 를 채우고 기존 ROI 는 그대로 둔다.
+  bool setInferenceRois(const std::vector<app_common::RoiRect>& rois, std::string& error);
+  std::vector<app_common::RoiRect> getInferenceRois() const;
+  // 설정 즉시 현재 변환표로 한 번 호출되고, 이후 ROI 가 바뀔 때마다 호출된다.
+  void setRoiListener(RoiListener listener);
+  app_common::Json getStats() const;
+  // 실행 중 바꿔도 되는 속성(queue 깊이 / leaky, streammux batched-push-timeout, appsink max-buffers, front_caps caps)을
+  // 요소의 pad 가 쉬는 순간 바꾸고 적용될 때까지 기다린다. 목록에 없거나 값이 잘못되었거나 시간 안에 적용되지 않으면
+  // error 를 채우고 false. 적응형 튜닝이 켜져 있으면 q2 깊이는 다시 조정될 수 있다.
+  bool setLiveProperty(const std::string& element, const std::string& property, const std::string& value,
+                       std::string& error) override;
+  // 적용하지 않고 setLiveProperty 가 받아들일 값인지만 본다. caps 는 앞 요소가 낼 수 있는 caps 와 겹쳐야 한다.
+  bool checkLiveProperty(const std::string& element, const std::string& property, const std::string& value,
+                         std::string& error) const override;
 
 private:
   GstElement* buildPipeline();
-  bool createElements();
+  // 요소와 연결은 kCameraPipelineFile (없으면 기본 파이프라인) 을 따르고, 여기서는 이름으로 찾아 쓴다
+  std::map<std::string, std::string> pipelineVariables() const;
+  bool bindElements();
   void configureElements();
-  bool linkElements();
+  bool buildExtraSources();
+  void setupSupervisor(PubSocket& pub_socket);
   void installPadProbe();
+  void setupRois();
+  void notifyRoiListener();
 
   void busWatchFunction();
 
-  static void onPadAdded(GstElement* src, GstPad* new_pad, gpointer user_data);
   static gboolean onAutoplugContinue(GstElement* bin, GstPad* pad, GstCaps* caps, gpointer user_data);
-  void linkUridecodebinPad(GstPad* new_pad);
 
+  InferenceSinkMode sink_mode_;
+  std::vector<std::string> source_uris_;
+  std::vector<std::unique_ptr<SourceBranch>> extra_sources_;
+  std::unique_ptr<PipelineTracer> tracer_;
+  std::unique_ptr<QueueMonitor> queue_monitor_;
+  std::unique_ptr<DeadlineFilter> deadline_filter_;
+  std::unique_ptr<ActivityController> activity_controller_;
+  std::unique_ptr<MotionGate> motion_gate_;
+  std::unique_ptr<RoiCropper> roi_cropper_;
+  std::unique_ptr<PadMetaTagger> pad_meta_tagger_;  // DeepStream 없는 프로파일에서만
+  std::unique_ptr<SourceSupervisor> supervisor_;
+  std::mutex roi_listener_mutex_;
+  RoiListener roi_listener_;
   GstElement* pipeline_{nullptr};
-  GstElement* camera_src_{nullptr};
-  GstElement* camera_caps_nvmm_{nullptr};
-  GstElement* camera_conv_{nullptr};
-  GstElement* camera_caps_scaled_{nullptr};
   GstElement* uri_src_{nullptr};
   GstElement* uri_queue_{nullptr};
-  GstElement* uri_conv_{nullptr};
-  GstElement* uri_caps_scaled_{nullptr};
-  GstElement* uri_conv2_{nullptr};
-  GstElement* uri_caps_scaled2_{nullptr};
-  GstElement* audio_fakesink_{nullptr};
   GstElement* src_selector_{nullptr};
   GstElement* tee_{nullptr};
   GstElement* front_queue_{nullptr};
-  GstElement* front_conv_{nullptr};
-  GstElement* front_caps_{nullptr};
-  GstElement* uri_videorate_{nullptr};
-  GstElement* uri_caps_framerate_{nullptr};
   GstElement* front_shm_{nullptr};
   GstElement* inference_queue_{nullptr};
-  GstElement* inference_conv_{nullptr};
-  GstElement* inference_caps_nvmm_{nullptr};
+  GstElement* inference_caps_framerate_{nullptr};
+  GstElement* inference_tee_{nullptr};
   GstElement* inference_streammux_{nullptr};
   GstElement* inference_nvinfer_{nullptr};
-  GstElement* inference_conv3_{nullptr};
-  GstElement* inference_caps_sys_{nullptr};
   GstElement* inference_appsink_{nullptr};
 
   GstBus* bus_{nullptr};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/pipeline/runtime_config.hpp"
+#include "common/utils/file_watcher.hpp"
+#include "common/utils/json.hpp"
+#include "services/config/live_property_target.hpp"
+
+// 재시작 없이 바꾸는 설정. 실행 중 설정 파일을 지켜보다가 바뀌면 다시 적용하고, 제어 명령으로 하나씩 바꿀 수도 있다.
+// "log.<logger>" 는 로그 레벨, 나머지 "<요소>.<속성>" 은 LivePropertyTarget(CameraService)::setLiveProperty 로 간다.
+// 파일은 모든 항목을 먼저 검사해 하나라도 잘못되었으면 아무것도 적용하지 않는다.
+// 결과: {"ok": 모두 성공, "results": [{"key": "q2.leaky", "value": "upstream", "ok": true, "msg": "..."}]}
+class ConfigService {
+public:
+  ConfigService(LivePropertyTarget& camera, std::string path);
+  ~ConfigService();
+
+  // 파일이 있으면 바로 한 번 적용하고 감시를 시작한다.
+  void start();
+  void stop();
+
+  app_common::Json set(const std::string& key, const std::string& value);
+  app_common::Json reload();
+  const std::string& path() const { return watcher_.path(); }
+
+private:
+  app_common::Json applyText(const std::string& text);
+  app_common::Json apply(const std::vector<app_common::RuntimeSetting>& settings);
+  bool check(const app_common::RuntimeSetting& setting, std::string& error) const;
+
+  LivePropertyTarget& camera_;
+  std::mutex apply_mutex_;  // 감시 스레드와 제어 명령이 함께 부른다
+  app_common::FileWatcher watcher_;
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+
+// 실행 중 요소 속성을 바꿀 수 있는 대상. ConfigService 는 이 인터페이스로만 파이프라인을 건드린다.
+class LivePropertyTarget {
+public:
+  virtual ~LivePropertyTarget() = default;
+  // 적용하지 않고 받아들일 값인지만 본다. 아니면 error 를 채우고 false.
+  virtual bool checkLiveProperty(const std::string& element, const std::string& property, const std::string& value,
+                                 std::string& error) const = 0;
+  virtual bool setLiveProperty(const std::string& element, const std::string& property, const std::string& value,
+                               std::string& error) = 0;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/utils/json.hpp"
+
+enum class ArgType { String, Int, Number, Bool };
+
+struct ArgSpec {
+  std::string name;
+  ArgType type{ArgType::String};
+  bool required{true};
+};
+
+// 명령 이름 -> (인자 스키마, 실행 방식, 핸들러) 해시 테이블.
+// 스키마 자체의 검사(중복/빈 이름, 중복 명령)는 등록 시 한 번만 하고, 요청마다 인자만 확인한다.
+class CommandRegistry {
+public:
+  using Handler = std::function<void(const app_common::Json& args, app_common::Json& reply)>;
+
+  struct Command {
+    std::string name;
+    std::vector<ArgSpec> args;
+    bool async{false};  // 오래 걸릴 수 있어 작업 스레드에서 실행한다
+    Handler handler;
+    std::size_t owner{0};
+  };
+
+  // 이후 add() 되는 명령의 소유자(서비스 lane 번호)
+  void setOwner(std::size_t owner) { owner_ = owner; }
+
+  // 잘못된 스키마나 중복 이름이면 std::invalid_argument
+  void add(const std::string& name, std::initializer_list<ArgSpec> args, bool async, Handler handler);
+
+  const Command* find(const std::string& name) const;
+
+  // args 가 스키마에 맞지 않으면 false 와 함께 error 에 이유를 채운다.
+  static bool validate(const Command& command, const app_common::Json& args, std::string& error);
+
+  // "NAME" / "NAME:value" 형식의 예전 명령. value 는 첫 번째 인자로 변환한다.
+  bool parseLegacy(const std::string& text, const Command*& command, app_common::Json& args, std::string& error) const;
+
+private:
+  std::unordered_map<std::string, Command> commands_;
+  std::size_t owner_{0};
+};
@@ -1,24 +1,56 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
-#include "common/zmq/rep_socket.hpp"
+#include "common/utils/json.hpp"
+#include "common/utils/serial_worker.hpp"
+#include "common/zmq/pub_socket.hpp"
+#include "common/zmq/router_socket.hpp"
 #include "services/audio/audio_service.hpp"
 #include "services/bluetooth/bluetooth_service.hpp"
 #include "services/camera/camera_service.hpp"
+#include "services/config/config_service.hpp"
+#include "services/control/command_registry.hpp"
+#include "services/infer/ai_service.hpp"
 #include "services/music/music_service.hpp"
 
+// 제어 명령을 ROUTER 소켓으로 받아 서비스별 작업 스레드(lane)로 나눠 실행한다.
+// 요청은 {"cmd": ..., "args": {...}} 또는 {"batch": [...]} JSON 이며, 예전 "NAME[:value]" 문자열도 받는다.
+// 빠른 명령은 바로 실행해 응답하고, 오래 걸리는 명령(isAsync)이나 해당 서비스가 이미 작업 중인 명령은
+// job id 로 먼저 응답한 뒤 완료 결과를 "job" 토픽으로 발행한다.
+// 같은 서비스의 명령은 순서대로, 서로 다른 서비스의 명령은 병렬로 실행된다.
 class ControlService {
 public:
-  ControlService(RepSocket& rep_socket);
+  ControlService(RouterSocket& router_socket, PubSocket& pub_socket);
+  ~ControlService();
 
   void registerMusicService(MusicService& service);
   void registerCameraService(CameraService& service);
   void registerBluetoothService(BluetoothService& service);
   void registerAudioService(AudioService& service);
+  void registerAiService(AiService& service);
+  void registerEventBus(PubSocket& pub_socket);
+  void registerConfigService(ConfigService& service);
   void poll();
 
 private:
-  std::vector<class IService*> services_;
-  RepSocket& rep_socket_;
+  struct Lane;
+
+  void addService(std::unique_ptr<class IService> service);
+  void dispatch(RouterSocket::Request& request);
+  app_common::Json runCall(const app_common::Json& call);
+  app_common::Json run(const CommandRegistry::Command& command, app_common::Json args);
+  app_common::Json submit(Lane& lane, const CommandRegistry::Command& command, app_common::Json args);
+  static void execute(const CommandRegistry::Command& command, const app_common::Json& args, app_common::Json& reply);
+
+  std::vector<std::unique_ptr<Lane>> lanes_;
+  CommandRegistry registry_;
+  RouterSocket& router_socket_;
+  PubSocket& pub_socket_;
+  PubSocket::TopicId topic_job_;
+  std::atomic<uint64_t> next_job_id_{0};
 };
@@ -4,29 +4,172 @@
 #include <gst/gst.h>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
+#include "common/infer/detection.hpp"
+#include "common/infer/detection_wire_encoder.hpp"
+#include "common/infer/post_filter.hpp"
+#include "common/infer/roi.hpp"
+#include "common/infer/tracker.hpp"
+#include "common/utils/source_lanes.hpp"
+#include "common/utils/spsc_ring.hpp"
 #include "common/zmq/pub_socket.hpp"
+#include "services/camera/camera_service.hpp"
+
+struct _NvDsBatchMeta;
+typedef struct _NvDsBatchMeta NvDsBatchMeta;
 
 class AiService {
 public:
-  AiService(GstElement* appsink_elem, PubSocket& pub_socket);
+  static constexpr std::size_t kDefaultQueueCapacity = 8;
+  // 후처리 graph 에서 동시에 처리 중일 수 있는 최대 프레임 수 (모든 source 합계)
+  static constexpr std::size_t kMaxInFlightFrames = 16;
+  // 주 입력(source 0)의 추론 결과 프레임마다 객체 수와 함께 호출된다 (appsink 스트리밍 스레드)
+  using ActivityListener = std::function<void(uint32_t num_objects)>;
+  // 움직임이 없어 추론을 건너뛴 프레임의 처리 방식.
+  // Republish: 마지막 검출 결과를 그 프레임의 timestamp 로 다시 발행 (frame_number 는 그대로)
+  // Suppress: 아무것도 발행하지 않음
+  enum class StaticFramePolicy { Republish, Suppress };
+  // Full: 프레임마다 det 로 전체 목록 (추적 중이면 track_id 포함)
+  // Delta: det 대신 trk 로 확정 track 의 born / moved / died 만 보낸다 (추적이 켜져 있어야 함)
+  enum class OutputMode { Full, Delta };
+
+  AiService(GstElement* appsink_elem, PubSocket& pub_socket, CameraService::InferenceSinkMode sink_mode,
+            app_common::OverflowPolicy overflow_policy = app_common::OverflowPolicy::DropOldest,
+            std::size_t queue_capacity = kDefaultQueueCapacity);
   ~AiService();
 
   void start();
   void stop();
+  // 파이프라인이 돌기 전에 설정해야 한다.
+  void setActivityListener(ActivityListener listener) { activity_listener_ = std::move(listener); }
+  void setStaticFramePolicy(StaticFramePolicy policy) { static_policy_.store(policy); }
+  StaticFramePolicy getStaticFramePolicy() const { return static_policy_.load(); }
+  // 추론을 건너뛴 프레임의 PTS. 스트리밍 스레드에서 호출되며 소비자 스레드를 깨우기만 한다.
+  void onStaticFrame(uint64_t timestamp);
+  // streammux pad 번호별 좌표 변환. 표에 없는 pad 의 프레임은 버린다. (CameraService::RoiListener)
+  void setRoiTransforms(const std::vector<app_common::RoiTransform>& by_pad);
+  // 후처리 graph 가 다음 프레임부터 반영한다. 추적을 끄면 track 들은 버려진다.
+  void setTracking(bool enabled, OutputMode mode);
+  bool isTracking() const { return tracking_.load(); }
+  OutputMode getOutputMode() const { return output_mode_.load(); }
+  // 검출 후처리 필터. 후처리 graph 의 각 source 가 다음 프레임부터 새 설정으로 바꾼다.
+  void setPostFilter(const app_common::PostFilterConfig& config);
+  app_common::PostFilterConfig getPostFilter() const;
+  uint64_t filteredObjects() const { return filtered_objects_.load(); }
+
+  // appsink 에서 꺼낸 sample 수
+  uint64_t pulledSamples() const { return pulled_samples_.load(std::memory_order_relaxed); }
+  uint64_t droppedOldest() const { return queue_.droppedOldest(); }
+  uint64_t droppedNewest() const { return queue_.droppedNewest(); }
+  uint64_t dropped() const { return queue_.dropped(); }
 
   AiService(const AiService&) = delete;
   AiService& operator=(const AiService&) = delete;
 
 private:
+  // 후처리 graph 를 지나가는 프레임 하나. 단계마다 필요한 필드를 채워 다음 단계로 넘긴다.
+  struct FrameJob {
+    app_common::DetectionFrame frame;
+    bool republish{false};  // 정적 프레임: 마지막 결과를 frame.timestamp 로 다시 보낸다
+    // filter 단계의 결정
+    bool send_json{false};
+    bool send_wire{false};
+    bool send_tracks{false};
+    bool track_sync{false};
+    app_common::TrackDelta delta;
+    std::unique_ptr<app_common::DetectionFrame> sync_frame;  // track_sync 일 때 살아 있는 확정 track
+    // 직렬화 결과 (wire / labels 는 publish 단계에서 채운다). 발행할 때 PubSocket 의 빈 버퍼와 맞바꿔 용량을 지킨다
+    std::string json;
+    std::string wire;
+    std::string labels;
+    std::string tracks;
+  };
+
+  // source 별 상태. 각 필드는 표시된 단계에서만 쓴다 (단계는 source 별로 직렬 실행).
+  struct SourceState {
+    // filter
+    app_common::PostFilter post_filter;
+    uint64_t filter_generation{0};
+    app_common::Tracker tracker;
+    uint64_t tracker_generation{0};
+    uint64_t track_subscription_version{0};  // trk 새 구독자에게 sync 를 보냈는지 판단용
+    std::chrono::steady_clock::time_point last_json_sent{};
+    std::chrono::steady_clock::time_point last_wire_sent{};
+    std::unique_ptr<app_common::DetectionFrame> last_frame;  // 주 입력의 마지막 결과 (정적 프레임 재전송용)
+    bool has_last_frame{false};
+    // serialize
+    std::size_t json_reserve{0};
+    // publish 가 쓰고 filter 가 읽는다: trk delta 가 PubSocket 큐에서 버려져 다음 프레임에 sync 를 보내야 함
+    std::atomic<bool> track_resync{false};
+  };
+
   static GstFlowReturn onNewSample(GstAppSink* sink, gpointer user_data);
+  bool pushBatch(NvDsBatchMeta* batch_meta);
+  void reportActivity(NvDsBatchMeta* batch_meta);
   void run();
   void attach(GstElement* appsink_elem);
   void detach();
+  // 후처리 단계 (SourceLanes). false 면 이후 단계를 건너뛴다.
+  bool filterStage(uint32_t source_id, FrameJob& job);
+  bool serializeStage(uint32_t source_id, FrameJob& job);
+  bool publishStage(uint32_t source_id, FrameJob& job);
+  bool publishBuffer(PubSocket::TopicId topic, std::string& buffer);
+  void publishWire(FrameJob& job);
+  bool restoreLastFrame(SourceState& source, FrameJob& job);
+  void applyPostFilter(SourceState& source, FrameJob& job);
+  void trackFrame(SourceState& source, FrameJob& job);
+  bool hasDetectionSubscribers() const;
+  bool shouldPublish(PubSocket::TopicId topic, std::chrono::steady_clock::time_point& last_sent);
+  void wakeConsumer();
 
   std::atomic<bool> running_{false};
   std::thread processing_thread_;
   GstAppSink* sink_{nullptr};
+  std::atomic<uint64_t> pulled_samples_{0};
   PubSocket& pub_socket_;
+  CameraService::InferenceSinkMode sink_mode_;
+  ActivityListener activity_listener_;
+  std::mutex roi_mutex_;
+  std::vector<app_common::RoiTransform> roi_transforms_{app_common::RoiTransform{}};
+
+  // extract: 스트리밍 스레드가 메타를 복사해 넣고, 소비자 스레드가 꺼내 source 별 lane 으로 보낸다
+  app_common::SpscRing<app_common::DetectionFrame> queue_;
+  std::atomic<StaticFramePolicy> static_policy_{StaticFramePolicy::Republish};
+  std::atomic<uint64_t> pending_static_frames_{0};
+  std::atomic<uint64_t> static_timestamp_{0};
+
+  std::vector<SourceState> sources_;
+  // 라벨 테이블은 모든 source 가 공유하므로 publish 단계에서 잠그고 쓴다 (publishWire)
+  std::mutex wire_mutex_;
+  app_common::wire::DetectionWireEncoder wire_encoder_;
+  uint32_t frames_since_labels_{0};
+  uint64_t label_subscription_version_{0};
+  PubSocket::TopicId topic_detections_;
+  PubSocket::TopicId topic_detections_binary_;
+  PubSocket::TopicId topic_detection_labels_;
+  PubSocket::TopicId topic_tracks_;
+
+  std::atomic<bool> tracking_;
+  std::atomic<OutputMode> output_mode_;
+  std::atomic<uint64_t> tracker_generation_{1};  // 바뀌면 각 source 의 filter 단계가 추적기를 새로 만든다
+  mutable std::mutex filter_mutex_;
+  app_common::PostFilterConfig filter_config_;
+  std::atomic<uint64_t> filter_generation_{1};
+  std::atomic<uint64_t> filtered_objects_{0};
+
+  std::mutex wait_mutex_;
+  std::condition_variable wait_cv_;
+  std::atomic<bool> consumer_waiting_{false};
+
+  // filter -> serialize -> publish. source_id 별로 순서를 지키며 source 끼리는 동시에 돈다.
+  // 단계가 위 멤버들을 쓰므로 가장 먼저 소멸해야 한다.
+  app_common::SourceLanes<FrameJob> lanes_;
 };
@@ -2,26 +2,15 @@
 
 AudioServiceAdapter::AudioServiceAdapter(AudioService& service) : service_(service) {}
 
-bool AudioServiceAdapter::handle(const std::string& command, app_common::Json& reply) {
-  if (command == "AUDIO_VOL_UP") {
-    return true;
-  }
+void AudioServiceAdapter::registerCommands(CommandRegistry& registry) {
+  registry.add("AUDIO_VOL_UP", {}, false, [](const app_common::Json&, app_common::Json&) {});
+  registry.add("AUDIO_VOL_DOWN", {}, false, [](const app_common::Json&, app_common::Json&) {});
 
-  if (command == "AUDIO_VOL_DOWN") {
-    return true;
-  }
+  registry.add("AUDIO_VOL_SET", {{"level", ArgType::Int}}, false,
+               [this](const app_common::Json& args, app_common::Json& reply) {
+                 service_.setVolume(args["level"].get<int>());
 
-  if (command.rfind("AUDIO_VOL_SET", 0) == 0) {
-    auto pos = command.find(':');
-    if (pos != std::string::npos) {
-      int level = std::stoi(command.substr(pos + 1));
-      service_.setVolume(level);
-
-      auto volume = service_.getVolume();
-      reply = {{"ok", true}, {"msg", "volume set"}, {"volume", volume.has_value() ? volume.value() : -1}};
-      return true;
-    }
-  }
-
-  return false;
+                 auto volume = service_.getVolume();
+                 reply = {{"ok", true}, {"msg", "volume set"}, {"volume", volume.has_value() ? volume.value() : -1}};
+               });
 }
@@ -1,14 +1,13 @@
 #pragma once
 
 #include "adapters/i_service.hpp"
-#include "common/utils/json.hpp"
 #include "services/audio/audio_service.hpp"
 
 class AudioServiceAdapter : public IService {
 public:
   explicit AudioServiceAdapter(AudioService& service);
 
-  bool handle(const std::string& command, app_common::Json& reply) override;
+  void registerCommands(CommandRegistry& registry) override;
 
 private:
   AudioService& service_;
@@ -2,31 +2,27 @@
 
 BluetoothServiceAdapter::BluetoothServiceAdapter(BluetoothService& service) : service_(service) {}
 
-bool BluetoothServiceAdapter::handle(const std::string& command, app_common::Json& reply) {
-  if (command == "BT_ON") {
+void BluetoothServiceAdapter::registerCommands(CommandRegistry& registry) {
+  // D-Bus 호출은 응답이 올 때까지 블록되므로 모두 작업 스레드에서 실행한다
+  registry.add("BT_ON", {}, true, [this](const app_common::Json&, app_common::Json& reply) {
     service_.powerOn();
     reply = {{"ok", true}, {"msg", "bluetooth on"}};
-    return true;
-  }
+  });
 
-  if (command == "BT_OFF") {
+  registry.add("BT_OFF", {}, true, [this](const app_common::Json&, app_common::Json& reply) {
     service_.powerOff();
     reply = {{"ok", true}, {"msg", "bluetooth off"}};
-    return true;
-  }
+  });
 
-  if (command == "BT_SCAN") {
+  registry.add("BT_SCAN", {}, true, [this](const app_common::Json&, app_common::Json& reply) {
     service_.scan();
     reply = {{"ok", true}, {"msg", "bluetooth scanning"}};
-    return true;
-  }
+  });
 
-  if (command.rfind("BT_CONNECT:", 0) == 0) {
-    auto device = command.substr(std::string("BT_CONNECT:").size());
-    service_.connect(device);
-    reply = {{"ok", true}, {"msg", "bluetooth connecting"}, {"device", device}};
-    return true;
-  }
-
-  return false;
+  registry.add("BT_CONNECT", {{"device", ArgType::String}}, true,
+               [this](const app_common::Json& args, app_common::Json& reply) {
+                 const auto device = args["device"].get<std::string>();
+                 service_.connect(device);
+                 reply = {{"ok", true}, {"msg", "bluetooth connecting"}, {"device", device}};
+               });
 }
@@ -1,31 +1,78 @@
 #include "adapters/camera/camera_service_adapter.hpp"
 
+#include <string>
+#include <vector>
+
+#include "common/infer/roi.hpp"
+
 CameraServiceAdapter::CameraServiceAdapter(CameraService& service) : service_(service) {}
 
-bool CameraServiceAdapter::handle(const std::string& command, app_common::Json& reply) {
-  if (command == "CAMERA_START") {
+void CameraServiceAdapter::registerCommands(CommandRegistry& registry) {
+  registry.add("CAMERA_START", {}, true, [this](const app_common::Json&, app_common::Json& reply) {
     service_.start();
     reply = {{"ok", true}, {"msg", "camera started"}};
-    return true;
-  }
+  });
 
-  if (command == "CAMERA_STOP") {
+  registry.add("CAMERA_STOP", {}, true, [this](const app_common::Json&, app_common::Json& reply) {
     service_.stop();
     reply = {{"ok", true}, {"msg", "camera stopped"}};
-    return true;
-  }
+  });
 
-  if (command == "SWITCH_TO_CAMERA") {
+  registry.add("SWITCH_TO_CAMERA", {}, true, [this](const app_common::Json&, app_common::Json& reply) {
     service_.switchToCamera();
     reply = {{"ok", true}, {"msg", "switched to camera"}};
-    return true;
-  }
+  });
 
-  if (command == "SWITCH_TO_TEST") {
+  registry.add("SWITCH_TO_TEST", {}, true, [this](const app_common::Json&, app_common::Json& reply) {
     service_.switchToTest();
     reply = {{"ok", true}, {"msg", "switched to test"}};
-    return true;
-  }
+  });
+
+  registry.add("CAMERA_STATS", {}, false, [this](const app_common::Json&, app_common::Json& reply) {
+    reply = {{"ok", true}, {"stats", service_.getStats()}};
+  });
+
+  registry.add("CAMERA_TRACE", {{"enabled", ArgType::Bool}}, false,
+               [this](const app_common::Json& args, app_common::Json& reply) {
+                 service_.setTracingEnabled(args["enabled"].get<bool>());
+                 reply = {{"ok", true}, {"msg", "camera tracing"}, {"enabled", service_.isTracingEnabled()}};
+               });
+
+  registry.add("CAMERA_TUNE", {{"enabled", ArgType::Bool}}, false,
+               [this](const app_common::Json& args, app_common::Json& reply) {
+                 service_.setAdaptiveTuning(args["enabled"].get<bool>());
+                 reply = {{"ok", true}, {"msg", "camera queue tuning"}, {"enabled", service_.isAdaptiveTuning()}};
+               });
+
+  registry.add("CAMERA_DEADLINE", {{"ms", ArgType::Int}}, false,
+               [this](const app_common::Json& args, app_common::Json& reply) {
+                 service_.setInferenceDeadline(args["ms"].get<int32_t>());
+                 reply = {{"ok", true}, {"msg", "inference deadline"}, {"ms", service_.getInferenceDeadline()}};
+               });
+
+  registry.add("CAMERA_ACTIVITY", {{"enabled", ArgType::Bool}}, false,
+               [this](const app_common::Json& args, app_common::Json& reply) {
+                 service_.setActivityControl(args["enabled"].get<bool>());
+                 reply = {{"ok", true}, {"msg", "camera activity control"}, {"enabled", service_.isActivityControl()}};
+               });
+
+  registry.add("CAMERA_MOTION", {{"enabled", ArgType::Bool}, {"threshold", ArgType::Number, false}}, false,
+               [this](const app_common::Json& args, app_common::Json& reply) {
+                 service_.setMotionGate(args["enabled"].get<bool>(), args.value("threshold", 0.0));
+                 reply = {{"ok", true},
+                          {"msg", "camera motion gate"},
+                          {"enabled", service_.isMotionGate()},
+                          {"threshold", service_.getMotionThreshold()}};
+               });
 
-  return false;
+  registry.add("CAMERA_SET_ROI", {{"rois", ArgType::String}}, false,
+               [this](const app_common::Json& args, app_common::Json& reply) {
+                 std::vector<app_common::RoiRect> rois;
+                 std::string error;
+                 const bool ok = app_common::parseRois(args["rois"].get<std::string>(), rois, error) &&
+                                 service_.setInferenceRois(rois, error);
+                 reply = {{"ok", ok},
+                          {"msg", ok ? "inference rois" : error},
+                          {"rois", app_common::formatRois(service_.getInferenceRois())}};
+               });
 }
@@ -0,0 +1,15 @@
+#include "adapters/config/config_service_adapter.hpp"
+
+#include <string>
+
+ConfigServiceAdapter::ConfigServiceAdapter(ConfigService& service) : service_(service) {}
+
+void ConfigServiceAdapter::registerCommands(CommandRegistry& registry) {
+  registry.add("CONFIG_SET", {{"key", ArgType::String}, {"value", ArgType::String}}, true,
+               [this](const app_common::Json& args, app_common::Json& reply) {
+                 reply = service_.set(args["key"].get<std::string>(), args["value"].get<std::string>());
+               });
+
+  registry.add("CONFIG_RELOAD", {}, true,
+               [this](const app_common::Json&, app_common::Json& reply) { reply = service_.reload(); });
+}
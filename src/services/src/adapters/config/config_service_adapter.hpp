@@ -0,0 +1,18 @@
+#pragma once
+
+#include "adapters/i_service.hpp"
+#include "services/config/config_service.hpp"
+
+// 실행 중 설정 명령.
+//   CONFIG_SET {"key": "q2.max-size-buffers", "value": "3"} : 하나를 바꾼다 ("log.service" 는 로그 레벨)
+//   CONFIG_RELOAD                                           : 설정 파일을 다시 읽어 적용한다
+// buffer 사이에 적용될 때까지 기다리므로 작업 스레드에서 실행하고 결과는 job 토픽으로 알린다.
+class ConfigServiceAdapter : public IService {
+public:
+  explicit ConfigServiceAdapter(ConfigService& service);
+
+  void registerCommands(CommandRegistry& registry) override;
+
+private:
+  ConfigService& service_;
+};
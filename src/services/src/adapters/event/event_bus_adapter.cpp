@@ -0,0 +1,17 @@
+#include "adapters/event/event_bus_adapter.hpp"
+
+EventBusAdapter::EventBusAdapter(PubSocket& pub_socket) : pub_socket_(pub_socket) {}
+
+void EventBusAdapter::registerCommands(CommandRegistry& registry) {
+  registry.add("EVENT_SNAPSHOT", {{"topic", ArgType::String, false}}, false,
+               [this](const app_common::Json& args, app_common::Json& reply) {
+                 app_common::Json topics = app_common::Json::array();
+                 for (auto& cached : pub_socket_.snapshot(args.value("topic", std::string()))) {
+                   // 상태 토픽은 JSON 이므로 문자열로 감싸지 않고 그대로 넣는다
+                   auto payload = app_common::Json::parse(cached.payload, nullptr, false);
+                   if (payload.is_discarded()) payload = cached.payload;
+                   topics.push_back({{"topic", cached.topic}, {"seq", cached.seq}, {"payload", std::move(payload)}});
+                 }
+                 reply = {{"ok", true}, {"topics", std::move(topics)}};
+               });
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "adapters/i_service.hpp"
+#include "common/zmq/pub_socket.hpp"
+
+// 늦게 접속한 구독자가 상태 토픽의 마지막 값을 한 번에 받아 가기 위한 명령.
+//   EVENT_SNAPSHOT                     : 캐시된 모든 토픽
+//   EVENT_SNAPSHOT {"topic": "<topic>"} : 해당 토픽 (prefix 매칭)
+class EventBusAdapter : public IService {
+public:
+  explicit EventBusAdapter(PubSocket& pub_socket);
+
+  void registerCommands(CommandRegistry& registry) override;
+
+private:
+  PubSocket& pub_socket_;
+};
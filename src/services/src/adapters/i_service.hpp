@@ -1,11 +1,10 @@
 #pragma once
 
-#include <string>
-
-#include "common/utils/json.hpp"
+#include "services/control/command_registry.hpp"
 
 class IService {
 public:
-  virtual bool handle(const std::string& command, app_common::Json& reply) = 0;
+  // 이 서비스가 처리하는 명령과 인자 스키마를 등록한다.
+  virtual void registerCommands(CommandRegistry& registry) = 0;
   virtual ~IService() = default;
 };
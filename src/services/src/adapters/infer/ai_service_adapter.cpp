@@ -0,0 +1,53 @@
+#include "adapters/infer/ai_service_adapter.hpp"
+
+AiServiceAdapter::AiServiceAdapter(AiService& service) : service_(service) {}
+
+void AiServiceAdapter::registerCommands(CommandRegistry& registry) {
+  registry.add("AI_TRACKING", {{"enabled", ArgType::Bool}, {"delta", ArgType::Bool, false}}, false,
+               [this](const app_common::Json& args, app_common::Json& reply) {
+                 const bool delta = args.value("delta", false);
+                 service_.setTracking(args["enabled"].get<bool>(),
+                                      delta ? AiService::OutputMode::Delta : AiService::OutputMode::Full);
+                 reply = {{"ok", true},
+                          {"msg", "ai tracking"},
+                          {"enabled", service_.isTracking()},
+                          {"delta", service_.getOutputMode() == AiService::OutputMode::Delta}};
+               });
+
+  // 주지 않은 항목은 현재 값을 유지한다
+  registry.add("AI_FILTER",
+               {{"min_confidence", ArgType::Number, false},
+                {"class_confidence", ArgType::String, false},
+                {"classes", ArgType::String, false},
+                {"min_area", ArgType::Number, false},
+                {"nms_iou", ArgType::Number, false}},
+               false, [this](const app_common::Json& args, app_common::Json& reply) {
+                 app_common::PostFilterConfig config = service_.getPostFilter();
+                 config.min_confidence = args.value("min_confidence", config.min_confidence);
+                 config.min_area = args.value("min_area", config.min_area);
+                 config.nms_iou = args.value("nms_iou", config.nms_iou);
+
+                 std::string error;
+                 bool ok = true;
+                 if (args.contains("class_confidence")) {
+                   ok = app_common::parseClassThresholds(args["class_confidence"].get<std::string>(),
+                                                         config.class_confidence, error);
+                 }
+                 if (ok && args.contains("classes")) {
+                   ok = app_common::parseClassList(args["classes"].get<std::string>(), config.allowed_classes, error);
+                 }
+                 // 잘못된 값이 하나라도 있으면 아무것도 바꾸지 않는다
+                 if (ok) ok = app_common::validatePostFilter(config, error);
+                 if (ok) service_.setPostFilter(config);
+
+                 const app_common::PostFilterConfig current = service_.getPostFilter();
+                 reply = {{"ok", ok},
+                          {"msg", ok ? "ai post filter" : error},
+                          {"min_confidence", current.min_confidence},
+                          {"class_confidence", app_common::formatClassThresholds(current.class_confidence)},
+                          {"classes", app_common::formatClassList(current.allowed_classes)},
+                          {"min_area", current.min_area},
+                          {"nms_iou", current.nms_iou},
+                          {"filtered", service_.filteredObjects()}};
+               });
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "adapters/i_service.hpp"
+#include "services/infer/ai_service.hpp"
+
+class AiServiceAdapter : public IService {
+public:
+  explicit AiServiceAdapter(AiService& service);
+
+  void registerCommands(CommandRegistry& registry) override;
+
+private:
+  AiService& service_;
+};
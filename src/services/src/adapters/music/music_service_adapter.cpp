@@ -2,36 +2,30 @@
 
 MusicServiceAdapter::MusicServiceAdapter(MusicService& service) : service_(service) {}
 
-bool MusicServiceAdapter::handle(const std::string& command, app_common::Json& reply) {
-  if (command == "MUSIC_PLAY") {
+void MusicServiceAdapter::registerCommands(CommandRegistry& registry) {
+  // 파이프라인 상태 전환은 버스 메시지를 기다리며 블록될 수 있다
+  registry.add("MUSIC_PLAY", {}, true, [this](const app_common::Json&, app_common::Json& reply) {
     service_.play();
     reply = {{"ok", true}, {"msg", "music play"}};
-    return true;
-  }
+  });
 
-  if (command == "MUSIC_STOP") {
+  registry.add("MUSIC_STOP", {}, true, [this](const app_common::Json&, app_common::Json& reply) {
     service_.stop();
     reply = {{"ok", true}, {"msg", "music stop"}};
-    return true;
-  }
+  });
 
-  if (command == "MUSIC_PAUSE") {
+  registry.add("MUSIC_PAUSE", {}, false, [this](const app_common::Json&, app_common::Json& reply) {
     service_.pause();
     reply = {{"ok", true}, {"msg", "music pause"}};
-    return true;
-  }
+  });
 
-  if (command == "MUSIC_NEXT") {
+  registry.add("MUSIC_NEXT", {}, true, [this](const app_common::Json&, app_common::Json& reply) {
     service_.next();
     reply = {{"ok", true}, {"msg", "music next"}};
-    return true;
-  }
+  });
 
-  if (command == "MUSIC_PREV") {
+  registry.add("MUSIC_PREV", {}, true, [this](const app_common::Json&, app_common::Json& reply) {
     service_.prev();
     reply = {{"ok", true}, {"msg", "music prev"}};
-    return true;
-  }
-
-  return false;
+  });
 }
@@ -61,7 +61,7 @@ void BluetoothService::scan() {
           if (!addr.empty()) {
             devices_[addr] = name;
             SPDLOG_SERVICE_INFO("Added device: {} ({})", addr, name);
-            publishScanResult(buildDeviceListJson());
+            publishScanResult();
           }
         }
       });
@@ -83,7 +83,7 @@ void BluetoothService::scan() {
           }
         }
 
-        publishScanResult(buildDeviceListJson());
+        publishScanResult();
       });
 
   om_proxy_->finishRegistration();
@@ -117,6 +117,7 @@ std::string BluetoothService::buildDeviceListJson() {
   return json.dump();
 }
 
-void BluetoothService::publishScanResult(const std::string& json_list) {
-  pub_socket_.publish(std::string(app_config::kTopicBluetooth), json_list);
+void BluetoothService::publishScanResult() {
+  if (!pub_socket_.wantsPublish(app_config::kTopicBluetooth)) return;
+  pub_socket_.publish(app_config::kTopicBluetooth, buildDeviceListJson());
 }
@@ -0,0 +1,54 @@
+#include "impl/camera/activity_controller.hpp"
+
+#include <string>
+
+#include "common/utils/logging.hpp"
+
+ActivityController::ActivityController(GstElement* capsfilter, int idle_fps, std::chrono::milliseconds idle_after)
+    : capsfilter_(GST_ELEMENT(gst_object_ref(capsfilter))),
+      full_caps_(gst_caps_from_string("video/x-raw")),
+      idle_caps_(gst_caps_from_string(("video/x-raw,framerate=" + std::to_string(idle_fps) + "/1").c_str())),
+      idle_after_(idle_after) {
+  last_activity_.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+ActivityController::~ActivityController() {
+  gst_caps_unref(full_caps_);
+  gst_caps_unref(idle_caps_);
+  gst_object_unref(capsfilter_);
+}
+
+void ActivityController::onFrame(uint32_t num_objects) {
+  if (!enabled_.load(std::memory_order_relaxed)) return;
+
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  if (num_objects > 0) {
+    last_activity_.store(now.count(), std::memory_order_relaxed);
+    if (idle_.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      applyLocked(false);
+    }
+    return;
+  }
+
+  if (idle_.load(std::memory_order_relaxed)) return;
+  const auto last = std::chrono::steady_clock::duration(last_activity_.load(std::memory_order_relaxed));
+  if (now - last >= idle_after_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (enabled_.load(std::memory_order_relaxed)) applyLocked(true);
+  }
+}
+
+void ActivityController::setEnabled(bool enabled) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  enabled_.store(enabled, std::memory_order_relaxed);
+  last_activity_.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+  if (!enabled) applyLocked(false);
+}
+
+void ActivityController::applyLocked(bool idle) {
+  if (idle_.load(std::memory_order_relaxed) == idle) return;
+  g_object_set(capsfilter_, "caps", idle ? idle_caps_ : full_caps_, nullptr);
+  idle_.store(idle, std::memory_order_relaxed);
+  SPDLOG_SERVICE_INFO("[Camera] inference rate -> {}", idle ? "idle" : "full");
+}
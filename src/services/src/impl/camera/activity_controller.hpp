@@ -0,0 +1,41 @@
+#pragma once
+
+#include <gst/gst.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+// 검출 결과에 따라 추론 분기(tee 뒤)의 videorate 뒤 capsfilter 를 바꿔 추론 fps 를 조절한다. 미리보기 fps 는 그대로다.
+// 객체가 idle_after 동안 보이지 않으면 idle_fps 로 낮추고, 객체가 보이면 바로 원래 속도로 되돌린다.
+// caps 만 바꾸므로 파이프라인을 다시 시작하지 않는다 (videorate 가 재협상 후 프레임을 버린다).
+class ActivityController {
+public:
+  ActivityController(GstElement* capsfilter, int idle_fps, std::chrono::milliseconds idle_after);
+  ~ActivityController();
+
+  // 추론 결과마다 호출된다 (appsink 스트리밍 스레드).
+  void onFrame(uint32_t num_objects);
+
+  // 끄면 항상 원래 속도로 둔다.
+  void setEnabled(bool enabled);
+  bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+  bool isIdle() const { return idle_.load(std::memory_order_relaxed); }
+
+  ActivityController(const ActivityController&) = delete;
+  ActivityController& operator=(const ActivityController&) = delete;
+
+private:
+  void applyLocked(bool idle);
+
+  GstElement* capsfilter_;
+  GstCaps* full_caps_;
+  GstCaps* idle_caps_;
+  const std::chrono::steady_clock::duration idle_after_;
+
+  std::mutex mutex_;
+  std::atomic<bool> enabled_{false};
+  std::atomic<bool> idle_{false};
+  std::atomic<std::chrono::steady_clock::rep> last_activity_{0};
+};
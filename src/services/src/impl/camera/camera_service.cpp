@@ -1,11 +1,20 @@
 #include "services/camera/camera_service.hpp"
 
-#include <gstnvdsmeta.h>
-#include <nvbufsurface.h>
-#include <nvdsmeta.h>
 #include <spdlog/spdlog.h>
 
 #include "common/utils/logging.hpp"
+#include "config/camera_config.hpp"
+#include "impl/camera/activity_controller.hpp"
+#include "impl/camera/deadline_filter.hpp"
+#include "impl/camera/live_property.hpp"
+#include "impl/camera/motion_gate.hpp"
+#include "impl/camera/pad_meta_tagger.hpp"
+#include "impl/camera/pipeline_builder.hpp"
+#include "impl/camera/pipeline_tracer.hpp"
+#include "impl/camera/queue_monitor.hpp"
+#include "impl/camera/roi_cropper.hpp"
+#include "impl/camera/source_branch.hpp"
+#include "impl/camera/source_supervisor.hpp"
 
 #define CHECK_ELEM(e, name)                                    \
   if (!(e)) {                                                  \
@@ -13,15 +22,122 @@
     return NULL;                                               \
   }
 
-CameraService::CameraService() {
+namespace {
+constexpr bool kTracingEnabledByDefault = true;
+
+GstPadProbeReturn dropQosEvent(GstPad* /*pad*/, GstPadProbeInfo* info, gpointer /*user_data*/) {
+  GstEvent* event = GST_PAD_PROBE_INFO_EVENT(info);
+  if (event && GST_EVENT_TYPE(event) == GST_EVENT_QOS) return GST_PAD_PROBE_DROP;
+  return GST_PAD_PROBE_OK;
+}
+
+gint compareLinkedTo(gconstpointer item, gconstpointer downstream) {
+  GstPad* peer = gst_pad_get_peer(GST_PAD(g_value_get_object(static_cast<const GValue*>(item))));
+  if (!peer) return 1;
+  const bool linked = GST_OBJECT_PARENT(peer) == downstream;
+  gst_object_unref(peer);
+  return linked ? 0 : 1;
+}
+
+// element 의 src pad 중 downstream 으로 연결된 pad. tee 의 request pad 처럼 이름이 정해져 있지 않은 pad 를 찾는다.
+GstPad* srcPadLinkedTo(GstElement* element, GstElement* downstream) {
+  GstIterator* it = gst_element_iterate_src_pads(element);
+  GValue found = G_VALUE_INIT;
+  GstPad* pad = nullptr;
+  if (gst_iterator_find_custom(it, &compareLinkedTo, &found, downstream)) {
+    pad = GST_PAD(g_value_dup_object(&found));
+    g_value_unset(&found);
+  }
+  gst_iterator_free(it);
+  return pad;
+}
+
+// 실행 중에 바꿔도 협상이나 연결을 깨지 않는 속성
+struct LiveProperty {
+  const char* element;
+  const char* property;
+};
+constexpr LiveProperty kLiveProperties[] = {
+    {"front_queue", "max-size-buffers"},
+    {"front_queue", "leaky"},
+    {"q2", "max-size-buffers"},
+    {"q2", "leaky"},
+    {"streammux", "batched-push-timeout"},  // nvstreammux 에만 있다
+    {"inference_appsink", "max-buffers"},
+    {"front_caps", "caps"},
+};
+
+bool isLiveProperty(const std::string& element, const std::string& property) {
+  for (const auto& live : kLiveProperties) {
+    if (element == live.element && property == live.property) return true;
+  }
+  return false;
+}
+
+// capsfilter 에 새 caps 를 걸기 전에, 앞 요소(front_caps 면 front_conv)의 src pad 가 낼 수 있는 caps 와 겹치는지 본다.
+// 겹치지 않는 caps 를 걸면 다음 buffer 에서 not-negotiated 로 파이프라인이 멈춘다.
+bool upstreamCanProduce(GstElement* capsfilter, const GValue* value, std::string& error) {
+  const GstCaps* caps = gst_value_get_caps(value);
+  GstPad* sink = gst_element_get_static_pad(capsfilter, "sink");
+  GstPad* peer = sink ? gst_pad_get_peer(sink) : nullptr;
+  if (sink) gst_object_unref(sink);
+  if (!peer) {
+    error = std::string(GST_ELEMENT_NAME(capsfilter)) + ".caps: element is not linked upstream";
+    return false;
+  }
+
+  GstCaps* possible = gst_pad_query_caps(peer, nullptr);
+  const bool ok = caps && possible && gst_caps_can_intersect(possible, caps);
+  if (!ok) {
+    gchar* possible_str = possible ? gst_caps_to_string(possible) : nullptr;
+    GstObject* upstream = GST_OBJECT_PARENT(peer);
+    error = std::string(GST_ELEMENT_NAME(capsfilter)) + ".caps: " +
+            (upstream ? GST_OBJECT_NAME(upstream) : "upstream") + " cannot produce these caps (supports " +
+            (possible_str ? possible_str : "nothing") + ")";
+    g_free(possible_str);
+  }
+  if (possible) gst_caps_unref(possible);
+  gst_object_unref(peer);
+  return ok;
+}
+
+gint64 maxLatenessFor(int32_t deadline_ms) { return deadline_ms > 0 ? deadline_ms * GST_MSECOND : -1; }
+
+std::vector<std::string> sourcesOrDefault(std::vector<std::string> uris) {
+  if (uris.empty()) uris.assign(std::begin(app_config::kCameraSources), std::end(app_config::kCameraSources));
+  if (uris.empty() || uris.size() > app_config::kMaxCameraSources) {
+    throw std::runtime_error("CameraService needs 1.." + std::to_string(app_config::kMaxCameraSources) + " sources");
+  }
+  return uris;
+}
+}  // namespace
+
+CameraService::CameraService(PubSocket& pub_socket, InferenceSinkMode sink_mode, std::vector<std::string> source_uris)
+    : sink_mode_(sink_mode),
+      source_uris_(sourcesOrDefault(std::move(source_uris))),
+      tracer_(std::make_unique<PipelineTracer>(pub_socket)),
+      queue_monitor_(std::make_unique<QueueMonitor>(
+          pub_socket, QueueMonitor::Bounds{app_config::kInferenceQueueDepthMin, app_config::kInferenceQueueDepthMax,
+                                           app_config::kBatchedPushTimeoutUsMin, app_config::kBatchedPushTimeoutUsMax,
+                                           app_config::kTargetDropRate})) {
   pipeline_ = buildPipeline();
   if (!pipeline_) throw std::runtime_error("buildPipeline failed");
+  setupSupervisor(pub_socket);
   bus_ = gst_element_get_bus(pipeline_);
   SPDLOG_SERVICE_INFO("[Camera] CameraService init success!");
 }
 
 CameraService::~CameraService() {
   stop();
+  supervisor_.reset();
+  tracer_.reset();
+  queue_monitor_.reset();
+  deadline_filter_.reset();
+  motion_gate_.reset();
+  roi_cropper_.reset();
+  pad_meta_tagger_.reset();
+  extra_sources_.clear();
+  activity_controller_.reset();
   if (bus_) {
     gst_object_unref(bus_);
     bus_ = nullptr;
@@ -33,13 +149,14 @@ CameraService::~CameraService() {
 }
 
 void CameraService::start() {
+  if (is_active_) return;
+  supervisor_->setEnabled(true);
   auto ret = gst_element_set_state(pipeline_, GST_STATE_PLAYING);
   if (ret == GST_STATE_CHANGE_FAILURE) {
     SPDLOG_SERVICE_ERROR("[Camera] Failed to set PLAYING");
-    gst_object_unref(bus_);
-    bus_ = nullptr;
-    gst_object_unref(pipeline_);
-    pipeline_ = nullptr;
+    supervisor_->setEnabled(false);
+    // 파이프라인은 남겨 두어 CAMERA_START 로 다시 시도할 수 있게 한다
+    gst_element_set_state(pipeline_, GST_STATE_NULL);
     return;
   }
 
@@ -52,14 +169,9 @@ void CameraService::stop() {
   if (!is_active_) return;
   is_active_ = false;
 
-  if (bus_thread_.joinable()) {
-    if (bus_thread_.get_id() == std::this_thread::get_id()) {
-      SPDLOG_SERVICE_WARN("[Camera] Detaching bus thread from itself.");
-      bus_thread_.detach();
-    } else {
-      bus_thread_.join();
-    }
-  }
+  // 진행 중인 재시작이 끝난 뒤에 파이프라인을 내린다
+  supervisor_->setEnabled(false);
+  if (bus_thread_.joinable()) bus_thread_.join();
 
   gst_element_set_state(pipeline_, GST_STATE_NULL);
   SPDLOG_SERVICE_INFO("[Camera] Capture stopped");
@@ -92,226 +204,311 @@ void CameraService::switchToTest() {
 }
 
 GstElement* CameraService::buildPipeline() {
-  if (!createElements()) {
-    SPDLOG_SERVICE_ERROR("[Camera] Failed to create GStreamer elements.");
+  app_common::PipelineSpec spec;
+  std::string error;
+  if (!loadCameraPipelineSpec(app_config::kCameraPipelineFile, sink_mode_ == InferenceSinkMode::Frames, spec, error) ||
+      !app_common::expandPipelineSpec(spec, pipelineVariables(), error)) {
+    SPDLOG_SERVICE_ERROR("[Camera] Invalid pipeline description: {}", error);
+    return nullptr;
+  }
+
+  pipeline_ = gst_pipeline_new(spec.name.empty() ? "inference-pipe" : spec.name.c_str());
+  CHECK_ELEM(pipeline_, "pipeline")
+  if (!buildPipelineFromSpec(pipeline_, spec, error)) {
+    SPDLOG_SERVICE_ERROR("[Camera] Failed to build pipeline '{}': {}", spec.name, error);
+    return nullptr;
+  }
+
+  if (!bindElements()) {
+    SPDLOG_SERVICE_ERROR("[Camera] Pipeline description is missing required elements.");
     return nullptr;
   }
 
   configureElements();
 
-  if (!linkElements()) {
+  if (!buildExtraSources()) {
     SPDLOG_SERVICE_ERROR("[Camera] Failed to link GStreamer elements.");
     return nullptr;
   }
 
   installPadProbe();
+  setupRois();
 
   SPDLOG_SERVICE_INFO("[Camera] Pipeline built successfully.");
   return pipeline_;
 }
 
-bool CameraService::createElements() {
-  pipeline_ = gst_pipeline_new("inference-pipe");
-  CHECK_ELEM(pipeline_, "pipeline")
-
-  // 1) camera
-  // camera_src_ = gst_element_factory_make("nvarguscamerasrc", "camera_src");
-  // CHECK_ELEM(camera_src_, "nvarguscamerasrc")
-  // camera_caps_nvmm_ = gst_element_factory_make("capsfilter", "camera_caps_nvmm");
-  // CHECK_ELEM(camera_caps_nvmm_, "camera_caps_nvmm")
-  // camera_conv_ = gst_element_factory_make("nvvideoconvert", "camera_conv");
-  // CHECK_ELEM(camera_conv_, "camera_conv")
-  // camera_caps_scaled_ = gst_element_factory_make("capsfilter", "camera_caps_scaled");
-  // CHECK_ELEM(camera_caps_scaled_, "camera_caps_scaled")
-
-  // 2) uri
-  uri_src_ = gst_element_factory_make("uridecodebin", "uri_src");
-  CHECK_ELEM(uri_src_, "uridecodebin")
-  uri_queue_ = gst_element_factory_make("queue", "uri_queue");
-  CHECK_ELEM(uri_queue_, "uri_queue")
-  uri_conv_ = gst_element_factory_make("nvvideoconvert", "uri_conv");
-  CHECK_ELEM(uri_conv_, "uri_conv")
-  uri_caps_scaled_ = gst_element_factory_make("capsfilter", "uri_caps_scaled");
-  CHECK_ELEM(uri_caps_scaled_, "uri_caps_scaled")
-  uri_videorate_ = gst_element_factory_make("videorate", "front_videorate");
-  CHECK_ELEM(uri_videorate_, "front_videorate")
-  uri_caps_framerate_ = gst_element_factory_make("capsfilter", "front_caps_framerate");
-  CHECK_ELEM(uri_caps_framerate_, "front_caps_framerate")
-  uri_conv2_ = gst_element_factory_make("nvvideoconvert", "uri_conv2");
-  CHECK_ELEM(uri_conv2_, "uri_conv2")
-  uri_caps_scaled2_ = gst_element_factory_make("capsfilter", "uri_caps_scaled2");
-  CHECK_ELEM(uri_caps_scaled2_, "uri_caps_scaled2")
-  audio_fakesink_ = gst_element_factory_make("fakesink", "audio_discard");
-  CHECK_ELEM(audio_fakesink_, "audio_discard")
-
-  // 3) selector
-  src_selector_ = gst_element_factory_make("input-selector", "src_selector");
-  CHECK_ELEM(src_selector_, "input-selector")
-  tee_ = gst_element_factory_make("tee", "tee");
-  CHECK_ELEM(tee_, "tee")
-
-  // 4) shm
-  front_queue_ = gst_element_factory_make("queue", "front_queue");
-  CHECK_ELEM(front_queue_, "front_queue")
-  front_conv_ = gst_element_factory_make("nvvideoconvert", "front_conv");
-  CHECK_ELEM(front_conv_, "front_conv")
-  front_caps_ = gst_element_factory_make("capsfilter", "front_caps");
-  CHECK_ELEM(front_caps_, "front_caps")
-  front_shm_ = gst_element_factory_make("shmsink", "front_shm");
-  CHECK_ELEM(front_shm_, "front_shm")
-
-  // 5) inference
-  inference_queue_ = gst_element_factory_make("queue", "q2");
-  inference_conv_ = gst_element_factory_make("nvvideoconvert", "conv2");
-  inference_caps_nvmm_ = gst_element_factory_make("capsfilter", "caps_nvmm_b2");
-  inference_streammux_ = gst_element_factory_make("nvstreammux", "streammux");
-  inference_nvinfer_ = gst_element_factory_make("nvinfer", "primary_gie");
-  inference_conv3_ = gst_element_factory_make("nvvideoconvert", "conv3");
-  inference_caps_sys_ = gst_element_factory_make("capsfilter", "caps_sys");
-  inference_appsink_ = gst_element_factory_make("appsink", "inference_appsink");
-
-  if (!pipeline_ || !uri_src_ || !uri_queue_ || !uri_conv_ || !uri_caps_scaled_ || !audio_fakesink_ || !src_selector_ ||
-      !tee_ || !front_queue_ || !front_conv_ || !front_caps_ || !uri_videorate_ || !uri_caps_framerate_ ||
-      !front_shm_) {
-    SPDLOG_SERVICE_ERROR("[Camera] Failed to create one or more elements ");
-    return false;
-  }
+std::map<std::string, std::string> CameraService::pipelineVariables() const {
+  return {{"source0_uri", source_uris_.front()},
+          {"mux_batch", std::to_string(getSourceCount())},
+          {"infer_batch", std::to_string(getSourceCount() + app_config::kInferenceMaxRois)},
+          {"max_lateness", std::to_string(maxLatenessFor(app_config::kInferenceDeadlineMs))}};
+}
 
-  SPDLOG_SERVICE_INFO("[Camera] createElements success");
-  return true;
+bool CameraService::bindElements() {
+  // 요소는 pipeline 이 갖고 있으므로 찾은 뒤 ref 는 바로 놓는다
+  auto bind = [this](const char* name, GstElement*& element) {
+    element = gst_bin_get_by_name(GST_BIN(pipeline_), name);
+    if (!element) {
+      SPDLOG_SERVICE_ERROR("[Camera] pipeline has no element named '{}'", name);
+      return false;
+    }
+    gst_object_unref(element);
+    return true;
+  };
+
+  return bind("uri_src", uri_src_) && bind("uri_queue", uri_queue_) && bind("src_selector", src_selector_) &&
+         bind("tee", tee_) && bind("front_queue", front_queue_) && bind("front_shm", front_shm_) &&
+         bind("q2", inference_queue_) && bind("infer_caps_framerate", inference_caps_framerate_) &&
+         bind("infer_tee", inference_tee_) &&
+         bind("streammux", inference_streammux_) && bind("primary_gie", inference_nvinfer_) &&
+         bind("inference_appsink", inference_appsink_);
 }
 
 void CameraService::configureElements() {
-  GstCaps* caps = gst_caps_from_string("video/x-raw(memory:NVMM)");
-  g_object_set(uri_src_, "uri", "https://cdn.pixabay.com/video/2016/02/14/2165-155327596_large.mp4", "caps", caps,
-               nullptr);
-  gst_caps_unref(caps);
-
-  GstCaps* uri_caps_scaled = gst_caps_from_string("video/x-raw,format=NV12,width=1920,height=1080");
-  g_object_set(uri_caps_scaled_, "caps", uri_caps_scaled, nullptr);
-  gst_caps_unref(uri_caps_scaled);
+  g_signal_connect(uri_src_, "autoplug-continue", G_CALLBACK(onAutoplugContinue), nullptr);
 
-  g_object_set(front_queue_, "max-size-buffers", 1, "leaky", 2, nullptr);
+  if (!app_config::kWithDeepStream) {
+    // funnel 은 배치를 만들지 않으므로 입력 pad 마다 1 프레임 batch meta 를 붙인다
+    pad_meta_tagger_ = std::make_unique<PadMetaTagger>(inference_streammux_, app_config::kStreammuxWidth,
+                                                       app_config::kStreammuxHeight);
+  }
+}
 
-  GstCaps* front_caps_scaled = gst_caps_from_string("video/x-raw,format=I420,width=960,height=544");
-  g_object_set(front_caps_, "caps", front_caps_scaled, nullptr);
-  gst_caps_unref(front_caps_scaled);
+static gboolean isAudioCaps(GstCaps* caps) {
+  const GstStructure* s = gst_caps_get_structure(caps, 0);
+  const gchar* name = gst_structure_get_name(s);
+  return g_str_has_prefix(name, "audio/");
+}
 
-  g_object_set(front_shm_, "socket-path", "/tmp/cam.sock", "sync", FALSE, "shm-size", 3145728, "wait-for-connection",
-               FALSE, nullptr);
+gboolean CameraService::onAutoplugContinue(GstElement* bin, GstPad* pad, GstCaps* caps, gpointer user_data) {
+  gchar* caps_str = gst_caps_to_string(caps);
+  g_print("[uridecodebin] new stream on pad '%s': %s\n", GST_PAD_NAME(pad), caps_str);
 
-  SPDLOG_SERVICE_INFO("[Camera] configureElements success");
+  if (isAudioCaps(caps)) {
+    g_print("[decodebin] skip audio stream\n");
+    return FALSE;
+  }
 
-  g_object_set(inference_queue_, "max-size-buffers", 5, "leaky", 1, nullptr);
+  g_free(caps_str);
+  return TRUE;
+}
 
-  GstCaps* caps_b2 = gst_caps_from_string("video/x-raw(memory:NVMM),format=NV12,width=960,height=544");
-  g_object_set(inference_caps_nvmm_, "caps", caps_b2, nullptr);
-  gst_caps_unref(caps_b2);
+void CameraService::installPadProbe() {
+  // pad 의 참조를 넘겨받는다
+  auto add_point = [this](const char* name, GstPad* pad, int prev) {
+    int index = tracer_->addPoint(name, pad, prev);
+    if (pad) gst_object_unref(pad);
+    return index;
+  };
+  auto static_pad = [](GstElement* element, const char* pad_name) {
+    return gst_element_get_static_pad(element, pad_name);
+  };
+
+  // tee 의 src pad 는 request pad 라 요청 순서 대신 연결된 분기(front_queue / q2)로 찾는다
+  const int selector = add_point("src_selector", static_pad(src_selector_, "src"), PipelineTracer::kNoPrev);
+  const int tee_front = add_point("tee.front", srcPadLinkedTo(tee_, front_queue_), selector);
+  add_point("front_shm", static_pad(front_shm_, "sink"), tee_front);
+  const int tee_infer = add_point("tee.inference", srcPadLinkedTo(tee_, inference_queue_), selector);
+  const int streammux = add_point("streammux", static_pad(inference_streammux_, "src"), tee_infer);
+  const int nvinfer = add_point("primary_gie", static_pad(inference_nvinfer_, "src"), streammux);
+  add_point("inference_appsink", static_pad(inference_appsink_, "sink"), nvinfer);
+
+  tracer_->setEnabled(kTracingEnabledByDefault);
+
+  // drop 집계용 카운터는 항상 켜 둔다 (buffer 당 atomic 증가 하나)
+  queue_monitor_->addQueue("front_queue", front_queue_);
+  queue_monitor_->addQueue("q2", inference_queue_);
+  queue_monitor_->addSink("inference_appsink", inference_appsink_);
+  // batched-push-timeout 은 nvstreammux 에만 있다
+  if (app_config::kWithDeepStream) queue_monitor_->setTuningTarget(inference_queue_, inference_streammux_);
+  queue_monitor_->setAdaptiveTuning(app_config::kAdaptiveQueueTuning);
+  queue_monitor_->start();
+
+  // 오래된 프레임은 conv2 / streammux / nvinfer 에 들어가기 전에 버린다
+  deadline_filter_ = std::make_unique<DeadlineFilter>(pipeline_);
+  deadline_filter_->setDeadline(app_config::kInferenceDeadlineMs * GST_MSECOND);
+  GstPad* q2_src = gst_element_get_static_pad(inference_queue_, "src");
+  deadline_filter_->attach(q2_src);
+
+  // deadline 을 통과한 프레임 중 직전 추론 프레임과 거의 같은 것은 streammux 전에 버린다
+  motion_gate_ = std::make_unique<MotionGate>(MotionGate::Config{
+      app_config::kMotionThreshold, app_config::kMotionRowStep, app_config::kMotionStaticFrames,
+      app_config::kMotionMaxSkipFrames});
+  motion_gate_->setEnabled(app_config::kMotionGate);
+  motion_gate_->attach(q2_src);
+  gst_object_unref(q2_src);
+
+  if (!app_config::kPropagateQosPastTee) {
+    GstPad* q2_sink = gst_element_get_static_pad(inference_queue_, "sink");
+    gst_pad_add_probe(q2_sink, GST_PAD_PROBE_TYPE_EVENT_UPSTREAM, dropQosEvent, nullptr, nullptr);
+    gst_object_unref(q2_sink);
+  }
 
-  g_object_set(inference_streammux_, "batch-size", 1, "width", 960, "height", 544, "live-source", TRUE,
-               "batched-push-timeout", 33000, nullptr);
+  const std::chrono::milliseconds idle_after(app_config::kActivityIdleAfterMs);
+  activity_controller_ =
+      std::make_unique<ActivityController>(inference_caps_framerate_, app_config::kActivityIdleFps, idle_after);
+  activity_controller_->setEnabled(app_config::kActivityControl);
+}
 
-  g_object_set(inference_nvinfer_, "config-file-path", "/etc/vision-backend/config_infer_primary.txt", nullptr);
+bool CameraService::buildExtraSources() {
+  for (uint32_t id = 1; id < getSourceCount(); ++id) {
+    auto branch = std::make_unique<SourceBranch>(pipeline_, inference_streammux_, id, source_uris_[id]);
+    if (!branch->build()) return false;
+    extra_sources_.push_back(std::move(branch));
+  }
+  return true;
+}
 
-  GstCaps* caps_sys = gst_caps_from_string("video/x-raw,format=RGBA");
-  g_object_set(inference_caps_sys_, "caps", caps_sys, nullptr);
-  gst_caps_unref(caps_sys);
+void CameraService::setupSupervisor(PubSocket& pub_socket) {
+  supervisor_ = std::make_unique<SourceSupervisor>(pub_socket, pipeline_,
+                                                   std::chrono::milliseconds(app_config::kRestartBackoffInitialMs),
+                                                   std::chrono::milliseconds(app_config::kRestartBackoffMaxMs));
+
+  // 입력이 끊기거나 끝나면 uridecodebin 만 다시 시작하므로 front_shm / appsink 쪽은 그대로 남는다
+  GstPad* uri_queue_sink = gst_element_get_static_pad(uri_queue_, "sink");
+  supervisor_->addSource(0, uri_src_, uri_queue_sink);
+  gst_object_unref(uri_queue_sink);
+  for (const auto& branch : extra_sources_) {
+    GstPad* queue_sink = gst_element_get_static_pad(branch->queue(), "sink");
+    supervisor_->addSource(branch->sourceId(), branch->decoder(), queue_sink);
+    gst_object_unref(queue_sink);
+  }
+}
 
-  g_object_set(inference_appsink_, "emit-signals", true, "max-buffers", 1, "drop", TRUE, nullptr);
+void CameraService::setupRois() {
+  // ROI 는 입력들 뒤의 streammux pad 를 쓴다
+  roi_cropper_ = std::make_unique<RoiCropper>(
+      pipeline_, inference_tee_, inference_streammux_, 0, getSourceCount(), app_config::kInferenceMaxRois,
+      RoiCropper::Geometry{app_config::kInferenceFrameWidth, app_config::kInferenceFrameHeight,
+                           app_config::kStreammuxWidth, app_config::kStreammuxHeight});
+
+  std::vector<app_common::RoiRect> rois;
+  std::string error;
+  if (!app_common::parseRois(app_config::kInferenceRois, rois, error) || !setInferenceRois(rois, error)) {
+    SPDLOG_SERVICE_WARN("[Camera] ignoring configured inference rois: {}", error);
+  }
 }
 
-bool CameraService::linkElements() {
-  gst_bin_add_many(GST_BIN(pipeline_), src_selector_, tee_, uri_src_, uri_queue_, uri_conv_, uri_caps_scaled_,
-                   audio_fakesink_, front_queue_, front_conv_, front_caps_, front_shm_, inference_queue_,
-                   inference_conv_, inference_streammux_, inference_nvinfer_, inference_conv3_, inference_caps_sys_,
-                   inference_appsink_, nullptr);
+void CameraService::setTracingEnabled(bool enabled) { tracer_->setEnabled(enabled); }
 
-  g_signal_connect(G_OBJECT(uri_src_), "pad-added", G_CALLBACK(onPadAdded), this);
-  if (!gst_element_link_many(uri_queue_, uri_conv_, uri_caps_scaled_, nullptr)) {
-    SPDLOG_SERVICE_ERROR("[Camera] Failed to link uri source");
-    return false;
-  }
+bool CameraService::isTracingEnabled() const { return tracer_->isEnabled(); }
 
-  g_signal_connect(uri_src_, "autoplug-continue", G_CALLBACK(onAutoplugContinue), nullptr);
+void CameraService::setAdaptiveTuning(bool enabled) { queue_monitor_->setAdaptiveTuning(enabled); }
 
-  GstPad* uri_caps_scaled_src = gst_element_get_static_pad(uri_caps_scaled_, "src");
-  GstPad* selector_sink1 = gst_element_request_pad_simple(src_selector_, "sink_%u");
-  if (gst_pad_link(uri_caps_scaled_src, selector_sink1) != GST_PAD_LINK_OK) {
-    SPDLOG_SERVICE_ERROR("[Camera] Failed to link uri source to input selector sink_1");
-    return false;
-  }
-  gst_object_unref(uri_caps_scaled_src);
-  gst_object_unref(selector_sink1);
+bool CameraService::isAdaptiveTuning() const { return queue_monitor_->isAdaptiveTuning(); }
 
-  if (!gst_element_link(src_selector_, tee_)) {
-    SPDLOG_SERVICE_ERROR("[Camera] Failed to link input_selector to tee");
-    return false;
-  }
+void CameraService::setConsumerCounters(std::function<uint64_t()> pulled, std::function<uint64_t()> dropped) {
+  queue_monitor_->setConsumerCounters(std::move(pulled), std::move(dropped));
+}
 
-  GstPad* tee_src0 = gst_element_request_pad_simple(tee_, "src_%u");
-  GstPad* tee_src1 = gst_element_request_pad_simple(tee_, "src_%u");
-  GstPad* front_queue_sink = gst_element_get_static_pad(front_queue_, "sink");
-  GstPad* inference_queue_sink = gst_element_get_static_pad(inference_queue_, "sink");
+void CameraService::setInferenceDeadline(int32_t deadline_ms) {
+  if (deadline_ms < 0) deadline_ms = 0;
+  deadline_filter_->setDeadline(deadline_ms * GST_MSECOND);
+  g_object_set(inference_appsink_, "max-lateness", maxLatenessFor(deadline_ms), nullptr);
+  SPDLOG_SERVICE_INFO("[Camera] inference deadline set to {} ms", deadline_ms);
+}
 
-  if (gst_pad_link(tee_src0, front_queue_sink) != GST_PAD_LINK_OK ||
-      gst_pad_link(tee_src1, inference_queue_sink) != GST_PAD_LINK_OK) {
-    SPDLOG_SERVICE_ERROR("[Camera] link elements tee -> queue fail!");
-    return false;
-  }
+int32_t CameraService::getInferenceDeadline() const {
+  return static_cast<int32_t>(deadline_filter_->deadline() / GST_MSECOND);
+}
 
-  gst_object_unref(tee_src0);
-  gst_object_unref(tee_src1);
-  gst_object_unref(front_queue_sink);
-  gst_object_unref(inference_queue_sink);
+void CameraService::onDetections(uint32_t num_objects) { activity_controller_->onFrame(num_objects); }
 
-  if (!gst_element_link_many(front_queue_, front_conv_, front_caps_, front_shm_, nullptr)) {
-    SPDLOG_SERVICE_ERROR("[Camera] link elements front_queue -> front_shm fail!");
-    return false;
-  }
+void CameraService::setActivityControl(bool enabled) { activity_controller_->setEnabled(enabled); }
 
-  if (!gst_element_link_many(inference_queue_, inference_conv_, nullptr)) {
-    SPDLOG_SERVICE_ERROR("[Camera] link elements q2 -> caps_nvmm fail!");
-    return false;
-  }
+bool CameraService::isActivityControl() const { return activity_controller_->isEnabled(); }
 
-  GstPad* mux_sink0 = gst_element_request_pad_simple(inference_streammux_, "sink_0");
-  GstPad* caps_src = gst_element_get_static_pad(inference_conv_, "src");
-  if (gst_pad_link(caps_src, mux_sink0) != GST_PAD_LINK_OK) {
-    SPDLOG_SERVICE_ERROR("[Camera] link elements caps_src -> mux_sink fail!");
-    return false;
-  }
+void CameraService::setMotionGate(bool enabled, double threshold) {
+  if (threshold > 0.0) motion_gate_->setThreshold(threshold);
+  motion_gate_->setEnabled(enabled);
+  SPDLOG_SERVICE_INFO("[Camera] motion gate {} (threshold {})", enabled ? "enabled" : "disabled",
+                      motion_gate_->threshold());
+}
 
-  gst_object_unref(caps_src);
-  gst_object_unref(mux_sink0);
+bool CameraService::isMotionGate() const { return motion_gate_->isEnabled(); }
 
-  if (!gst_element_link_many(inference_streammux_, inference_nvinfer_, inference_conv3_, inference_caps_sys_,
-                             inference_appsink_, nullptr)) {
-    return false;
-  }
+double CameraService::getMotionThreshold() const { return motion_gate_->threshold(); }
 
-  return true;
+void CameraService::setStaticFrameListener(std::function<void(uint64_t pts)> listener) {
+  motion_gate_->setListener(std::move(listener));
 }
 
-static gboolean isAudioCaps(GstCaps* caps) {
-  const GstStructure* s = gst_caps_get_structure(caps, 0);
-  const gchar* name = gst_structure_get_name(s);
-  return g_str_has_prefix(name, "audio/");
+bool CameraService::setInferenceRois(const std::vector<app_common::RoiRect>& rois, std::string& error) {
+  const bool ok = roi_cropper_->setRois(rois, error);
+  // 실패해도 일부 분기는 이미 바뀌었을 수 있으니 실제 연결된 분기 기준으로 맞춘다
+  g_object_set(inference_streammux_, "batch-size", static_cast<guint>(getSourceCount() + roi_cropper_->rois().size()),
+               nullptr);
+  notifyRoiListener();
+  return ok;
 }
 
-gboolean CameraService::onAutoplugContinue(GstElement* bin, GstPad* pad, GstCaps* caps, gpointer user_data) {
-  gchar* caps_str = gst_caps_to_string(caps);
-  g_print("[uridecodebin] new stream on pad '%s': %s\n", GST_PAD_NAME(pad), caps_str);
+std::vector<app_common::RoiRect> CameraService::getInferenceRois() const { return roi_cropper_->rois(); }
 
-  if (isAudioCaps(caps)) {
-    g_print("[decodebin] skip audio stream\n");
-    return FALSE;
+void CameraService::setRoiListener(RoiListener listener) {
+  {
+    std::lock_guard<std::mutex> lock(roi_listener_mutex_);
+    roi_listener_ = std::move(listener);
   }
+  notifyRoiListener();
+}
 
-  g_free(caps_str);
-  return TRUE;
+void CameraService::notifyRoiListener() {
+  std::vector<app_common::RoiTransform> by_pad(getSourceCount());
+  for (uint32_t id = 0; id < getSourceCount(); ++id) by_pad[id].source_id = id;
+  for (const auto& transform : roi_cropper_->transforms()) by_pad.push_back(transform);
+
+  std::lock_guard<std::mutex> lock(roi_listener_mutex_);
+  if (roi_listener_) roi_listener_(by_pad);
+}
+
+app_common::Json CameraService::getStats() const {
+  return {{"trace", tracer_->stats()},
+          {"queues", queue_monitor_->stats()},
+          {"deadline", {{"deadline_ms", getInferenceDeadline()}, {"dropped", deadline_filter_->dropped()}}},
+          {"activity", {{"enabled", activity_controller_->isEnabled()}, {"idle", activity_controller_->isIdle()}}},
+          {"motion",
+           {{"enabled", motion_gate_->isEnabled()},
+            {"threshold", motion_gate_->threshold()},
+            {"last_score", motion_gate_->lastScore()},
+            {"skipped", motion_gate_->skipped()}}},
+          {"roi", {{"rois", app_common::formatRois(roi_cropper_->rois())}, {"max", roi_cropper_->maxRois()}}},
+          {"sources", source_uris_},
+          {"recovery", supervisor_->stats()}};
+}
+
+bool CameraService::checkLiveProperty(const std::string& element, const std::string& property, const std::string& value,
+                                      std::string& error) const {
+  if (!isLiveProperty(element, property)) {
+    error = element + "." + property + ": not changeable at runtime";
+    return false;
+  }
+  GstElement* target = gst_bin_get_by_name(GST_BIN(pipeline_), element.c_str());
+  if (!target) {
+    error = element + ": no such element in pipeline";
+    return false;
+  }
+  GValue gvalue = G_VALUE_INIT;
+  bool ok = deserializeProperty(target, property, value, &gvalue, error);
+  if (ok) {
+    if (G_VALUE_HOLDS(&gvalue, GST_TYPE_CAPS)) ok = upstreamCanProduce(target, &gvalue, error);
+    g_value_unset(&gvalue);
+  }
+  gst_object_unref(target);
+  return ok;
 }
 
-void CameraService::installPadProbe() {}
+bool CameraService::setLiveProperty(const std::string& element, const std::string& property, const std::string& value,
+                                    std::string& error) {
+  if (!checkLiveProperty(element, property, value, error)) return false;
+
+  GstElement* target = gst_bin_get_by_name(GST_BIN(pipeline_), element.c_str());
+  const bool ok = setPropertyAtIdle(target, property, value,
+                                    std::chrono::milliseconds(app_config::kLivePropertyTimeoutMs), error);
+  gst_object_unref(target);
+  if (ok) SPDLOG_SERVICE_INFO("[Camera] {}.{} set to {}", element, property, value);
+  return ok;
+}
 
 void CameraService::busWatchFunction() {
   while (is_active_) {
@@ -330,6 +527,7 @@ void CameraService::busWatchFunction() {
         SPDLOG_SERVICE_ERROR("[Camera] GStreamer ERROR from element [{}]: {}", (elem_name ? elem_name : "unknown"),
                              (err ? err->message : "unknown"));
         SPDLOG_SERVICE_ERROR("[Camera] Debugging information: {}", (dbg ? dbg : "none"));
+        const std::string message = err ? err->message : "unknown";
 
         if (dbg) g_free(dbg);
         if (err) g_error_free(err);
@@ -337,13 +535,15 @@ void CameraService::busWatchFunction() {
         SPDLOG_SERVICE_INFO("Dumping pipeline graph to /tmp/pipeline_error.dot");
         GST_DEBUG_BIN_TO_DOT_FILE(GST_BIN(pipeline_), GST_DEBUG_GRAPH_SHOW_ALL, "pipeline_error");
 
-        stop();
+        // 실패한 입력(또는 파이프라인 전체)만 backoff 뒤에 다시 시작한다
+        supervisor_->onError(GST_MESSAGE_SRC(msg), message);
         break;
       }
 
       case GST_MESSAGE_EOS: {
+        // 입력의 EOS 는 SourceSupervisor 가 막으므로 여기까지 오면 입력 밖에서 끝난 것이다
         SPDLOG_SERVICE_ERROR("[Camera] EOS received");
-        stop();
+        supervisor_->onPipelineEos();
         break;
       }
 
@@ -356,45 +556,3 @@ void CameraService::busWatchFunction() {
 
   SPDLOG_SERVICE_INFO("[Camera] Bus watch thread finished.");
 }
-
-void CameraService::onPadAdded(GstElement* src, GstPad* new_pad, gpointer user_data) {
-  CameraService* self = static_cast<CameraService*>(user_data);
-  SPDLOG_SERVICE_INFO("[Camera] uridecodebin created a new pad '{}'", GST_PAD_NAME(new_pad));
-  self->linkUridecodebinPad(new_pad);
-}
-
-void CameraService::linkUridecodebinPad(GstPad* new_pad) {
-  GstCaps* new_pad_caps = gst_pad_get_current_caps(new_pad);
-  GstStructure* new_pad_struct = gst_caps_get_structure(new_pad_caps, 0);
-  const gchar* new_pad_type = gst_structure_get_name(new_pad_struct);
-  SPDLOG_SERVICE_INFO("uridecodebin created a new pad of type '{}'", new_pad_type);
-
-  GstPad* sink_pad = nullptr;
-
-  if (g_str_has_prefix(new_pad_type, "video/x-raw")) {
-    SPDLOG_SERVICE_INFO("[Camera] Found video pad, preparing to link to queue.");
-    sink_pad = gst_element_get_static_pad(uri_queue_, "sink");
-  } else if (g_str_has_prefix(new_pad_type, "audio/")) {
-    SPDLOG_SERVICE_INFO("[Camera] Found audio pad, preparing to link to fakesink.");
-    sink_pad = gst_element_get_static_pad(audio_fakesink_, "sink");
-  } else {
-    SPDLOG_SERVICE_WARN("[Camera] Ignoring unknown pad type from uridecodebin: {}", new_pad_type);
-  }
-
-  if (sink_pad) {
-    if (gst_pad_is_linked(sink_pad)) {
-      SPDLOG_SERVICE_WARN("Sink pad is already linked.");
-    } else {
-      if (gst_pad_link(new_pad, sink_pad) != GST_PAD_LINK_OK) {
-        SPDLOG_SERVICE_ERROR("Failed to link new pad.");
-      } else {
-        SPDLOG_SERVICE_INFO("Successfully linked new pad.");
-      }
-    }
-    gst_object_unref(sink_pad);
-  }
-
-  if (new_pad_caps != nullptr) {
-    gst_caps_unref(new_pad_caps);
-  }
-}
@@ -0,0 +1,64 @@
+#include "impl/camera/deadline_filter.hpp"
+
+#include "common/utils/logging.hpp"
+
+DeadlineFilter::DeadlineFilter(GstElement* pipeline) : pipeline_(GST_ELEMENT(gst_object_ref(pipeline))) {
+  gst_segment_init(&segment_, GST_FORMAT_UNDEFINED);
+}
+
+DeadlineFilter::~DeadlineFilter() {
+  if (pad_) {
+    if (probe_id_) gst_pad_remove_probe(pad_, probe_id_);
+    gst_object_unref(pad_);
+  }
+  gst_object_unref(pipeline_);
+}
+
+void DeadlineFilter::attach(GstPad* pad) {
+  if (!pad || pad_) return;
+  pad_ = GST_PAD(gst_object_ref(pad));
+  probe_id_ = gst_pad_add_probe(pad_, GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM,
+                                &DeadlineFilter::onProbe, this, nullptr);
+}
+
+GstPadProbeReturn DeadlineFilter::onProbe(GstPad* /*pad*/, GstPadProbeInfo* info, gpointer user_data) {
+  auto* self = static_cast<DeadlineFilter*>(user_data);
+
+  if (GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_BUFFER) {
+    return self->onBuffer(GST_PAD_PROBE_INFO_BUFFER(info));
+  }
+
+  GstEvent* event = GST_PAD_PROBE_INFO_EVENT(info);
+  if (event && GST_EVENT_TYPE(event) == GST_EVENT_SEGMENT) {
+    const GstSegment* segment = nullptr;
+    gst_event_parse_segment(event, &segment);
+    gst_segment_copy_into(segment, &self->segment_);
+    self->has_segment_ = (segment->format == GST_FORMAT_TIME);
+  }
+  return GST_PAD_PROBE_OK;
+}
+
+GstPadProbeReturn DeadlineFilter::onBuffer(GstBuffer* buffer) {
+  const GstClockTime deadline = deadline_.load(std::memory_order_relaxed);
+  if (deadline == 0 || !has_segment_ || !buffer || !GST_BUFFER_PTS_IS_VALID(buffer)) return GST_PAD_PROBE_OK;
+
+  const GstClockTime buffer_rt = gst_segment_to_running_time(&segment_, GST_FORMAT_TIME, GST_BUFFER_PTS(buffer));
+  if (!GST_CLOCK_TIME_IS_VALID(buffer_rt)) return GST_PAD_PROBE_OK;
+
+  GstClock* clock = gst_element_get_clock(pipeline_);
+  if (!clock) return GST_PAD_PROBE_OK;
+  const GstClockTime now = gst_clock_get_time(clock);
+  gst_object_unref(clock);
+
+  const GstClockTime base_time = gst_element_get_base_time(pipeline_);
+  if (now < base_time) return GST_PAD_PROBE_OK;
+  const GstClockTime now_rt = now - base_time;
+
+  if (now_rt > buffer_rt && now_rt - buffer_rt > deadline) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    SPDLOG_SERVICE_DEBUG("[Camera] dropped late frame before inference: age={} ms, total={}",
+                         (now_rt - buffer_rt) / GST_MSECOND, dropped());
+    return GST_PAD_PROBE_DROP;
+  }
+  return GST_PAD_PROBE_OK;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <gst/gst.h>
+
+#include <atomic>
+#include <cstdint>
+
+// 캡처 PTS 의 running time 과 파이프라인 clock 의 현재 running time 을 비교해
+// deadline 보다 오래된 buffer 를 버리는 pad probe.
+// 추론이 밀렸을 때 오래된 프레임이 streammux / nvinfer 까지 가지 않게 q2 src 에 건다.
+class DeadlineFilter {
+public:
+  explicit DeadlineFilter(GstElement* pipeline);
+  ~DeadlineFilter();
+
+  void attach(GstPad* pad);
+  // 0 이면 끈다.
+  void setDeadline(GstClockTime deadline) { deadline_.store(deadline, std::memory_order_relaxed); }
+  GstClockTime deadline() const { return deadline_.load(std::memory_order_relaxed); }
+  uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+  DeadlineFilter(const DeadlineFilter&) = delete;
+  DeadlineFilter& operator=(const DeadlineFilter&) = delete;
+
+private:
+  static GstPadProbeReturn onProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
+  GstPadProbeReturn onBuffer(GstBuffer* buffer);
+
+  GstElement* pipeline_;
+  GstPad* pad_{nullptr};
+  gulong probe_id_{0};
+  GstSegment segment_;  // 스트리밍 스레드 전용
+  bool has_segment_{false};
+  std::atomic<GstClockTime> deadline_{0};
+  std::atomic<uint64_t> dropped_{0};
+};
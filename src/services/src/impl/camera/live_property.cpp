@@ -0,0 +1,72 @@
+#include "impl/camera/live_property.hpp"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "impl/camera/pipeline_builder.hpp"
+
+namespace {
+// probe 가 늦게 불려도 되도록 요청한 쪽과 probe 가 함께 소유한다
+struct IdleChange {
+  GstElement* element{nullptr};
+  std::string property;
+  GValue value = G_VALUE_INIT;
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool done{false};
+  bool cancelled{false};
+
+  ~IdleChange() {
+    if (G_IS_VALUE(&value)) g_value_unset(&value);
+  }
+};
+
+GstPadProbeReturn onIdle(GstPad* /*pad*/, GstPadProbeInfo* /*info*/, gpointer user_data) {
+  auto& change = **static_cast<std::shared_ptr<IdleChange>*>(user_data);
+  std::lock_guard<std::mutex> lock(change.mutex);
+  if (!change.cancelled && !change.done) {
+    g_object_set_property(G_OBJECT(change.element), change.property.c_str(), &change.value);
+    change.done = true;
+    change.cv.notify_all();
+  }
+  return GST_PAD_PROBE_REMOVE;
+}
+
+GstPad* probePad(GstElement* element) {
+  GstPad* pad = gst_element_get_static_pad(element, "sink");
+  return pad ? pad : gst_element_get_static_pad(element, "src");
+}
+}  // namespace
+
+bool setPropertyAtIdle(GstElement* element, const std::string& property, const std::string& value,
+                       std::chrono::milliseconds timeout, std::string& error) {
+  auto change = std::make_shared<IdleChange>();
+  change->element = element;
+  change->property = property;
+  if (!deserializeProperty(element, property, value, &change->value, error)) return false;
+
+  GstPad* pad = probePad(element);
+  if (!pad) {
+    // 흐르는 buffer 가 없는 요소
+    g_object_set_property(G_OBJECT(element), property.c_str(), &change->value);
+    return true;
+  }
+
+  // pad 가 이미 쉬고 있으면 probe 는 여기서 바로 불린다. 취소된 probe 는 다음에 pad 가 쉴 때 스스로 빠진다
+  gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_IDLE, onIdle, new std::shared_ptr<IdleChange>(change),
+                    [](gpointer data) { delete static_cast<std::shared_ptr<IdleChange>*>(data); });
+
+  bool applied;
+  {
+    std::unique_lock<std::mutex> lock(change->mutex);
+    applied = change->cv.wait_for(lock, timeout, [&] { return change->done; });
+    if (!applied) change->cancelled = true;
+  }
+  if (!applied) {
+    error = std::string(GST_ELEMENT_NAME(element)) + "." + property + ": pad did not go idle within " +
+            std::to_string(timeout.count()) + " ms";
+  }
+  gst_object_unref(pad);
+  return applied;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <gst/gst.h>
+
+#include <chrono>
+#include <string>
+
+// 재생 중인 요소의 속성을 buffer 사이에서 바꾼다. 요소의 sink pad (없으면 src pad) 에 IDLE probe 를 걸어
+// 그 pad 로 buffer 가 지나가지 않는 순간 streaming 스레드에서 설정하므로, buffer 하나를 처리하는 도중에 값이 바뀌지 않는다.
+// 값은 먼저 속성 타입으로 변환해 보므로 잘못된 값이면 파이프라인을 건드리지 않고 실패한다.
+// timeout 안에 pad 가 쉬지 않으면(예: PAUSED 에서 preroll 로 막힘) 적용을 취소하고 false.
+bool setPropertyAtIdle(GstElement* element, const std::string& property, const std::string& value,
+                       std::chrono::milliseconds timeout, std::string& error);
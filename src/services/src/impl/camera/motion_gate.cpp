@@ -0,0 +1,99 @@
+#include "impl/camera/motion_gate.hpp"
+
+#include "common/utils/logging.hpp"
+
+MotionGate::MotionGate(const Config& config)
+    : config_(config), scorer_(config.row_step), threshold_(config.threshold) {
+  gst_video_info_init(&info_);
+}
+
+MotionGate::~MotionGate() {
+  if (pad_) {
+    if (probe_id_) gst_pad_remove_probe(pad_, probe_id_);
+    gst_object_unref(pad_);
+  }
+}
+
+void MotionGate::attach(GstPad* pad) {
+  if (!pad || pad_) return;
+  pad_ = GST_PAD(gst_object_ref(pad));
+  probe_id_ = gst_pad_add_probe(pad_, GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM,
+                                &MotionGate::onProbe, this, nullptr);
+  SPDLOG_SERVICE_INFO("[Camera] motion gate using {} frame diff",
+                      app_common::simdLevelName(app_common::bestSimdLevel()));
+}
+
+void MotionGate::setListener(SkipListener listener) {
+  std::lock_guard<std::mutex> lock(listener_mutex_);
+  listener_ = std::move(listener);
+}
+
+GstPadProbeReturn MotionGate::onProbe(GstPad* /*pad*/, GstPadProbeInfo* info, gpointer user_data) {
+  auto* self = static_cast<MotionGate*>(user_data);
+
+  if (GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_BUFFER) {
+    return self->onBuffer(GST_PAD_PROBE_INFO_BUFFER(info));
+  }
+
+  GstEvent* event = GST_PAD_PROBE_INFO_EVENT(info);
+  if (event && GST_EVENT_TYPE(event) == GST_EVENT_CAPS) {
+    GstCaps* caps = nullptr;
+    gst_event_parse_caps(event, &caps);
+    self->onCaps(caps);
+  }
+  return GST_PAD_PROBE_OK;
+}
+
+void MotionGate::onCaps(GstCaps* caps) {
+  scorer_.reset();
+  static_run_ = 0;
+  skip_run_ = 0;
+
+  GstCapsFeatures* features = caps ? gst_caps_get_features(caps, 0) : nullptr;
+  if (features && gst_caps_features_contains(features, "memory:NVMM")) {
+    has_info_ = false;
+    SPDLOG_SERVICE_WARN("[Camera] motion gate disabled: NVMM caps cannot be read on CPU");
+    return;
+  }
+  has_info_ = caps && gst_video_info_from_caps(&info_, caps);
+}
+
+GstPadProbeReturn MotionGate::onBuffer(GstBuffer* buffer) {
+  if (!enabled_.load(std::memory_order_relaxed) || !has_info_ || !buffer) return GST_PAD_PROBE_OK;
+
+  GstVideoFrame frame;
+  if (!gst_video_frame_map(&frame, &info_, buffer, GST_MAP_READ)) return GST_PAD_PROBE_OK;
+
+  const auto* luma = static_cast<const uint8_t*>(GST_VIDEO_FRAME_PLANE_DATA(&frame, 0));
+  const int width = GST_VIDEO_FRAME_COMP_WIDTH(&frame, 0);
+  const int height = GST_VIDEO_FRAME_COMP_HEIGHT(&frame, 0);
+  const int stride = GST_VIDEO_FRAME_PLANE_STRIDE(&frame, 0);
+
+  const double score = scorer_.score(luma, width, height, stride);
+  last_score_.store(score, std::memory_order_relaxed);
+
+  bool skip = false;
+  if (score >= 0 && score < threshold_.load(std::memory_order_relaxed)) {
+    skip = ++static_run_ > config_.static_frames && skip_run_ < config_.max_skip;
+  } else {
+    static_run_ = 0;
+  }
+
+  if (skip) {
+    ++skip_run_;
+  } else {
+    // 추론에 보내는 프레임이 다음 비교의 기준이 된다
+    skip_run_ = 0;
+    scorer_.setReference(luma, width, height, stride);
+  }
+  gst_video_frame_unmap(&frame);
+
+  if (!skip) return GST_PAD_PROBE_OK;
+
+  skipped_total_.fetch_add(1, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(listener_mutex_);
+    if (listener_) listener_(GST_BUFFER_PTS_IS_VALID(buffer) ? GST_BUFFER_PTS(buffer) : 0);
+  }
+  return GST_PAD_PROBE_DROP;
+}
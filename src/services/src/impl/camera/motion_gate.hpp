@@ -0,0 +1,66 @@
+#pragma once
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "common/vision/frame_diff.hpp"
+
+// 추론 분기에서 마지막으로 추론에 보낸 프레임과 luma 차이를 비교해 정적인 프레임을 걸러내는 pad probe.
+// 점수가 threshold 미만인 프레임이 static_frames 번 이어지면 그 뒤 프레임은 streammux/nvinfer 로 보내지 않고
+// listener 에 PTS 만 알린다. 천천히 변하는 장면을 놓치지 않도록 max_skip 프레임마다 한 번은 통과시킨다.
+// 시스템 메모리 caps 에서만 동작하며, NVMM caps 이면 모든 프레임을 통과시킨다.
+class MotionGate {
+public:
+  struct Config {
+    double threshold;
+    int row_step;
+    uint32_t static_frames;
+    uint32_t max_skip;
+  };
+  using SkipListener = std::function<void(uint64_t pts)>;
+
+  explicit MotionGate(const Config& config);
+  ~MotionGate();
+
+  void attach(GstPad* pad);
+  void setListener(SkipListener listener);
+
+  void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+  bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+  void setThreshold(double threshold) { threshold_.store(threshold, std::memory_order_relaxed); }
+  double threshold() const { return threshold_.load(std::memory_order_relaxed); }
+  uint64_t skipped() const { return skipped_total_.load(std::memory_order_relaxed); }
+  double lastScore() const { return last_score_.load(std::memory_order_relaxed); }
+
+  MotionGate(const MotionGate&) = delete;
+  MotionGate& operator=(const MotionGate&) = delete;
+
+private:
+  static GstPadProbeReturn onProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
+  void onCaps(GstCaps* caps);
+  GstPadProbeReturn onBuffer(GstBuffer* buffer);
+
+  const Config config_;
+  GstPad* pad_{nullptr};
+  gulong probe_id_{0};
+
+  // 스트리밍 스레드 전용
+  app_common::FrameDiffScorer scorer_;
+  GstVideoInfo info_;
+  bool has_info_{false};
+  uint32_t static_run_{0};
+  uint32_t skip_run_{0};
+
+  std::atomic<bool> enabled_{true};
+  std::atomic<double> threshold_;
+  std::atomic<uint64_t> skipped_total_{0};
+  std::atomic<double> last_score_{0.0};
+
+  std::mutex listener_mutex_;
+  SkipListener listener_;
+};
@@ -0,0 +1,85 @@
+#include "impl/camera/pad_meta_tagger.hpp"
+
+#include <gstnvdsmeta.h>
+#include <nvdsmeta.h>
+
+#include <cstdio>
+
+#include "common/utils/logging.hpp"
+
+PadMetaTagger::PadMetaTagger(GstElement* funnel, int frame_width, int frame_height)
+    : funnel_(GST_ELEMENT(gst_object_ref(funnel))), frame_width_(frame_width), frame_height_(frame_height) {
+  for (uint32_t i = 0; i < pads_.size(); ++i) {
+    pads_[i].owner = this;
+    pads_[i].index = i;
+  }
+  pad_added_id_ = g_signal_connect(funnel_, "pad-added", G_CALLBACK(onPadAdded), this);
+  // 파이프라인 기술 파일로 만들면 funnel 입력이 먼저 연결되어 있다
+  gst_element_foreach_sink_pad(
+      funnel_,
+      [](GstElement* /*funnel*/, GstPad* pad, gpointer user_data) -> gboolean {
+        static_cast<PadMetaTagger*>(user_data)->tagPad(pad);
+        return TRUE;
+      },
+      this);
+}
+
+PadMetaTagger::~PadMetaTagger() {
+  g_signal_handler_disconnect(funnel_, pad_added_id_);
+  for (auto& state : pads_) {
+    if (!state.pad) continue;
+    gst_pad_remove_probe(state.pad, state.probe_id);
+    gst_object_unref(state.pad);
+  }
+  gst_object_unref(funnel_);
+}
+
+void PadMetaTagger::onPadAdded(GstElement* /*funnel*/, GstPad* pad, gpointer user_data) {
+  static_cast<PadMetaTagger*>(user_data)->tagPad(pad);
+}
+
+void PadMetaTagger::tagPad(GstPad* pad) {
+  if (GST_PAD_DIRECTION(pad) != GST_PAD_SINK) return;
+
+  unsigned index = 0;
+  if (std::sscanf(GST_PAD_NAME(pad), "sink_%u", &index) != 1 || index >= pads_.size()) {
+    SPDLOG_SERVICE_WARN("[Camera] funnel pad {} has no batch slot; frames will carry no meta", GST_PAD_NAME(pad));
+    return;
+  }
+
+  // ROI 분기는 떼었다 다시 붙이면 같은 이름의 새 pad 를 받는다
+  PadState& state = pads_[index];
+  if (state.pad) {
+    gst_pad_remove_probe(state.pad, state.probe_id);
+    gst_object_unref(state.pad);
+  }
+  state.pad = GST_PAD(gst_object_ref(pad));
+  state.probe_id = gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, onBuffer, &state, nullptr);
+}
+
+GstPadProbeReturn PadMetaTagger::onBuffer(GstPad* /*pad*/, GstPadProbeInfo* info, gpointer user_data) {
+  auto& state = *static_cast<PadState*>(user_data);
+  GstBuffer* buf = GST_PAD_PROBE_INFO_BUFFER(info);
+  if (!buf || gst_buffer_get_nvds_batch_meta(buf)) return GST_PAD_PROBE_OK;
+
+  buf = gst_buffer_make_writable(buf);
+  GST_PAD_PROBE_INFO_DATA(info) = buf;
+
+  NvDsBatchMeta* batch_meta = nvds_create_batch_meta(1);
+  batch_meta->base_meta.copy_func = nvds_batch_meta_copy_func;
+  batch_meta->base_meta.release_func = nvds_batch_meta_release_func;
+  NvDsMeta* meta =
+      gst_buffer_add_nvds_meta(buf, batch_meta, nullptr, nvds_batch_meta_copy_func, nvds_batch_meta_release_func);
+  meta->meta_type = NVDS_BATCH_GST_META;
+
+  NvDsFrameMeta* frame_meta = nvds_acquire_frame_meta_from_pool(batch_meta);
+  frame_meta->pad_index = state.index;
+  frame_meta->batch_id = 0;
+  frame_meta->source_id = state.index;
+  frame_meta->frame_num = static_cast<gint>(state.frames.fetch_add(1, std::memory_order_relaxed));
+  frame_meta->buf_pts = GST_BUFFER_PTS(buf);
+  frame_meta->source_frame_width = static_cast<guint>(state.owner->frame_width_);
+  frame_meta->source_frame_height = static_cast<guint>(state.owner->frame_height_);
+  nvds_add_frame_meta_to_batch(batch_meta, frame_meta);
+  return GST_PAD_PROBE_OK;
+}
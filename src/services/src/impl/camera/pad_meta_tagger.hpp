@@ -0,0 +1,41 @@
+#pragma once
+
+#include <gst/gst.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "config/camera_config.hpp"
+
+// DeepStream 없는 프로파일에서 nvstreammux 대신 쓰는 funnel 의 sink_<n> pad 마다
+// 1 프레임짜리 NvDsBatchMeta (pad_index = source_id = n) 를 붙인다.
+// 배치는 없지만 AiService 와 visionfakeinfer 는 streammux 출력과 같은 방식으로 입력 / ROI 를 구분한다.
+// 만들 때 이미 있는 sink pad 와 이후 요청되는 pad 모두에 붙는다.
+class PadMetaTagger {
+public:
+  PadMetaTagger(GstElement* funnel, int frame_width, int frame_height);
+  ~PadMetaTagger();
+
+  PadMetaTagger(const PadMetaTagger&) = delete;
+  PadMetaTagger& operator=(const PadMetaTagger&) = delete;
+
+private:
+  struct PadState {
+    PadMetaTagger* owner{nullptr};
+    uint32_t index{0};
+    GstPad* pad{nullptr};
+    gulong probe_id{0};
+    std::atomic<uint64_t> frames{0};
+  };
+
+  static void onPadAdded(GstElement* funnel, GstPad* pad, gpointer user_data);
+  static GstPadProbeReturn onBuffer(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
+  void tagPad(GstPad* pad);
+
+  GstElement* funnel_;
+  const int frame_width_;
+  const int frame_height_;
+  gulong pad_added_id_{0};
+  std::array<PadState, app_config::kMaxCameraSources + app_config::kInferenceMaxRois> pads_;
+};
@@ -0,0 +1,243 @@
+#include "impl/camera/pipeline_builder.hpp"
+
+#include <utility>
+
+#include "common/utils/logging.hpp"
+#include "config/camera_config.hpp"
+
+namespace {
+struct DynamicLink {
+  GstElement* sink;  // 같은 bin 안의 요소라 ref 를 잡지 않는다
+  std::string sink_pad;
+  std::string caps;
+  std::string description;
+};
+
+bool setProperty(GstElement* element, const std::string& key, const std::string& value, std::string& error) {
+  GValue gvalue = G_VALUE_INIT;
+  if (!deserializeProperty(element, key, value, &gvalue, error)) return false;
+  g_object_set_property(G_OBJECT(element), key.c_str(), &gvalue);
+  g_value_unset(&gvalue);
+  return true;
+}
+
+GstPad* sinkPadFor(GstElement* sink, GstPad* src_pad, const std::string& name) {
+  if (name.empty()) return gst_element_get_compatible_pad(sink, src_pad, nullptr);
+  GstPad* pad = gst_element_get_static_pad(sink, name.c_str());
+  return pad ? pad : gst_element_request_pad_simple(sink, name.c_str());
+}
+
+void onDynamicPad(GstElement* /*src*/, GstPad* new_pad, gpointer user_data) {
+  const auto* link = static_cast<const DynamicLink*>(user_data);
+  if (GST_PAD_DIRECTION(new_pad) != GST_PAD_SRC) return;
+
+  if (!link->caps.empty()) {
+    GstCaps* caps = gst_pad_get_current_caps(new_pad);
+    if (!caps) caps = gst_pad_query_caps(new_pad, nullptr);
+    const bool matches = caps && !gst_caps_is_empty(caps) &&
+                         g_str_has_prefix(gst_structure_get_name(gst_caps_get_structure(caps, 0)), link->caps.c_str());
+    if (caps) gst_caps_unref(caps);
+    if (!matches) return;
+  }
+
+  GstPad* sink_pad = sinkPadFor(link->sink, new_pad, link->sink_pad);
+  if (!sink_pad) {
+    SPDLOG_SERVICE_ERROR("[Camera] {}: no sink pad for '{}'", link->description, GST_PAD_NAME(new_pad));
+    return;
+  }
+  if (gst_pad_is_linked(sink_pad)) {
+    SPDLOG_SERVICE_WARN("[Camera] {}: sink pad is already linked", link->description);
+  } else if (gst_pad_link(new_pad, sink_pad) != GST_PAD_LINK_OK) {
+    SPDLOG_SERVICE_ERROR("[Camera] {}: failed to link pad '{}'", link->description, GST_PAD_NAME(new_pad));
+  } else {
+    SPDLOG_SERVICE_INFO("[Camera] {}: linked pad '{}'", link->description, GST_PAD_NAME(new_pad));
+  }
+  gst_object_unref(sink_pad);
+}
+
+const char* padOrNull(const std::string& name) { return name.empty() ? nullptr : name.c_str(); }
+
+app_common::ElementSpec element(std::string name, std::string factory,
+                                std::vector<std::pair<std::string, std::string>> properties = {}) {
+  return {std::move(name), std::move(factory), std::move(properties)};
+}
+
+app_common::LinkSpec link(std::string src, std::string sink, std::string src_pad = {}, std::string sink_pad = {}) {
+  return {std::move(src), std::move(src_pad), std::move(sink), std::move(sink_pad), false, {}};
+}
+
+void chain(std::vector<app_common::LinkSpec>& links, std::initializer_list<const char*> names) {
+  for (auto it = names.begin(); it + 1 != names.end(); ++it) links.push_back(link(*it, *(it + 1)));
+}
+}  // namespace
+
+bool deserializeProperty(GstElement* element, const std::string& key, const std::string& value, GValue* out,
+                         std::string& error) {
+  const std::string where = std::string(GST_ELEMENT_NAME(element)) + "." + key;
+  GParamSpec* pspec = g_object_class_find_property(G_OBJECT_GET_CLASS(element), key.c_str());
+  if (!pspec || !(pspec->flags & G_PARAM_WRITABLE)) {
+    error = where + ": no such writable property";
+    return false;
+  }
+
+  // gst_util_set_object_arg 와 같은 변환이지만 실패를 알 수 있게 직접 한다
+  g_value_init(out, pspec->value_type);
+  if (!gst_value_deserialize(out, value.c_str())) {
+    error = where + ": cannot set '" + value + "' as " + g_type_name(pspec->value_type);
+    g_value_unset(out);
+    return false;
+  }
+  return true;
+}
+
+bool buildPipelineFromSpec(GstElement* pipeline, const app_common::PipelineSpec& spec, std::string& error) {
+  if (!app_common::validatePipelineSpec(spec, error)) return false;
+
+  for (const auto& item : spec.elements) {
+    GstElement* element = gst_element_factory_make(item.factory.c_str(), item.name.c_str());
+    if (!element) {
+      error = item.name + ": cannot create element '" + item.factory + "'";
+      return false;
+    }
+    if (!gst_bin_add(GST_BIN(pipeline), element)) {
+      error = item.name + ": cannot add to pipeline";
+      return false;
+    }
+    for (const auto& [key, value] : item.properties) {
+      if (!setProperty(element, key, value, error)) return false;
+    }
+  }
+
+  for (const auto& item : spec.links) {
+    // validatePipelineSpec 이 이름을 확인했으므로 요소는 있다. bin 이 ref 를 갖고 있어 바로 놓는다.
+    GstElement* src = gst_bin_get_by_name(GST_BIN(pipeline), item.src.c_str());
+    GstElement* sink = gst_bin_get_by_name(GST_BIN(pipeline), item.sink.c_str());
+    gst_object_unref(src);
+    gst_object_unref(sink);
+
+    if (item.dynamic) {
+      auto* dynamic = new DynamicLink{sink, item.sink_pad, item.caps, app_common::describe(item)};
+      g_signal_connect_data(
+          src, "pad-added", G_CALLBACK(onDynamicPad), dynamic,
+          [](gpointer data, GClosure* /*closure*/) { delete static_cast<DynamicLink*>(data); }, GConnectFlags(0));
+      continue;
+    }
+    // pad 이름이 "src_%u" 같은 템플릿이면 request pad 를 받는다
+    if (!gst_element_link_pads(src, padOrNull(item.src_pad), sink, padOrNull(item.sink_pad))) {
+      error = app_common::describe(item) + ": link failed";
+      return false;
+    }
+  }
+  return true;
+}
+
+app_common::PipelineSpec defaultCameraPipelineSpec(bool sink_mode_frames) {
+  using app_config::kVideoConvertElement;
+  const std::string scaled_caps = "video/x-raw,format=NV12,width=" + std::to_string(app_config::kInferenceFrameWidth) +
+                                  ",height=" + std::to_string(app_config::kInferenceFrameHeight);
+
+  app_common::PipelineSpec spec;
+  spec.name = "inference-pipe";
+  auto& e = spec.elements;
+  // uri 입력
+  e.push_back(element("uri_src", "uridecodebin", {{"uri", "${source0_uri}"}, {"caps", app_config::kDecodedCaps}}));
+  e.push_back(element("uri_queue", "queue"));
+  e.push_back(element("uri_conv", kVideoConvertElement));
+  e.push_back(element("uri_caps_scaled", "capsfilter", {{"caps", scaled_caps}}));
+  e.push_back(element("audio_discard", "fakesink"));
+  e.push_back(element("src_selector", "input-selector"));
+  e.push_back(element("tee", "tee"));
+
+  // 미리보기 (shm)
+  e.push_back(element("front_queue", "queue", {{"max-size-buffers", "1"}, {"leaky", "downstream"}}));
+  e.push_back(element("front_conv", kVideoConvertElement));
+  e.push_back(element("front_caps", "capsfilter", {{"caps", "video/x-raw,format=I420,width=960,height=544"}}));
+  e.push_back(element("front_shm", "shmsink",
+                      {{"socket-path", "/tmp/cam.sock"},
+                       {"sync", "false"},
+                       {"shm-size", "3145728"},
+                       {"wait-for-connection", "false"}}));
+
+  // 추론. 늦은 buffer 는 appsink 에서 버리고 QoS 이벤트로 상류의 변환을 건너뛰게 한다
+  e.push_back(element("q2", "queue",
+                      {{"max-size-buffers", std::to_string(app_config::kInferenceQueueDepth)}, {"leaky", "upstream"}}));
+  // 평소에는 그대로 통과시키고, 장면이 비어 있을 때만 framerate 를 걸어 추론으로 갈 프레임을 버린다. 미리보기는 그대로다
+  e.push_back(element("infer_videorate", "videorate", {{"drop-only", "true"}}));
+  e.push_back(element("infer_caps_framerate", "capsfilter", {{"caps", "video/x-raw"}}));
+  e.push_back(element("infer_tee", "tee"));
+  e.push_back(element("conv2", kVideoConvertElement, {{"qos", "true"}}));
+  e.push_back(element("caps_nvmm_b2", "capsfilter", {{"caps", app_config::muxInputCaps()}}));
+  if (app_config::kWithDeepStream) {
+    // streammux batch-size 는 연결된 입력 수(입력 + ROI 수)를 따라가고, nvinfer 는 최대 배치로 잡아 둔다
+    e.push_back(element("streammux", app_config::kStreamMuxElement,
+                        {{"batch-size", "${mux_batch}"},
+                         {"width", std::to_string(app_config::kStreammuxWidth)},
+                         {"height", std::to_string(app_config::kStreammuxHeight)},
+                         {"live-source", "true"},
+                         {"batched-push-timeout", std::to_string(app_config::kBatchedPushTimeoutUs)}}));
+    e.push_back(element("primary_gie", app_config::kInferElement,
+                        {{"config-file-path", app_config::kInferConfigFile}, {"batch-size", "${infer_batch}"}}));
+  } else {
+    // funnel 은 배치를 만들지 않고, fake inference 는 pad 별 생성기를 입력 + ROI 수만큼 둔다
+    e.push_back(element("streammux", app_config::kStreamMuxElement));
+    e.push_back(element("primary_gie", app_config::kInferElement,
+                        {{"batch-size", "${infer_batch}"},
+                         {"frame-width", std::to_string(app_config::kStreammuxWidth)},
+                         {"frame-height", std::to_string(app_config::kStreammuxHeight)}}));
+  }
+  if (sink_mode_frames) {
+    e.push_back(element("conv3", kVideoConvertElement, {{"qos", "true"}}));
+    e.push_back(element("caps_sys", "capsfilter", {{"caps", "video/x-raw,format=RGBA"}}));
+  }
+  e.push_back(element("inference_appsink", "appsink",
+                      {{"emit-signals", "true"},
+                       {"max-buffers", "1"},
+                       {"drop", "true"},
+                       {"qos", "true"},
+                       {"max-lateness", "${max_lateness}"}}));
+
+  auto& l = spec.links;
+  l.push_back({"uri_src", {}, "uri_queue", {}, true, "video/x-raw"});
+  l.push_back({"uri_src", {}, "audio_discard", {}, true, "audio/"});
+  chain(l, {"uri_queue", "uri_conv", "uri_caps_scaled"});
+  l.push_back(link("uri_caps_scaled", "src_selector", {}, "sink_%u"));
+  chain(l, {"src_selector", "tee"});
+  // tee 의 한쪽은 프론트(shm), 다른 쪽은 추론 분기
+  l.push_back(link("tee", "front_queue", "src_%u"));
+  l.push_back(link("tee", "q2", "src_%u"));
+  chain(l, {"front_queue", "front_conv", "front_caps", "front_shm"});
+  // infer_tee 의 나머지 출력은 ROI crop 분기 (RoiCropper)
+  chain(l, {"q2", "infer_videorate", "infer_caps_framerate", "infer_tee", "conv2", "caps_nvmm_b2"});
+  l.push_back(link("caps_nvmm_b2", "streammux", {}, "sink_0"));
+  if (sink_mode_frames) {
+    chain(l, {"streammux", "primary_gie", "conv3", "caps_sys", "inference_appsink"});
+  } else {
+    chain(l, {"streammux", "primary_gie", "inference_appsink"});
+  }
+  return spec;
+}
+
+bool loadCameraPipelineSpec(const std::string& path, bool sink_mode_frames, app_common::PipelineSpec& spec,
+                            std::string& error) {
+  if (!g_file_test(path.c_str(), G_FILE_TEST_EXISTS)) {
+    spec = defaultCameraPipelineSpec(sink_mode_frames);
+    return true;
+  }
+
+  gchar* contents = nullptr;
+  gsize length = 0;
+  GError* err = nullptr;
+  if (!g_file_get_contents(path.c_str(), &contents, &length, &err)) {
+    error = path + ": " + (err ? err->message : "read failed");
+    if (err) g_error_free(err);
+    return false;
+  }
+  const bool ok = app_common::parsePipelineSpec(std::string_view(contents, length), spec, error);
+  g_free(contents);
+  if (!ok) {
+    error = path + ": " + error;
+    return false;
+  }
+  SPDLOG_SERVICE_INFO("[Camera] pipeline '{}' loaded from {}", spec.name, path);
+  return true;
+}
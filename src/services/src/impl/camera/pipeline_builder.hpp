@@ -0,0 +1,24 @@
+#pragma once
+
+#include <gst/gst.h>
+
+#include <string>
+
+#include "common/pipeline/pipeline_spec.hpp"
+
+// PipelineSpec 의 요소를 만들어 pipeline(bin) 에 넣고 적힌 순서대로 연결한다.
+// 속성은 요소가 가진 속성인지 확인한 뒤 그 타입으로 변환해 설정하고, dynamic link 는 pad-added 에서 연결한다.
+// 실패하면 error 에 어느 요소 / link 인지 담아 false. 이미 넣은 요소는 pipeline 을 해제할 때 같이 정리된다.
+bool buildPipelineFromSpec(GstElement* pipeline, const app_common::PipelineSpec& spec, std::string& error);
+
+// 속성 문자열을 element 의 속성 타입 값으로 바꾼다. 쓸 수 없는 속성이거나 변환에 실패하면 error 와 함께 false.
+// 성공하면 out 은 초기화되어 있으므로 호출한 쪽이 g_value_unset 한다.
+bool deserializeProperty(GstElement* element, const std::string& key, const std::string& value, GValue* out,
+                         std::string& error);
+
+// 카메라 파이프라인 (CameraService). sink_mode_frames 이면 nvinfer 뒤에 RGBA 변환(conv3 -> caps_sys)을 둔다.
+// 요소 이름은 CameraService 가 찾아 쓰는 이름이므로 기술 파일에서도 바꾸면 안 된다.
+app_common::PipelineSpec defaultCameraPipelineSpec(bool sink_mode_frames);
+// path 가 있으면 그 파일을, 없으면 기본 파이프라인을 spec 에 담는다. 파일이 있는데 잘못되었으면 error 와 함께 false.
+bool loadCameraPipelineSpec(const std::string& path, bool sink_mode_frames, app_common::PipelineSpec& spec,
+                            std::string& error);
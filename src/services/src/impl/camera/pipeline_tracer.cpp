@@ -0,0 +1,181 @@
+#include "impl/camera/pipeline_tracer.hpp"
+
+#include <chrono>
+
+#include "common/utils/logging.hpp"
+#include "config/zmq_config.hpp"
+
+namespace {
+uint64_t nowNs() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+app_common::Json latencyJson(const app_common::LatencyHistogram::Snapshot& snap) {
+  constexpr uint64_t kNsPerUs = 1000;
+  return {{"count", snap.count},
+          {"mean_us", snap.mean() / kNsPerUs},
+          {"p50_us", snap.percentile(0.50) / kNsPerUs},
+          {"p90_us", snap.percentile(0.90) / kNsPerUs},
+          {"p99_us", snap.percentile(0.99) / kNsPerUs},
+          {"max_us", snap.max / kNsPerUs}};
+}
+}  // namespace
+
+void PipelineTracer::PtsTable::put(uint64_t pts, uint64_t now_ns) {
+  auto& slot = slots_[slotFor(pts)];
+  slot.pts.store(UINT64_MAX, std::memory_order_relaxed);
+  slot.time_ns.store(now_ns, std::memory_order_relaxed);
+  slot.pts.store(pts, std::memory_order_release);
+}
+
+bool PipelineTracer::PtsTable::find(uint64_t pts, uint64_t& time_ns) const {
+  const auto& slot = slots_[slotFor(pts)];
+  if (slot.pts.load(std::memory_order_acquire) != pts) return false;
+  time_ns = slot.time_ns.load(std::memory_order_relaxed);
+  // 읽는 사이 다른 buffer 로 덮였으면 버린다
+  return slot.pts.load(std::memory_order_acquire) == pts;
+}
+
+PipelineTracer::PipelineTracer(PubSocket& pub_socket)
+    : pub_socket_(pub_socket),
+      topic_metrics_(pub_socket.ensureTopic(app_config::kTopicMetrics)),
+      snapshot_(std::make_unique<app_common::LatencyHistogram::Snapshot>()),
+      last_stats_(app_common::Json::object()),
+      thread_(&PipelineTracer::run, this) {}
+
+PipelineTracer::~PipelineTracer() {
+  {
+    std::lock_guard<std::mutex> lock(run_mutex_);
+    running_ = false;
+  }
+  run_cv_.notify_one();
+  thread_.join();
+
+  detachProbes();
+  for (auto& point : points_) gst_object_unref(point->pad);
+}
+
+int PipelineTracer::addPoint(const std::string& name, GstPad* pad, int prev) {
+  if (!pad) {
+    SPDLOG_SERVICE_WARN("[Tracer] pad not found for point {}", name);
+    return kNoPrev;
+  }
+
+  auto point = std::make_unique<Point>();
+  point->name = name;
+  point->pad = GST_PAD(gst_object_ref(pad));
+  if (prev >= 0 && prev < static_cast<int>(points_.size())) point->prev = points_[prev].get();
+  points_.push_back(std::move(point));
+  return static_cast<int>(points_.size()) - 1;
+}
+
+void PipelineTracer::setEnabled(bool enabled) {
+  std::lock_guard<std::mutex> lock(probe_mutex_);
+  if (enabled == enabled_.load(std::memory_order_relaxed)) return;
+
+  if (enabled) {
+    attachProbes();
+  } else {
+    detachProbes();
+  }
+  enabled_.store(enabled, std::memory_order_release);
+  SPDLOG_SERVICE_INFO("[Tracer] tracing {}", enabled ? "enabled" : "disabled");
+}
+
+void PipelineTracer::attachProbes() {
+  for (auto& point : points_) {
+    if (point->probe_id != 0) continue;
+    point->probe_id = gst_pad_add_probe(point->pad, GST_PAD_PROBE_TYPE_BUFFER, &PipelineTracer::onBuffer, point.get(),
+                                        nullptr);
+  }
+}
+
+void PipelineTracer::detachProbes() {
+  for (auto& point : points_) {
+    if (point->probe_id == 0) continue;
+    gst_pad_remove_probe(point->pad, point->probe_id);
+    point->probe_id = 0;
+  }
+}
+
+GstPadProbeReturn PipelineTracer::onBuffer(GstPad* /*pad*/, GstPadProbeInfo* info, gpointer user_data) {
+  auto* point = static_cast<Point*>(user_data);
+  point->frames.fetch_add(1, std::memory_order_relaxed);
+
+  GstBuffer* buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+  if (!buffer || !GST_BUFFER_PTS_IS_VALID(buffer)) return GST_PAD_PROBE_OK;
+
+  const uint64_t pts = GST_BUFFER_PTS(buffer);
+  const uint64_t now = nowNs();
+  point->seen.put(pts, now);
+
+  uint64_t start = 0;
+  if (point->prev && point->prev->seen.find(pts, start) && now >= start) {
+    point->hop_ns.record(now - start);
+  }
+  return GST_PAD_PROBE_OK;
+}
+
+void PipelineTracer::run() {
+  auto last = std::chrono::steady_clock::now();
+  bool was_enabled = false;
+  std::unique_lock<std::mutex> lock(run_mutex_);
+
+  while (running_) {
+    run_cv_.wait_for(lock, std::chrono::milliseconds(kMetricsIntervalMs));
+    if (!running_) break;
+
+    const bool enabled = enabled_.load(std::memory_order_acquire);
+    const auto now = std::chrono::steady_clock::now();
+    const double interval_s = std::chrono::duration<double>(now - last).count();
+    last = now;
+
+    // 다시 켜진 직후의 첫 주기는 꺼지기 전 값이 섞이므로 기준점만 맞추고 버린다
+    const bool first_window = enabled && !was_enabled;
+    was_enabled = enabled;
+    if (!enabled) continue;
+    if (first_window) {
+      collect(interval_s);
+      continue;
+    }
+
+    auto stats = collect(interval_s);
+    if (pub_socket_.hasSubscribers(topic_metrics_)) {
+      pub_socket_.publish(topic_metrics_, stats.dump());
+    }
+
+    std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+    last_stats_ = std::move(stats);
+  }
+}
+
+app_common::Json PipelineTracer::collect(double interval_s) {
+  app_common::Json points = app_common::Json::array();
+
+  for (auto& point : points_) {
+    const uint64_t frames = point->frames.load(std::memory_order_relaxed);
+    const double fps = interval_s > 0 ? static_cast<double>(frames - point->last_frames) / interval_s : 0.0;
+    point->last_frames = frames;
+
+    app_common::Json entry = {{"name", point->name}, {"fps", fps}, {"frames", frames}};
+    if (point->prev) {
+      point->hop_ns.drain(*snapshot_);
+      entry["from"] = point->prev->name;
+      entry["latency"] = latencyJson(*snapshot_);
+    }
+    points.push_back(std::move(entry));
+  }
+
+  return {{"source", "camera"},
+          {"interval_ms", static_cast<int64_t>(interval_s * 1000)},
+          {"points", std::move(points)}};
+}
+
+app_common::Json PipelineTracer::stats() const {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  app_common::Json stats = last_stats_;
+  stats["enabled"] = isEnabled();
+  return stats;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <gst/gst.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/utils/json.hpp"
+#include "common/utils/latency_histogram.hpp"
+#include "common/zmq/pub_socket.hpp"
+
+// 파이프라인 주요 pad 에 buffer probe 를 걸어 구간별 지연과 fps 를 잰다.
+// 각 지점은 지나간 buffer 의 PTS 와 통과 시각을 작은 테이블에 남기고,
+// 다음 지점은 같은 PTS 를 찾아 구간 지연을 히스토그램에 기록한다.
+// 끄면 probe 자체를 떼어내므로 비활성 상태의 오버헤드는 없다.
+class PipelineTracer {
+public:
+  static constexpr int kNoPrev = -1;
+  static constexpr int kMetricsIntervalMs = 1000;
+
+  explicit PipelineTracer(PubSocket& pub_socket);
+  ~PipelineTracer();
+
+  // pad 의 참조를 하나 가져간다. prev 는 구간의 시작 지점 (없으면 kNoPrev). 시작 전에만 호출한다.
+  int addPoint(const std::string& name, GstPad* pad, int prev);
+
+  void setEnabled(bool enabled);
+  bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  // 마지막 주기의 통계
+  app_common::Json stats() const;
+
+  PipelineTracer(const PipelineTracer&) = delete;
+  PipelineTracer& operator=(const PipelineTracer&) = delete;
+
+private:
+  // PTS -> 통과 시각. 직접 사상(direct-mapped) 테이블이라 충돌하면 덮어쓰고, 못 찾으면 기록을 건너뛴다.
+  class PtsTable {
+  public:
+    void put(uint64_t pts, uint64_t now_ns);
+    bool find(uint64_t pts, uint64_t& time_ns) const;
+
+  private:
+    static constexpr std::size_t kSize = 64;
+    struct Slot {
+      std::atomic<uint64_t> pts{UINT64_MAX};
+      std::atomic<uint64_t> time_ns{0};
+    };
+    static std::size_t slotFor(uint64_t pts) { return (pts * 0x9E3779B97F4A7C15ull) >> 58; }
+    std::array<Slot, kSize> slots_;
+  };
+
+  struct Point {
+    std::string name;
+    GstPad* pad{nullptr};
+    gulong probe_id{0};
+    Point* prev{nullptr};
+    std::atomic<uint64_t> frames{0};
+    PtsTable seen;
+    app_common::LatencyHistogram hop_ns;
+    uint64_t last_frames{0};  // 통계 스레드 전용
+  };
+
+  static GstPadProbeReturn onBuffer(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
+  void attachProbes();
+  void detachProbes();
+  void run();
+  app_common::Json collect(double interval_s);
+
+  PubSocket& pub_socket_;
+  PubSocket::TopicId topic_metrics_;
+  std::vector<std::unique_ptr<Point>> points_;
+  std::unique_ptr<app_common::LatencyHistogram::Snapshot> snapshot_;  // 통계 스레드 전용
+
+  std::atomic<bool> enabled_{false};
+  std::mutex probe_mutex_;
+
+  mutable std::mutex stats_mutex_;
+  app_common::Json last_stats_;
+
+  std::mutex run_mutex_;
+  std::condition_variable run_cv_;
+  bool running_{true};
+  std::thread thread_;
+};
@@ -0,0 +1,246 @@
+#include "impl/camera/queue_monitor.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "common/utils/logging.hpp"
+#include "config/zmq_config.hpp"
+
+namespace {
+// drop 이 없는 주기가 이만큼 이어지면 지연을 줄이는 쪽으로 되돌린다
+constexpr uint32_t kCalmWindowsBeforeRelax = 5;
+
+double ratio(uint64_t part, uint64_t whole) {
+  return whole ? static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+}
+}  // namespace
+
+QueueMonitor::QueueMonitor(PubSocket& pub_socket, const Bounds& bounds)
+    : pub_socket_(pub_socket),
+      topic_metrics_(pub_socket.ensureTopic(app_config::kTopicMetrics)),
+      bounds_(bounds),
+      last_stats_(app_common::Json::object()) {}
+
+QueueMonitor::~QueueMonitor() {
+  {
+    std::lock_guard<std::mutex> lock(run_mutex_);
+    running_ = false;
+  }
+  run_cv_.notify_one();
+  if (thread_.joinable()) thread_.join();
+
+  for (auto& stage : stages_) {
+    if (stage->sink_probe) gst_pad_remove_probe(stage->sink_pad, stage->sink_probe);
+    if (stage->src_probe) gst_pad_remove_probe(stage->src_pad, stage->src_probe);
+    if (stage->overrun_handler) g_signal_handler_disconnect(stage->element, stage->overrun_handler);
+    if (stage->sink_pad) gst_object_unref(stage->sink_pad);
+    if (stage->src_pad) gst_object_unref(stage->src_pad);
+    gst_object_unref(stage->element);
+  }
+  if (tune_queue_) gst_object_unref(tune_queue_);
+  if (tune_streammux_) gst_object_unref(tune_streammux_);
+}
+
+QueueMonitor::Stage& QueueMonitor::addStage(const std::string& name, GstElement* element, bool is_sink) {
+  auto stage = std::make_unique<Stage>();
+  stage->name = name;
+  stage->element = GST_ELEMENT(gst_object_ref(element));
+  stage->is_sink = is_sink;
+
+  stage->sink_pad = gst_element_get_static_pad(element, "sink");
+  if (stage->sink_pad) {
+    stage->sink_probe = gst_pad_add_probe(stage->sink_pad, GST_PAD_PROBE_TYPE_BUFFER, &QueueMonitor::onSinkBuffer,
+                                          stage.get(), nullptr);
+  }
+  if (!is_sink) {
+    stage->src_pad = gst_element_get_static_pad(element, "src");
+    if (stage->src_pad) {
+      stage->src_probe = gst_pad_add_probe(stage->src_pad, GST_PAD_PROBE_TYPE_BUFFER, &QueueMonitor::onSrcBuffer,
+                                           stage.get(), nullptr);
+    }
+  }
+
+  stages_.push_back(std::move(stage));
+  return *stages_.back();
+}
+
+void QueueMonitor::addQueue(const std::string& name, GstElement* queue) {
+  Stage& stage = addStage(name, queue, false);
+  // leaky 큐는 가득 찰 때마다 overrun 을 알린 뒤 buffer 를 버린다
+  stage.overrun_handler = g_signal_connect(queue, "overrun", G_CALLBACK(&QueueMonitor::onOverrun), &stage);
+}
+
+void QueueMonitor::addSink(const std::string& name, GstElement* sink) { addStage(name, sink, true); }
+
+void QueueMonitor::setTuningTarget(GstElement* queue, GstElement* streammux) {
+  tune_queue_ = GST_ELEMENT(gst_object_ref(queue));
+  tune_streammux_ = GST_ELEMENT(gst_object_ref(streammux));
+  for (auto& stage : stages_) {
+    if (stage->element == queue) tune_stage_ = stage.get();
+  }
+}
+
+void QueueMonitor::start() { thread_ = std::thread(&QueueMonitor::run, this); }
+
+void QueueMonitor::setConsumerCounters(std::function<uint64_t()> pulled, std::function<uint64_t()> dropped) {
+  std::lock_guard<std::mutex> lock(consumer_mutex_);
+  consumer_pulled_ = std::move(pulled);
+  consumer_drops_ = std::move(dropped);
+}
+
+GstPadProbeReturn QueueMonitor::onSinkBuffer(GstPad* /*pad*/, GstPadProbeInfo* /*info*/, gpointer user_data) {
+  static_cast<Stage*>(user_data)->in.fetch_add(1, std::memory_order_relaxed);
+  return GST_PAD_PROBE_OK;
+}
+
+GstPadProbeReturn QueueMonitor::onSrcBuffer(GstPad* /*pad*/, GstPadProbeInfo* /*info*/, gpointer user_data) {
+  static_cast<Stage*>(user_data)->out.fetch_add(1, std::memory_order_relaxed);
+  return GST_PAD_PROBE_OK;
+}
+
+void QueueMonitor::onOverrun(GstElement* /*queue*/, gpointer user_data) {
+  static_cast<Stage*>(user_data)->overruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t QueueMonitor::sinkDrops(Stage& stage) {
+  guint64 dropped = 0;
+  guint64 rendered = 0;
+  GstStructure* stats = nullptr;
+  g_object_get(stage.element, "stats", &stats, nullptr);
+  if (stats) {
+    gst_structure_get_uint64(stats, "dropped", &dropped);
+    gst_structure_get_uint64(stats, "rendered", &rendered);
+    gst_structure_free(stats);
+  }
+  uint64_t drops = dropped;
+
+  // rendered 는 appsink 큐에 넣은 수다. 큐에 아직 남아 있을 수 있는 max-buffers 개는 drop 으로 세지 않는다.
+  // 꺼낸 수를 stats 보다 나중에 읽으므로 drop 을 실제보다 많이 세지는 않는다
+  std::lock_guard<std::mutex> lock(consumer_mutex_);
+  if (consumer_pulled_) {
+    gboolean drop = FALSE;
+    guint max_buffers = 0;
+    g_object_get(stage.element, "drop", &drop, "max-buffers", &max_buffers, nullptr);
+    const uint64_t pulled = consumer_pulled_();
+    if (drop && max_buffers > 0 && rendered > pulled + max_buffers) drops += rendered - pulled - max_buffers;
+  }
+  if (consumer_drops_) drops += consumer_drops_();
+  return drops;
+}
+
+void QueueMonitor::run() {
+  auto last = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lock(run_mutex_);
+
+  while (running_) {
+    run_cv_.wait_for(lock, std::chrono::milliseconds(kIntervalMs));
+    if (!running_) break;
+
+    const auto now = std::chrono::steady_clock::now();
+    auto stats = collect(std::chrono::duration<double>(now - last).count());
+    last = now;
+
+    if (pub_socket_.hasSubscribers(topic_metrics_)) {
+      pub_socket_.publish(topic_metrics_, stats.dump());
+    }
+
+    std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+    last_stats_ = std::move(stats);
+  }
+}
+
+app_common::Json QueueMonitor::collect(double interval_s) {
+  app_common::Json stages = app_common::Json::array();
+
+  for (auto& stage : stages_) {
+    const uint64_t in = stage->in.load(std::memory_order_relaxed);
+    uint64_t level = 0;
+
+    if (stage->is_sink) {
+      stage->drops = std::max(stage->drops, sinkDrops(*stage));
+    } else {
+      guint current_level = 0;
+      g_object_get(stage->element, "current-level-buffers", &current_level, nullptr);
+      level = current_level;
+      // 카운터와 level 을 읽는 사이에 buffer 가 움직일 수 있으므로 누적값은 줄어들지 않게 한다
+      const uint64_t out = stage->out.load(std::memory_order_relaxed);
+      if (in >= out + level) stage->drops = std::max(stage->drops, in - out - level);
+    }
+
+    const uint64_t window_in = in - stage->last_in;
+    const uint64_t window_drops = stage->drops - stage->last_drops;
+    stage->last_in = in;
+    stage->last_drops = stage->drops;
+
+    if (stage.get() == tune_stage_ && isAdaptiveTuning()) tune(window_in, window_drops);
+
+    app_common::Json entry = {{"name", stage->name},
+                              {"in", in},
+                              {"drops", stage->drops},
+                              {"drops_per_s", interval_s > 0 ? static_cast<double>(window_drops) / interval_s : 0.0},
+                              {"drop_rate", ratio(window_drops, window_in)}};
+    if (!stage->is_sink) {
+      entry["level"] = level;
+      entry["overruns"] = stage->overruns.load(std::memory_order_relaxed);
+    }
+    stages.push_back(std::move(entry));
+  }
+
+  app_common::Json tuning = {{"enabled", isAdaptiveTuning()}};
+  if (tune_queue_ && tune_streammux_) {
+    guint depth = 0;
+    gint timeout_us = 0;
+    g_object_get(tune_queue_, "max-size-buffers", &depth, nullptr);
+    g_object_get(tune_streammux_, "batched-push-timeout", &timeout_us, nullptr);
+    tuning["queue_depth"] = depth;
+    tuning["batched_push_timeout_us"] = timeout_us;
+  }
+
+  return {{"source", "camera.queues"},
+          {"interval_ms", static_cast<int64_t>(interval_s * 1000)},
+          {"stages", std::move(stages)},
+          {"tuning", std::move(tuning)}};
+}
+
+QueueMonitor::Tuning QueueMonitor::nextTuning(const Bounds& bounds, Tuning current, uint64_t window_in,
+                                              uint64_t window_drops, uint32_t& calm_windows) {
+  if (window_in == 0) return current;
+
+  Tuning next = current;
+  if (ratio(window_drops, window_in) > bounds.target_drop_rate) {
+    // 버려지는 프레임이 많으면 버퍼를 늘리고 streammux 가 더 빨리 내보내게 한다 (지연 증가 감수)
+    calm_windows = 0;
+    next.depth = std::min<uint32_t>(current.depth + 1, bounds.max_depth);
+    next.push_timeout_us = std::max<int32_t>(current.push_timeout_us * 3 / 4, bounds.min_push_timeout_us);
+  } else if (window_drops == 0 && ++calm_windows >= kCalmWindowsBeforeRelax) {
+    // 한동안 안정적이면 큐를 줄여 지연을 낮춘다
+    calm_windows = 0;
+    next.depth = std::max<uint32_t>(current.depth > 0 ? current.depth - 1 : 0, bounds.min_depth);
+    next.push_timeout_us = std::min<int32_t>(current.push_timeout_us * 5 / 4, bounds.max_push_timeout_us);
+  }
+  return next;
+}
+
+void QueueMonitor::tune(uint64_t window_in, uint64_t window_drops) {
+  if (!tune_queue_ || !tune_streammux_) return;
+
+  guint depth = 0;
+  gint timeout_us = 0;
+  g_object_get(tune_queue_, "max-size-buffers", &depth, nullptr);
+  g_object_get(tune_streammux_, "batched-push-timeout", &timeout_us, nullptr);
+
+  const Tuning next = nextTuning(bounds_, {depth, timeout_us}, window_in, window_drops, calm_windows_);
+  if (next.depth != depth) g_object_set(tune_queue_, "max-size-buffers", guint{next.depth}, nullptr);
+  if (next.push_timeout_us != timeout_us) {
+    g_object_set(tune_streammux_, "batched-push-timeout", gint{next.push_timeout_us}, nullptr);
+  }
+  if (next.depth != depth || next.push_timeout_us != timeout_us) {
+    SPDLOG_SERVICE_INFO("[Camera] queue tuning: depth {} -> {}, batched-push-timeout {} -> {} us", depth, next.depth,
+                        timeout_us, next.push_timeout_us);
+  }
+}
+
+app_common::Json QueueMonitor::stats() const {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  return last_stats_;
+}
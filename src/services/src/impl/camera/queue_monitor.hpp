@@ -0,0 +1,116 @@
+#pragma once
+
+#include <gst/gst.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/utils/json.hpp"
+#include "common/zmq/pub_socket.hpp"
+
+// leaky queue 와 appsink 에서 버려지는 프레임을 센다.
+//   queue   : sink/src pad 에서 들어오고 나간 buffer 수를 세고, drops = in - out - 현재 level
+//   appsink : basesink stats 의 dropped (늦게 도착해 버린 buffer)
+//             + drop=true 로 appsink 큐에서 밀려난 sample (stats 의 rendered - 소비자가 꺼낸 수)
+//             + appsink 뒤 소비자가 버린 수
+// 1 초마다 metrics 토픽으로 발행하고, 켜져 있으면 q2 깊이와 streammux batched-push-timeout 을 조정한다.
+class QueueMonitor {
+public:
+  static constexpr int kIntervalMs = 1000;
+
+  struct Bounds {
+    uint32_t min_depth;
+    uint32_t max_depth;
+    int32_t min_push_timeout_us;
+    int32_t max_push_timeout_us;
+    double target_drop_rate;
+  };
+
+  struct Tuning {
+    uint32_t depth;
+    int32_t push_timeout_us;
+  };
+
+  // 주기 하나의 in / drop 수로 다음 큐 깊이와 batched-push-timeout 을 정한다. calm_windows 는 주기 사이에 이어진다.
+  static Tuning nextTuning(const Bounds& bounds, Tuning current, uint64_t window_in, uint64_t window_drops,
+                           uint32_t& calm_windows);
+
+  QueueMonitor(PubSocket& pub_socket, const Bounds& bounds);
+  ~QueueMonitor();
+
+  // 시작 전에만 호출한다.
+  void addQueue(const std::string& name, GstElement* queue);
+  void addSink(const std::string& name, GstElement* sink);
+  void setTuningTarget(GstElement* queue, GstElement* streammux);
+  void start();
+
+  // appsink 에서 소비자가 꺼낸 sample 수와 꺼낸 뒤 버린 수. 소비자가 먼저 사라질 수 있으므로 빈 함수로 해제할 수 있다.
+  void setConsumerCounters(std::function<uint64_t()> pulled, std::function<uint64_t()> dropped);
+
+  void setAdaptiveTuning(bool enabled) { tuning_enabled_.store(enabled, std::memory_order_relaxed); }
+  bool isAdaptiveTuning() const { return tuning_enabled_.load(std::memory_order_relaxed); }
+
+  app_common::Json stats() const;
+
+  QueueMonitor(const QueueMonitor&) = delete;
+  QueueMonitor& operator=(const QueueMonitor&) = delete;
+
+private:
+  struct Stage {
+    std::string name;
+    GstElement* element{nullptr};
+    bool is_sink{false};
+    GstPad* sink_pad{nullptr};
+    GstPad* src_pad{nullptr};
+    gulong sink_probe{0};
+    gulong src_probe{0};
+    gulong overrun_handler{0};
+    std::atomic<uint64_t> in{0};
+    std::atomic<uint64_t> out{0};
+    std::atomic<uint64_t> overruns{0};
+    // 통계 스레드 전용
+    uint64_t last_in{0};
+    uint64_t drops{0};
+    uint64_t last_drops{0};
+  };
+
+  static GstPadProbeReturn onSinkBuffer(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
+  static GstPadProbeReturn onSrcBuffer(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
+  static void onOverrun(GstElement* queue, gpointer user_data);
+
+  Stage& addStage(const std::string& name, GstElement* element, bool is_sink);
+  uint64_t sinkDrops(Stage& stage);
+  void run();
+  app_common::Json collect(double interval_s);
+  void tune(uint64_t window_in, uint64_t window_drops);
+
+  PubSocket& pub_socket_;
+  PubSocket::TopicId topic_metrics_;
+  const Bounds bounds_;
+  std::vector<std::unique_ptr<Stage>> stages_;
+
+  mutable std::mutex consumer_mutex_;
+  std::function<uint64_t()> consumer_pulled_;
+  std::function<uint64_t()> consumer_drops_;
+
+  GstElement* tune_queue_{nullptr};
+  GstElement* tune_streammux_{nullptr};
+  Stage* tune_stage_{nullptr};
+  std::atomic<bool> tuning_enabled_{false};
+  uint32_t calm_windows_{0};  // 통계 스레드 전용
+
+  mutable std::mutex stats_mutex_;
+  app_common::Json last_stats_;
+
+  std::mutex run_mutex_;
+  std::condition_variable run_cv_;
+  bool running_{true};
+  std::thread thread_;
+};
@@ -0,0 +1,206 @@
+#include "impl/camera/roi_cropper.hpp"
+
+#include <chrono>
+#include <future>
+#include <memory>
+
+#include "common/utils/logging.hpp"
+#include "config/camera_config.hpp"
+
+namespace {
+constexpr auto kUnlinkTimeout = std::chrono::seconds(1);
+
+// probe 는 removeLastSlot 이 시간 초과로 돌아간 뒤에도 불릴 수 있으므로 양쪽이 함께 소유한다
+struct UnlinkRequest {
+  explicit UnlinkRequest(GstPad* pad) : sink_pad(pad) {}
+  ~UnlinkRequest() { gst_object_unref(sink_pad); }
+
+  GstPad* sink_pad;
+  std::promise<void> done;
+};
+using UnlinkRequestPtr = std::shared_ptr<UnlinkRequest>;
+
+// tee 가 이 pad 로 buffer 를 밀고 있지 않은 순간에 호출된다
+GstPadProbeReturn unlinkWhenIdle(GstPad* pad, GstPadProbeInfo* /*info*/, gpointer user_data) {
+  const auto& request = *static_cast<UnlinkRequestPtr*>(user_data);
+  gst_pad_unlink(pad, request->sink_pad);
+  request->done.set_value();
+  return GST_PAD_PROBE_REMOVE;
+}
+
+void releaseUnlinkRequest(gpointer user_data) { delete static_cast<UnlinkRequestPtr*>(user_data); }
+}  // namespace
+
+RoiCropper::RoiCropper(GstElement* pipeline, GstElement* tee, GstElement* streammux, uint32_t source_id,
+                       uint32_t first_pad, uint32_t max_rois, const Geometry& geometry)
+    : pipeline_(pipeline),
+      tee_(tee),
+      streammux_(streammux),
+      source_id_(source_id),
+      first_pad_(first_pad),
+      max_rois_(max_rois),
+      geometry_(geometry) {}
+
+RoiCropper::~RoiCropper() {
+  // 분기 element 자체는 파이프라인이 정리한다
+  for (auto& slot : slots_) {
+    gst_object_unref(slot.tee_pad);
+    gst_object_unref(slot.mux_pad);
+  }
+}
+
+bool RoiCropper::setRois(std::vector<app_common::RoiRect> rois, std::string& error) {
+  if (rois.size() > max_rois_) {
+    error = "at most " + std::to_string(max_rois_) + " rois are supported";
+    return false;
+  }
+  for (auto& roi : rois) {
+    const auto requested = roi;
+    if (!app_common::normalizeRoi(roi, geometry_.frame_width, geometry_.frame_height)) {
+      error = "roi " + app_common::formatRoi(requested) + " is outside the frame or smaller than " +
+              std::to_string(app_common::kMinRoiSize) + "px";
+      return false;
+    }
+  }
+
+  while (slots_.size() > rois.size()) {
+    if (!removeLastSlot()) {
+      error = "failed to detach roi branch";
+      return false;
+    }
+  }
+
+  for (std::size_t i = 0; i < rois.size(); ++i) {
+    if (i < slots_.size()) {
+      if (slots_[i].roi == rois[i]) continue;
+      g_object_set(slots_[i].conv, "src-crop", app_common::formatRoi(rois[i]).c_str(), nullptr);
+      std::lock_guard<std::mutex> lock(mutex_);
+      slots_[i].roi = rois[i];
+    } else if (!addSlot(rois[i], error)) {
+      return false;
+    }
+  }
+
+  SPDLOG_SERVICE_INFO("[Camera] inference rois for source {}: '{}'", source_id_, app_common::formatRois(rois));
+  return true;
+}
+
+std::vector<app_common::RoiRect> RoiCropper::rois() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<app_common::RoiRect> rois;
+  rois.reserve(slots_.size());
+  for (const auto& slot : slots_) rois.push_back(slot.roi);
+  return rois;
+}
+
+std::vector<app_common::RoiTransform> RoiCropper::transforms() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<app_common::RoiTransform> transforms;
+  transforms.reserve(slots_.size());
+  for (const auto& slot : slots_) {
+    transforms.push_back(app_common::roiTransform(slot.roi, geometry_.frame_width, geometry_.frame_height,
+                                                  geometry_.mux_width, geometry_.mux_height, source_id_));
+  }
+  return transforms;
+}
+
+bool RoiCropper::addSlot(const app_common::RoiRect& roi, std::string& error) {
+  const std::size_t index = slots_.size();
+  const std::string queue_name = "roi_queue_" + std::to_string(source_id_) + "_" + std::to_string(index);
+  const std::string conv_name = "roi_conv_" + std::to_string(source_id_) + "_" + std::to_string(index);
+  const std::string caps_name = "roi_caps_" + std::to_string(source_id_) + "_" + std::to_string(index);
+  const std::string mux_pad_name = "sink_" + std::to_string(first_pad_ + index);
+
+  Slot slot;
+  slot.roi = roi;
+  slot.queue = gst_element_factory_make("queue", queue_name.c_str());
+  slot.conv = gst_element_factory_make(app_config::kVideoConvertElement, conv_name.c_str());
+  slot.caps = gst_element_factory_make("capsfilter", caps_name.c_str());
+  if (!slot.queue || !slot.conv || !slot.caps) {
+    if (slot.queue) gst_object_unref(slot.queue);
+    if (slot.conv) gst_object_unref(slot.conv);
+    if (slot.caps) gst_object_unref(slot.caps);
+    error = std::string("failed to create queue / ") + app_config::kVideoConvertElement + " / capsfilter for roi";
+    return false;
+  }
+  // front_queue 처럼 최신 프레임 하나만 둔다
+  g_object_set(slot.queue, "max-size-buffers", 1, "leaky", 2, nullptr);
+  g_object_set(slot.conv, "src-crop", app_common::formatRoi(roi).c_str(), nullptr);
+  GstCaps* mux_caps = gst_caps_from_string(app_config::muxInputCaps().c_str());
+  g_object_set(slot.caps, "caps", mux_caps, nullptr);
+  gst_caps_unref(mux_caps);
+  gst_bin_add_many(GST_BIN(pipeline_), slot.queue, slot.conv, slot.caps, nullptr);
+
+  slot.mux_pad = gst_element_request_pad_simple(streammux_, mux_pad_name.c_str());
+  GstPad* caps_src = gst_element_get_static_pad(slot.caps, "src");
+  const bool mux_linked = gst_element_link_many(slot.queue, slot.conv, slot.caps, nullptr) && slot.mux_pad &&
+                          gst_pad_link(caps_src, slot.mux_pad) == GST_PAD_LINK_OK;
+  gst_object_unref(caps_src);
+  if (!mux_linked) {
+    if (slot.mux_pad) {
+      gst_element_release_request_pad(streammux_, slot.mux_pad);
+      gst_object_unref(slot.mux_pad);
+    }
+    gst_bin_remove_many(GST_BIN(pipeline_), slot.queue, slot.conv, slot.caps, nullptr);
+    error = "failed to link roi branch to streammux " + mux_pad_name;
+    return false;
+  }
+
+  // 하류까지 준비된 뒤에 tee 에 붙여야 첫 buffer 가 NOT_LINKED 로 돌아오지 않는다
+  gst_element_sync_state_with_parent(slot.caps);
+  gst_element_sync_state_with_parent(slot.conv);
+  gst_element_sync_state_with_parent(slot.queue);
+  slot.tee_pad = gst_element_request_pad_simple(tee_, "src_%u");
+  GstPad* queue_sink = gst_element_get_static_pad(slot.queue, "sink");
+  const bool tee_linked = gst_pad_link(slot.tee_pad, queue_sink) == GST_PAD_LINK_OK;
+  gst_object_unref(queue_sink);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slots_.push_back(slot);
+  }
+  if (!tee_linked) {
+    removeLastSlot();
+    error = "failed to link tee to roi branch";
+    return false;
+  }
+  return true;
+}
+
+bool RoiCropper::removeLastSlot() {
+  Slot slot = slots_.back();
+
+  if (gst_pad_is_linked(slot.tee_pad)) {
+    auto request = std::make_shared<UnlinkRequest>(gst_element_get_static_pad(slot.queue, "sink"));
+    auto done = request->done.get_future();
+    const gulong probe_id = gst_pad_add_probe(slot.tee_pad, GST_PAD_PROBE_TYPE_IDLE, unlinkWhenIdle,
+                                              new UnlinkRequestPtr(request), releaseUnlinkRequest);
+    if (done.wait_for(kUnlinkTimeout) != std::future_status::ready) {
+      gst_pad_remove_probe(slot.tee_pad, probe_id);
+      // 제거와 동시에 probe 가 불렸을 수도 있으니 끝날 때까지 기다린다
+      if (gst_pad_is_linked(slot.tee_pad)) {
+        SPDLOG_SERVICE_ERROR("[Camera] roi branch {} did not become idle", GST_ELEMENT_NAME(slot.conv));
+        return false;
+      }
+      done.wait();
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slots_.pop_back();
+  }
+  gst_element_release_request_pad(tee_, slot.tee_pad);
+  gst_object_unref(slot.tee_pad);
+
+  gst_element_set_state(slot.queue, GST_STATE_NULL);
+  gst_element_set_state(slot.conv, GST_STATE_NULL);
+  gst_element_set_state(slot.caps, GST_STATE_NULL);
+  // streammux 가 이 입력을 기다리지 않도록 flush 후 pad 를 반납한다
+  gst_pad_send_event(slot.mux_pad, gst_event_new_flush_start());
+  gst_pad_send_event(slot.mux_pad, gst_event_new_flush_stop(FALSE));
+  gst_element_release_request_pad(streammux_, slot.mux_pad);
+  gst_object_unref(slot.mux_pad);
+  gst_bin_remove_many(GST_BIN(pipeline_), slot.queue, slot.conv, slot.caps, nullptr);
+  return true;
+}
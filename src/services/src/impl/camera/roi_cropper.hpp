@@ -0,0 +1,63 @@
+#pragma once
+
+#include <gst/gst.h>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/infer/roi.hpp"
+
+// 추론 분기 tee 에서 ROI 마다 queue -> convert(src-crop) -> capsfilter(muxInputCaps()) 분기를 만들어 streammux 의 별도 입력으로 붙인다.
+// queue 는 1 buffer leaky 라서 ROI 변환은 분기마다 제 스레드에서 돌고, 밀린 ROI 가 전체 프레임이나 다른 ROI 를 막지 않는다.
+// ROI i 는 streammux sink_<first_pad + i> 로 들어가며, 실행 중에 ROI 가 바뀌면
+// 남는 분기는 crop 만 바꾸고 모자라면 새로 붙이고 남으면 끝에서부터 떼어낸다.
+class RoiCropper {
+public:
+  struct Geometry {
+    int frame_width;   // tee 로 들어오는 원본 해상도
+    int frame_height;
+    int mux_width;     // streammux 출력 해상도
+    int mux_height;
+  };
+
+  RoiCropper(GstElement* pipeline, GstElement* tee, GstElement* streammux, uint32_t source_id, uint32_t first_pad,
+             uint32_t max_rois, const Geometry& geometry);
+  ~RoiCropper();
+
+  // 좌표는 프레임 안으로 잘리고 짝수로 맞춰진다. 개수 초과나 너무 작은 ROI 는 error 와 함께 false.
+  // 하나의 스레드(control lane)에서만 호출한다.
+  bool setRois(std::vector<app_common::RoiRect> rois, std::string& error);
+  std::vector<app_common::RoiRect> rois() const;
+  // ROI i 의 검출을 전체 프레임 좌표로 옮기는 변환 (streammux pad first_pad + i)
+  std::vector<app_common::RoiTransform> transforms() const;
+  uint32_t maxRois() const { return max_rois_; }
+
+  RoiCropper(const RoiCropper&) = delete;
+  RoiCropper& operator=(const RoiCropper&) = delete;
+
+private:
+  struct Slot {
+    GstElement* queue{nullptr};
+    GstElement* conv{nullptr};
+    GstElement* caps{nullptr};
+    GstPad* tee_pad{nullptr};
+    GstPad* mux_pad{nullptr};
+    app_common::RoiRect roi;
+  };
+
+  bool addSlot(const app_common::RoiRect& roi, std::string& error);
+  bool removeLastSlot();
+
+  GstElement* pipeline_;
+  GstElement* tee_;
+  GstElement* streammux_;
+  const uint32_t source_id_;
+  const uint32_t first_pad_;
+  const uint32_t max_rois_;
+  const Geometry geometry_;
+
+  mutable std::mutex mutex_;  // slots_ 의 roi 를 읽는 stats 용
+  std::vector<Slot> slots_;
+};
@@ -0,0 +1,86 @@
+#include "impl/camera/source_branch.hpp"
+
+#include <utility>
+
+#include "common/utils/logging.hpp"
+#include "config/camera_config.hpp"
+
+SourceBranch::SourceBranch(GstElement* pipeline, GstElement* streammux, uint32_t source_id, std::string uri)
+    : pipeline_(pipeline), streammux_(streammux), source_id_(source_id), uri_(std::move(uri)) {}
+
+SourceBranch::~SourceBranch() {
+  // element 들은 파이프라인이 정리한다
+  if (mux_pad_) gst_object_unref(mux_pad_);
+}
+
+GstElement* SourceBranch::makeElement(const char* factory, const char* role) {
+  const std::string name = std::string(role) + "_" + std::to_string(source_id_);
+  GstElement* element = gst_element_factory_make(factory, name.c_str());
+  if (!element) SPDLOG_SERVICE_ERROR("[Camera] element creation failed: {}", name);
+  return element;
+}
+
+bool SourceBranch::build() {
+  decoder_ = makeElement("uridecodebin", "uri_src");
+  queue_ = makeElement("queue", "src_queue");
+  conv_ = makeElement(app_config::kVideoConvertElement, "src_conv");
+  caps_ = makeElement("capsfilter", "src_caps");
+  if (!decoder_ || !queue_ || !conv_ || !caps_) return false;
+
+  GstCaps* decoded = gst_caps_from_string(app_config::kDecodedCaps);
+  g_object_set(decoder_, "uri", uri_.c_str(), "caps", decoded, nullptr);
+  gst_caps_unref(decoded);
+
+  // 추론이 밀리면 이 입력의 오래된 프레임부터 버린다 (다른 입력을 막지 않도록)
+  g_object_set(queue_, "max-size-buffers", app_config::kInferenceQueueDepth, "leaky", 2, nullptr);
+
+  GstCaps* caps = gst_caps_from_string(app_config::muxInputCaps().c_str());
+  g_object_set(caps_, "caps", caps, nullptr);
+  gst_caps_unref(caps);
+
+  gst_bin_add_many(GST_BIN(pipeline_), decoder_, queue_, conv_, caps_, nullptr);
+  if (!gst_element_link_many(queue_, conv_, caps_, nullptr)) {
+    SPDLOG_SERVICE_ERROR("[Camera] source {}: link queue -> caps fail!", source_id_);
+    return false;
+  }
+
+  const std::string mux_pad_name = "sink_" + std::to_string(source_id_);
+  mux_pad_ = gst_element_request_pad_simple(streammux_, mux_pad_name.c_str());
+  GstPad* caps_src = gst_element_get_static_pad(caps_, "src");
+  const bool linked = mux_pad_ && gst_pad_link(caps_src, mux_pad_) == GST_PAD_LINK_OK;
+  gst_object_unref(caps_src);
+  if (!linked) {
+    SPDLOG_SERVICE_ERROR("[Camera] source {}: link caps -> streammux {} fail!", source_id_, mux_pad_name);
+    return false;
+  }
+
+  g_signal_connect(decoder_, "pad-added", G_CALLBACK(onPadAdded), this);
+  g_signal_connect(decoder_, "autoplug-continue", G_CALLBACK(onAutoplugContinue), this);
+  SPDLOG_SERVICE_INFO("[Camera] source {} -> streammux {}: {}", source_id_, mux_pad_name, uri_);
+  return true;
+}
+
+gboolean SourceBranch::onAutoplugContinue(GstElement* /*bin*/, GstPad* /*pad*/, GstCaps* caps, gpointer /*user_data*/) {
+  // 오디오 스트림은 디코딩하지 않는다
+  const GstStructure* s = gst_caps_get_structure(caps, 0);
+  return !g_str_has_prefix(gst_structure_get_name(s), "audio/");
+}
+
+void SourceBranch::onPadAdded(GstElement* /*src*/, GstPad* new_pad, gpointer user_data) {
+  auto* self = static_cast<SourceBranch*>(user_data);
+
+  GstCaps* caps = gst_pad_get_current_caps(new_pad);
+  if (!caps) caps = gst_pad_query_caps(new_pad, nullptr);
+  const gchar* type = gst_structure_get_name(gst_caps_get_structure(caps, 0));
+  const bool is_video = g_str_has_prefix(type, "video/x-raw");
+  gst_caps_unref(caps);
+  if (!is_video) return;
+
+  GstPad* sink_pad = gst_element_get_static_pad(self->queue_, "sink");
+  if (gst_pad_is_linked(sink_pad)) {
+    SPDLOG_SERVICE_WARN("[Camera] source {}: queue is already linked", self->source_id_);
+  } else if (gst_pad_link(new_pad, sink_pad) != GST_PAD_LINK_OK) {
+    SPDLOG_SERVICE_ERROR("[Camera] source {}: failed to link decoded pad", self->source_id_);
+  }
+  gst_object_unref(sink_pad);
+}
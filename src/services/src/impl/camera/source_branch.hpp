@@ -0,0 +1,41 @@
+#pragma once
+
+#include <gst/gst.h>
+
+#include <cstdint>
+#include <string>
+
+// 0 번 이외의 입력 하나: uridecodebin -> queue -> convert -> capsfilter(muxInputCaps()) -> streammux sink_<source_id>.
+// 미리보기(shm) / input-selector 가 붙는 0 번 입력과 달리 추론 전용이고, DeepStream 프로파일에서는 변환 결과를 NVMM 에 그대로 둔다.
+class SourceBranch {
+public:
+  SourceBranch(GstElement* pipeline, GstElement* streammux, uint32_t source_id, std::string uri);
+  ~SourceBranch();
+
+  bool build();
+
+  uint32_t sourceId() const { return source_id_; }
+  const std::string& uri() const { return uri_; }
+  // uridecodebin 과 그 출력이 연결되는 queue (build 뒤에만 유효)
+  GstElement* decoder() const { return decoder_; }
+  GstElement* queue() const { return queue_; }
+
+  SourceBranch(const SourceBranch&) = delete;
+  SourceBranch& operator=(const SourceBranch&) = delete;
+
+private:
+  static void onPadAdded(GstElement* src, GstPad* new_pad, gpointer user_data);
+  static gboolean onAutoplugContinue(GstElement* bin, GstPad* pad, GstCaps* caps, gpointer user_data);
+  GstElement* makeElement(const char* factory, const char* role);
+
+  GstElement* pipeline_;
+  GstElement* streammux_;
+  const uint32_t source_id_;
+  const std::string uri_;
+
+  GstElement* decoder_{nullptr};
+  GstElement* queue_{nullptr};
+  GstElement* conv_{nullptr};
+  GstElement* caps_{nullptr};
+  GstPad* mux_pad_{nullptr};
+};
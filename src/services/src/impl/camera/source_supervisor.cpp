@@ -0,0 +1,282 @@
+#include "impl/camera/source_supervisor.hpp"
+
+#include <algorithm>
+
+#include "common/utils/logging.hpp"
+#include "config/zmq_config.hpp"
+
+namespace {
+double elapsedMs(std::chrono::steady_clock::time_point since) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+}  // namespace
+
+SourceSupervisor::SourceSupervisor(PubSocket& pub_socket, GstElement* pipeline, Duration initial_backoff,
+                                   Duration max_backoff)
+    : pub_socket_(pub_socket),
+      topic_metrics_(pub_socket.ensureTopic(app_config::kTopicMetrics)),
+      pipeline_(GST_ELEMENT(gst_object_ref(pipeline))),
+      initial_backoff_(initial_backoff),
+      max_backoff_(max_backoff),
+      pipeline_branch_(std::make_unique<Branch>(this, "pipeline", initial_backoff, max_backoff)),
+      thread_(&SourceSupervisor::run, this) {}
+
+SourceSupervisor::~SourceSupervisor() {
+  setEnabled(false);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  cv_.notify_one();
+  if (thread_.joinable()) thread_.join();
+
+  for (auto& source : sources_) {
+    if (source->probe_id) gst_pad_remove_probe(source->link_pad, source->probe_id);
+    gst_object_unref(source->link_pad);
+    gst_object_unref(source->decoder);
+  }
+  gst_object_unref(pipeline_);
+}
+
+void SourceSupervisor::addSource(uint32_t source_id, GstElement* decoder, GstPad* link_pad) {
+  if (!decoder || !link_pad) return;
+  auto source =
+      std::make_unique<Branch>(this, "source_" + std::to_string(source_id), initial_backoff_, max_backoff_);
+  source->decoder = GST_ELEMENT(gst_object_ref(decoder));
+  source->link_pad = GST_PAD(gst_object_ref(link_pad));
+  source->probe_id =
+      gst_pad_add_probe(source->link_pad, GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM,
+                        &SourceSupervisor::onProbe, source.get(), nullptr);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  sources_.push_back(std::move(source));
+}
+
+void SourceSupervisor::setEnabled(bool enabled) {
+  std::lock_guard<std::mutex> action(action_mutex_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (enabled_ == enabled) return;
+    enabled_ = enabled;
+    for (Branch* branch : branches()) {
+      branch->pending = false;
+      branch->recovering = false;
+      branch->awaiting_frame.store(false, std::memory_order_relaxed);
+    }
+  }
+  // 파이프라인을 새로 시작하면 running time 도 0 부터다
+  if (enabled) {
+    for (auto& source : sources_) gst_pad_set_offset(source->link_pad, 0);
+  }
+  SPDLOG_SERVICE_INFO("[Camera] source supervision {}", enabled ? "enabled" : "disabled");
+}
+
+bool SourceSupervisor::isEnabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return enabled_;
+}
+
+std::vector<SourceSupervisor::Branch*> SourceSupervisor::branches() const {
+  std::vector<Branch*> all{pipeline_branch_.get()};
+  for (const auto& source : sources_) all.push_back(source.get());
+  return all;
+}
+
+void SourceSupervisor::onError(GstObject* origin, const std::string& message) {
+  for (auto& source : sources_) {
+    if (origin && gst_object_has_as_ancestor(origin, GST_OBJECT(source->decoder))) {
+      schedule(*source, false, message);
+      return;
+    }
+  }
+  schedule(*pipeline_branch_, false, message);
+}
+
+void SourceSupervisor::onPipelineEos() { schedule(*pipeline_branch_, true, "eos"); }
+
+GstPadProbeReturn SourceSupervisor::onProbe(GstPad* /*pad*/, GstPadProbeInfo* info, gpointer user_data) {
+  auto& branch = *static_cast<Branch*>(user_data);
+
+  if (GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_BUFFER) {
+    branch.owner->onFrame(branch);
+    return GST_PAD_PROBE_OK;
+  }
+
+  // 입력 하나의 EOS 가 streammux / 싱크까지 내려가면 파이프라인 전체가 끝나므로 여기서 막고 그 입력만 다시 시작한다
+  GstEvent* event = GST_PAD_PROBE_INFO_EVENT(info);
+  if (event && GST_EVENT_TYPE(event) == GST_EVENT_EOS && branch.owner->schedule(branch, true, "eos")) {
+    return GST_PAD_PROBE_DROP;
+  }
+  return GST_PAD_PROBE_OK;
+}
+
+void SourceSupervisor::onFrame(Branch& branch) {
+  branch.frames.fetch_add(1, std::memory_order_relaxed);
+  pipeline_branch_->frames.fetch_add(1, std::memory_order_relaxed);
+  if (branch.awaiting_frame.load(std::memory_order_relaxed)) recordRecovery(branch);
+  if (pipeline_branch_->awaiting_frame.load(std::memory_order_relaxed)) recordRecovery(*pipeline_branch_);
+}
+
+void SourceSupervisor::recordRecovery(Branch& branch) {
+  if (!branch.awaiting_frame.exchange(false)) return;
+
+  double recovery_ms;
+  app_common::Json event;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!branch.recovering) return;
+    branch.recovering = false;
+    recovery_ms = elapsedMs(branch.failed_at);
+    branch.last_recovery_ms = recovery_ms;
+    branch.max_recovery_ms = std::max(branch.max_recovery_ms, recovery_ms);
+    event = {{"source", "camera.recovery"},
+             {"event", "recovered"},
+             {"branch", branch.name},
+             {"recovery_ms", recovery_ms},
+             {"restarts", branch.restarts}};
+  }
+  SPDLOG_SERVICE_INFO("[Camera] {} recovered in {:.0f} ms", branch.name, recovery_ms);
+  publish(std::move(event));
+}
+
+bool SourceSupervisor::schedule(Branch& branch, bool eos, const std::string& reason) {
+  Duration delay{0};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_) return false;
+    ++(eos ? branch.eos : branch.errors);
+    branch.last_reason = reason;
+    if (branch.pending) return true;
+
+    // 재시작 뒤 프레임이 나왔다면 이번 실패는 처음부터 센다. 다 재생한 파일의 EOS 는 기다리지 않고 되감는다
+    const bool healthy = branch.frames.load(std::memory_order_relaxed) > branch.frames_at_restart;
+    if (eos && healthy) {
+      branch.backoff.reset();
+    } else {
+      delay = branch.backoff.next(healthy);
+    }
+    if (!branch.recovering) {
+      branch.recovering = true;
+      branch.failed_at = Clock::now();
+    }
+    branch.pending = true;
+    branch.due = Clock::now() + delay;
+  }
+  cv_.notify_one();
+  SPDLOG_SERVICE_WARN("[Camera] {} {}: restarting in {} ms", branch.name, reason, delay.count());
+  return true;
+}
+
+void SourceSupervisor::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    Branch* next = nullptr;
+    for (Branch* branch : branches()) {
+      if (branch->pending && (!next || branch->due < next->due)) next = branch;
+    }
+    if (!next) {
+      cv_.wait(lock);
+      continue;
+    }
+    if (next->due > Clock::now()) {
+      cv_.wait_until(lock, next->due);
+      continue;
+    }
+    next->pending = false;
+
+    lock.unlock();
+    const bool ok = restart(*next);
+    lock.lock();
+
+    if (!ok && enabled_ && !next->pending) {
+      const Duration delay = next->backoff.next(false);
+      next->pending = true;
+      next->due = Clock::now() + delay;
+      SPDLOG_SERVICE_WARN("[Camera] {} restart failed, retrying in {} ms", next->name, delay.count());
+    }
+  }
+}
+
+bool SourceSupervisor::restart(Branch& branch) {
+  std::lock_guard<std::mutex> action(action_mutex_);
+  app_common::Json event{{"source", "camera.recovery"}, {"event", "restart"}, {"branch", branch.name}};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_) return true;
+    ++branch.restarts;
+    branch.frames_at_restart = branch.frames.load(std::memory_order_relaxed);
+    event["reason"] = branch.last_reason;
+    event["restarts"] = branch.restarts;
+    event["failures"] = branch.backoff.failures();
+  }
+
+  const bool ok = branch.decoder ? restartSource(branch) : restartPipeline();
+  SPDLOG_SERVICE_INFO("[Camera] {} restart #{} {}", branch.name, event["restarts"].get<uint64_t>(),
+                      ok ? "done" : "failed");
+  event["ok"] = ok;
+  publish(std::move(event));
+  return ok;
+}
+
+bool SourceSupervisor::restartSource(Branch& branch) {
+  // NULL 로 내리면 uridecodebin 이 내부 source / decodebin 과 출력 pad 를 버리고, 다시 올리면 pad-added 로 새로 연결된다
+  gst_element_set_state(branch.decoder, GST_STATE_NULL);
+  // 이전 디코더의 buffer 는 더 오지 않으니 이제부터 오는 첫 프레임이 복구된 프레임이다
+  branch.awaiting_frame.store(true);
+
+  // 새 segment 는 0 부터 시작하므로 지금의 running time 만큼 미뤄 뒤쪽 요소의 시계와 맞춘다
+  gst_pad_set_offset(branch.link_pad, static_cast<gint64>(runningTime()));
+  const GstStateChangeReturn ret = gst_element_set_state(branch.decoder, GST_STATE_PAUSED);
+  if (ret == GST_STATE_CHANGE_FAILURE) return false;
+  // live 입력은 running time 기준 timestamp 를 내보낸다
+  if (ret == GST_STATE_CHANGE_NO_PREROLL) gst_pad_set_offset(branch.link_pad, 0);
+
+  return gst_element_sync_state_with_parent(branch.decoder);
+}
+
+bool SourceSupervisor::restartPipeline() {
+  gst_element_set_state(pipeline_, GST_STATE_NULL);
+  pipeline_branch_->awaiting_frame.store(true);
+  {
+    // 입력들도 함께 다시 시작되므로 따로 예약된 재시작은 버리고, 복구 중이던 입력은 이번 재시작으로 복구 시간을 잰다
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& source : sources_) {
+      source->pending = false;
+      if (source->recovering) source->awaiting_frame.store(true);
+      gst_pad_set_offset(source->link_pad, 0);
+    }
+  }
+  return gst_element_set_state(pipeline_, GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE;
+}
+
+GstClockTime SourceSupervisor::runningTime() const {
+  GstClock* clock = gst_element_get_clock(pipeline_);
+  if (!clock) return 0;
+  const GstClockTime now = gst_clock_get_time(clock);
+  gst_object_unref(clock);
+
+  const GstClockTime base_time = gst_element_get_base_time(pipeline_);
+  return now > base_time ? now - base_time : 0;
+}
+
+void SourceSupervisor::publish(app_common::Json event) {
+  if (pub_socket_.hasSubscribers(topic_metrics_)) pub_socket_.publish(topic_metrics_, event.dump());
+}
+
+app_common::Json SourceSupervisor::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto branches_json = app_common::Json::array();
+  for (const Branch* branch : branches()) {
+    branches_json.push_back({{"branch", branch->name},
+                             {"frames", branch->frames.load(std::memory_order_relaxed)},
+                             {"restarts", branch->restarts},
+                             {"eos", branch->eos},
+                             {"errors", branch->errors},
+                             {"failures", branch->backoff.failures()},
+                             {"pending", branch->pending},
+                             {"last_reason", branch->last_reason},
+                             {"last_recovery_ms", branch->last_recovery_ms},
+                             {"max_recovery_ms", branch->max_recovery_ms}});
+  }
+  return {{"enabled", enabled_}, {"branches", branches_json}};
+}
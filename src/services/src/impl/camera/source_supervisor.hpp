@@ -0,0 +1,108 @@
+#pragma once
+
+#include <gst/gst.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "common/utils/json.hpp"
+#include "common/utils/restart_backoff.hpp"
+#include "common/zmq/pub_socket.hpp"
+
+// 입력(uridecodebin) 단위로 ERROR / EOS 를 복구한다.
+//   - 입력 안에서 난 ERROR, 입력의 EOS: 그 uridecodebin 만 NULL 로 내렸다가 다시 올린다. 뒤의 queue, tee, front_shm,
+//     streammux, appsink 는 그대로 PLAYING 이다. 파일 입력은 EOS 를 아래로 보내지 않고 처음부터 다시 재생한다.
+//   - 그 밖의 ERROR 나 파이프라인 EOS: 파이프라인 전체를 NULL -> PLAYING 으로 다시 시작한다.
+// 재시작 사이 간격은 RestartBackoff 를 따른다. 재시작 뒤 첫 프레임까지 걸린 시간을 복구 시간으로 잰다.
+class SourceSupervisor {
+public:
+  using Duration = app_common::RestartBackoff::Duration;
+
+  SourceSupervisor(PubSocket& pub_socket, GstElement* pipeline, Duration initial_backoff, Duration max_backoff);
+  ~SourceSupervisor();
+
+  // 켜기 전에만 호출한다. link_pad 는 decoder 의 출력이 연결되는 pad (입력 queue 의 sink).
+  void addSource(uint32_t source_id, GstElement* decoder, GstPad* link_pad);
+
+  // 파이프라인이 NULL 일 때 켜고, 파이프라인을 내리기 전에 끈다. 끄면 예약된 재시작은 버리고 진행 중인 재시작은 끝날 때까지 기다린다.
+  void setEnabled(bool enabled);
+  bool isEnabled() const;
+
+  // 버스 스레드에서 호출한다.
+  void onError(GstObject* origin, const std::string& message);
+  void onPipelineEos();
+
+  app_common::Json stats() const;
+
+  SourceSupervisor(const SourceSupervisor&) = delete;
+  SourceSupervisor& operator=(const SourceSupervisor&) = delete;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Branch {
+    Branch(SourceSupervisor* owner, std::string name, Duration initial, Duration max)
+        : owner(owner), name(std::move(name)), backoff(initial, max) {}
+
+    SourceSupervisor* owner;
+    const std::string name;
+    GstElement* decoder{nullptr};  // 파이프라인 전체면 nullptr
+    GstPad* link_pad{nullptr};
+    gulong probe_id{0};
+    std::atomic<uint64_t> frames{0};
+    std::atomic<bool> awaiting_frame{false};
+
+    // mutex_ 로 보호
+    app_common::RestartBackoff backoff;
+    bool pending{false};
+    Clock::time_point due;
+    bool recovering{false};
+    Clock::time_point failed_at;
+    uint64_t frames_at_restart{0};
+    uint64_t restarts{0};
+    uint64_t eos{0};
+    uint64_t errors{0};
+    std::string last_reason;
+    double last_recovery_ms{0.0};
+    double max_recovery_ms{0.0};
+  };
+
+  // pipeline_branch_ 와 sources_. mutex_ 를 잡고 부르거나 켜진 뒤에만 부른다.
+  std::vector<Branch*> branches() const;
+  static GstPadProbeReturn onProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
+  void onFrame(Branch& branch);
+  void recordRecovery(Branch& branch);
+
+  // 재시작을 예약한다. 꺼져 있으면 false.
+  bool schedule(Branch& branch, bool eos, const std::string& reason);
+  void run();
+  bool restart(Branch& branch);
+  bool restartSource(Branch& branch);
+  bool restartPipeline();
+  GstClockTime runningTime() const;
+  void publish(app_common::Json event);
+
+  PubSocket& pub_socket_;
+  PubSocket::TopicId topic_metrics_;
+  GstElement* pipeline_;
+  const Duration initial_backoff_;
+  const Duration max_backoff_;
+  std::unique_ptr<Branch> pipeline_branch_;
+  std::vector<std::unique_ptr<Branch>> sources_;
+
+  // 재시작(상태 변경)은 한 번에 하나. action_mutex_ -> mutex_ 순서로 잡는다.
+  std::mutex action_mutex_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool enabled_{false};
+  bool running_{true};
+  std::thread thread_;
+};
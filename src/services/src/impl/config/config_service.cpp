@@ -0,0 +1,88 @@
+#include "services/config/config_service.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include "common/utils/logging.hpp"
+#include "config/app_config.hpp"
+
+namespace {
+app_common::Json failed(const std::string& msg) {
+  return {{"ok", false}, {"msg", msg}, {"results", app_common::Json::array()}};
+}
+}  // namespace
+
+ConfigService::ConfigService(LivePropertyTarget& camera, std::string path)
+    : camera_(camera),
+      watcher_(std::move(path), std::chrono::milliseconds(app_config::kRuntimeConfigPollMs),
+               [this](const std::string& text) {
+                 const auto result = applyText(text);
+                 if (result.value("ok", false)) {
+                   SPDLOG_SERVICE_INFO("[Config] applied {}: {}", watcher_.path(), result["results"].dump());
+                 } else {
+                   SPDLOG_SERVICE_ERROR("[Config] {} not fully applied: {}", watcher_.path(), result.dump());
+                 }
+               }) {}
+
+ConfigService::~ConfigService() { stop(); }
+
+void ConfigService::start() { watcher_.start(); }
+
+void ConfigService::stop() { watcher_.stop(); }
+
+app_common::Json ConfigService::set(const std::string& key, const std::string& value) {
+  app_common::RuntimeSetting setting;
+  std::string error;
+  if (!app_common::parseRuntimeSetting(key, value, setting, error)) return failed(error);
+  return apply({setting});
+}
+
+app_common::Json ConfigService::reload() {
+  std::ifstream file(path());
+  if (!file) return failed(path() + ": cannot open");
+  std::ostringstream text;
+  text << file.rdbuf();
+  return applyText(text.str());
+}
+
+app_common::Json ConfigService::applyText(const std::string& text) {
+  std::vector<app_common::RuntimeSetting> settings;
+  std::string error;
+  if (!app_common::parseRuntimeConfig(text, settings, error)) return failed(path() + ": " + error);
+  return apply(settings);
+}
+
+bool ConfigService::check(const app_common::RuntimeSetting& setting, std::string& error) const {
+  if (setting.target != app_common::kLogTarget) {
+    return camera_.checkLiveProperty(setting.target, setting.key, setting.value, error);
+  }
+  if (!app_common::getLogger(setting.key)) {
+    error = setting.path() + ": no such logger";
+    return false;
+  }
+  return true;
+}
+
+app_common::Json ConfigService::apply(const std::vector<app_common::RuntimeSetting>& settings) {
+  std::lock_guard<std::mutex> lock(apply_mutex_);
+
+  std::string error;
+  for (const auto& setting : settings) {
+    if (!check(setting, error)) return failed(error);
+  }
+
+  // 각 항목은 buffer 사이에서 하나씩 적용된다. 적용 도중 실패(시간 초과)는 항목별로 알린다
+  bool all_ok = true;
+  app_common::Json results = app_common::Json::array();
+  for (const auto& setting : settings) {
+    error.clear();
+    const bool ok = setting.target == app_common::kLogTarget
+                        ? app_common::setLogLevel(setting.key, setting.value, error)
+                        : camera_.setLiveProperty(setting.target, setting.key, setting.value, error);
+    all_ok = all_ok && ok;
+    results.push_back({{"key", setting.path()}, {"value", setting.value}, {"ok", ok}, {"msg", ok ? "applied" : error}});
+  }
+  return {{"ok", all_ok}, {"msg", all_ok ? "applied" : "some settings failed"}, {"results", std::move(results)}};
+}
@@ -0,0 +1,144 @@
+#include "services/control/command_registry.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+const char* typeName(ArgType type) {
+  switch (type) {
+    case ArgType::String:
+      return "string";
+    case ArgType::Int:
+      return "int";
+    case ArgType::Number:
+      return "number";
+    case ArgType::Bool:
+      return "bool";
+  }
+  return "unknown";
+}
+
+bool matches(ArgType type, const app_common::Json& value) {
+  switch (type) {
+    case ArgType::String:
+      return value.is_string();
+    case ArgType::Int:
+      return value.is_number_integer();
+    case ArgType::Number:
+      return value.is_number();
+    case ArgType::Bool:
+      return value.is_boolean();
+  }
+  return false;
+}
+
+bool convertLegacy(ArgType type, const std::string& text, app_common::Json& out) {
+  switch (type) {
+    case ArgType::String:
+      out = text;
+      return true;
+    case ArgType::Int: {
+      char* end = nullptr;
+      errno = 0;
+      long long value = std::strtoll(text.c_str(), &end, 10);
+      if (text.empty() || *end != '\0' || errno != 0) return false;
+      out = value;
+      return true;
+    }
+    case ArgType::Number: {
+      char* end = nullptr;
+      double value = std::strtod(text.c_str(), &end);
+      if (text.empty() || *end != '\0') return false;
+      out = value;
+      return true;
+    }
+    case ArgType::Bool:
+      if (text != "true" && text != "false") return false;
+      out = (text == "true");
+      return true;
+  }
+  return false;
+}
+}  // namespace
+
+void CommandRegistry::add(const std::string& name, std::initializer_list<ArgSpec> args, bool async, Handler handler) {
+  if (name.empty() || name.find(':') != std::string::npos) {
+    throw std::invalid_argument("invalid command name: " + name);
+  }
+  if (!handler) throw std::invalid_argument("command without handler: " + name);
+
+  std::vector<ArgSpec> specs(args);
+  for (std::size_t i = 0; i < specs.size(); ++i) {
+    if (specs[i].name.empty()) throw std::invalid_argument("empty argument name in " + name);
+    for (std::size_t j = 0; j < i; ++j) {
+      if (specs[i].name == specs[j].name) {
+        throw std::invalid_argument("duplicate argument " + specs[i].name + " in " + name);
+      }
+    }
+  }
+
+  Command command{name, std::move(specs), async, std::move(handler), owner_};
+  if (!commands_.emplace(name, std::move(command)).second) {
+    throw std::invalid_argument("duplicate command: " + name);
+  }
+}
+
+const CommandRegistry::Command* CommandRegistry::find(const std::string& name) const {
+  auto it = commands_.find(name);
+  return it == commands_.end() ? nullptr : &it->second;
+}
+
+bool CommandRegistry::validate(const Command& command, const app_common::Json& args, std::string& error) {
+  if (!args.is_null() && !args.is_object()) {
+    error = "args must be an object";
+    return false;
+  }
+
+  std::size_t known = 0;
+  for (const auto& spec : command.args) {
+    auto it = args.is_object() ? args.find(spec.name) : args.end();
+    if (!args.is_object() || it == args.end()) {
+      if (spec.required) {
+        error = "missing argument: " + spec.name;
+        return false;
+      }
+      continue;
+    }
+    if (!matches(spec.type, *it)) {
+      error = "argument " + spec.name + " must be " + typeName(spec.type);
+      return false;
+    }
+    ++known;
+  }
+
+  if (args.is_object() && args.size() != known) {
+    error = "unknown argument for " + command.name;
+    return false;
+  }
+  return true;
+}
+
+bool CommandRegistry::parseLegacy(const std::string& text, const Command*& command, app_common::Json& args,
+                                  std::string& error) const {
+  auto pos = text.find(':');
+  command = find(text.substr(0, pos));
+  if (!command) {
+    error = "unknown command";
+    return false;
+  }
+
+  args = app_common::Json::object();
+  if (pos == std::string::npos) return true;
+
+  if (command->args.empty()) {
+    error = command->name + " takes no argument";
+    return false;
+  }
+  const auto& spec = command->args.front();
+  if (!convertLegacy(spec.type, text.substr(pos + 1), args[spec.name])) {
+    error = "argument " + spec.name + " must be " + typeName(spec.type);
+    return false;
+  }
+  return true;
+}
@@ -1,53 +1,171 @@
 #include "services/control/control_service.hpp"
 
+#include <exception>
+
 #include "adapters/audio/audio_service_adapter.hpp"
 #include "adapters/bluetooth/bluetooth_service_adapter.hpp"
 #include "adapters/camera/camera_service_adapter.hpp"
+#include "adapters/config/config_service_adapter.hpp"
+#include "adapters/event/event_bus_adapter.hpp"
 #include "adapters/i_service.hpp"
+#include "adapters/infer/ai_service_adapter.hpp"
 #include "adapters/music/music_service_adapter.hpp"
-#include "common/utils/json.hpp"
 #include "common/utils/logging.hpp"
 #include "config/zmq_config.hpp"
 
-ControlService::ControlService(RepSocket& rep_socket) : rep_socket_(rep_socket) {}
+struct ControlService::Lane {
+  explicit Lane(std::unique_ptr<IService> svc) : service(std::move(svc)) {}
+
+  std::unique_ptr<IService> service;
+  std::mutex exec_mutex;  // 서비스 호출은 한 번에 하나만
+  // lane 에 넣었지만 아직 끝나지 않은 작업 수 (대기 + 실행 중). 작업 사이에는 exec_mutex 가 비므로
+  // inline 실행 여부는 mutex 가 아니라 이것으로 정한다.
+  std::atomic<int> in_flight{0};
+  app_common::SerialWorker worker;
+};
+
+ControlService::ControlService(RouterSocket& router_socket, PubSocket& pub_socket)
+    : router_socket_(router_socket),
+      pub_socket_(pub_socket),
+      topic_job_(pub_socket.ensureTopic(app_config::kTopicJob)) {}
+
+// lane 의 작업 스레드가 먼저 끝나야 하므로 Lane 정의가 보이는 여기서 소멸시킨다
+ControlService::~ControlService() = default;
+
+void ControlService::addService(std::unique_ptr<IService> service) {
+  registry_.setOwner(lanes_.size());
+  service->registerCommands(registry_);
+  lanes_.push_back(std::make_unique<Lane>(std::move(service)));
+}
 
-void ControlService::registerMusicService(MusicService& svc) { services_.push_back(new MusicServiceAdapter(svc)); }
+void ControlService::registerMusicService(MusicService& svc) { addService(std::make_unique<MusicServiceAdapter>(svc)); }
 
-void ControlService::registerCameraService(CameraService& svc) { services_.push_back(new CameraServiceAdapter(svc)); }
+void ControlService::registerCameraService(CameraService& svc) {
+  addService(std::make_unique<CameraServiceAdapter>(svc));
+}
 
 void ControlService::registerBluetoothService(BluetoothService& svc) {
-  services_.push_back(new BluetoothServiceAdapter(svc));
+  addService(std::make_unique<BluetoothServiceAdapter>(svc));
 }
 
-void ControlService::registerAudioService(AudioService& svc) { services_.push_back(new AudioServiceAdapter(svc)); }
+void ControlService::registerAudioService(AudioService& svc) { addService(std::make_unique<AudioServiceAdapter>(svc)); }
+
+void ControlService::registerAiService(AiService& svc) { addService(std::make_unique<AiServiceAdapter>(svc)); }
+
+void ControlService::registerEventBus(PubSocket& pub_socket) {
+  addService(std::make_unique<EventBusAdapter>(pub_socket));
+}
+
+void ControlService::registerConfigService(ConfigService& svc) {
+  addService(std::make_unique<ConfigServiceAdapter>(svc));
+}
 
 void ControlService::poll() {
-  zmq::pollitem_t items[] = {{rep_socket_.handle(), 0, ZMQ_POLLIN, 0}};
+  zmq::pollitem_t items[] = {{router_socket_.handle(), 0, ZMQ_POLLIN, 0}};
 
   while (true) {
     zmq::poll(items, 1, -1);
 
     if (items[0].revents & ZMQ_POLLIN) {
-      auto cmd = rep_socket_.receive().value_or("");
-      if (!cmd.empty()) {
-        SPDLOG_SERVICE_INFO("Received cmd: {}", cmd);
-      }
+      auto request = router_socket_.receive();
+      if (request) dispatch(*request);
+    }
+  }
+}
 
-      app_common::Json reply;
-      bool handled = false;
+void ControlService::dispatch(RouterSocket::Request& request) {
+  const std::string& body = request.body;
+  if (!body.empty()) {
+    SPDLOG_SERVICE_INFO("Received cmd: {}", body);
+  }
 
-      for (auto* svc : services_) {
-        if (svc->handle(cmd, reply)) {
-          handled = true;
-          break;
-        }
+  app_common::Json reply;
+  if (!body.empty() && body.front() == '{') {
+    auto message = app_common::Json::parse(body, nullptr, false);
+    if (message.is_discarded() || !message.is_object()) {
+      reply = {{"ok", false}, {"msg", "invalid json"}};
+    } else if (message.contains("batch")) {
+      const auto& batch = message["batch"];
+      if (!batch.is_array()) {
+        reply = {{"ok", false}, {"msg", "batch must be an array"}};
+      } else {
+        // 같은 서비스의 명령은 lane 을 거치므로 batch 안의 순서가 유지된다
+        app_common::Json results = app_common::Json::array();
+        for (const auto& call : batch) results.push_back(runCall(call));
+        reply = {{"ok", true}, {"results", std::move(results)}};
       }
+    } else {
+      reply = runCall(message);
+    }
+  } else {
+    const CommandRegistry::Command* command = nullptr;
+    app_common::Json args;
+    std::string error;
+    if (registry_.parseLegacy(body, command, args, error)) {
+      reply = run(*command, std::move(args));
+    } else {
+      reply = {{"ok", false}, {"msg", error}};
+    }
+  }
 
-      if (!handled) {
-        reply = {{"ok", false}, {"msg", "unknown command"}};
-      }
+  router_socket_.send(request, reply.dump());
+}
+
+app_common::Json ControlService::runCall(const app_common::Json& call) {
+  if (!call.is_object() || !call.contains("cmd") || !call["cmd"].is_string()) {
+    return {{"ok", false}, {"msg", "cmd must be a string"}};
+  }
+
+  const auto* command = registry_.find(call["cmd"].get_ref<const std::string&>());
+  if (!command) return {{"ok", false}, {"msg", "unknown command"}};
+
+  return run(*command, call.value("args", app_common::Json::object()));
+}
+
+app_common::Json ControlService::run(const CommandRegistry::Command& command, app_common::Json args) {
+  std::string error;
+  if (!CommandRegistry::validate(command, args, error)) return {{"ok", false}, {"msg", error}};
+  if (args.is_null()) args = app_common::Json::object();
 
-      rep_socket_.send(reply.dump());
+  Lane& lane = *lanes_[command.owner];
+  if (command.async) return submit(lane, command, std::move(args));
+
+  // 같은 서비스의 작업이 대기 중이거나 실행 중이면 앞지르지 않고 그 뒤에 줄을 세운다.
+  // lane 에 작업을 넣는 것은 이 (poll) 스레드뿐이므로 0 을 본 뒤에는 새 작업이 끼어들 수 없다.
+  if (lane.in_flight.load(std::memory_order_acquire) > 0) return submit(lane, command, std::move(args));
+
+  app_common::Json reply;
+  std::lock_guard<std::mutex> lock(lane.exec_mutex);
+  execute(command, args, reply);
+  return reply;
+}
+
+app_common::Json ControlService::submit(Lane& lane, const CommandRegistry::Command& command, app_common::Json args) {
+  const uint64_t job_id = next_job_id_.fetch_add(1, std::memory_order_relaxed) + 1;
+
+  lane.in_flight.fetch_add(1, std::memory_order_relaxed);
+  lane.worker.post([this, &lane, &command, args = std::move(args), job_id] {
+    app_common::Json result;
+    {
+      std::lock_guard<std::mutex> lock(lane.exec_mutex);
+      execute(command, args, result);
     }
+    lane.in_flight.fetch_sub(1, std::memory_order_release);
+
+    SPDLOG_SERVICE_INFO("Job {} finished: cmd={}, ok={}", job_id, command.name, result.value("ok", false));
+    app_common::Json event = {{"job_id", job_id}, {"cmd", command.name}, {"result", std::move(result)}};
+    pub_socket_.publish(topic_job_, event.dump());
+  });
+
+  return {{"ok", true}, {"msg", "accepted"}, {"job_id", job_id}};
+}
+
+void ControlService::execute(const CommandRegistry::Command& command, const app_common::Json& args,
+                             app_common::Json& reply) {
+  try {
+    command.handler(args, reply);
+  } catch (const std::exception& e) {
+    SPDLOG_SERVICE_ERROR("Command failed: cmd={}, error={}", command.name, e.what());
+    reply = {{"ok", false}, {"msg", e.what()}};
   }
 }
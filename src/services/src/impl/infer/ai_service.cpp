@@ -3,13 +3,83 @@
 #include <gst/video/video.h>
 #include <gstnvdsmeta.h>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <stdexcept>
 
-#include "common/utils/json.hpp"
+#include "common/infer/detection_json_writer.hpp"
 #include "common/utils/logging.hpp"
+#include "config/camera_config.hpp"
+#include "config/infer_config.hpp"
 #include "config/zmq_config.hpp"
 
-AiService::AiService(GstElement* appsink_elem, PubSocket& pub_socket) : pub_socket_(pub_socket) {
+namespace {
+constexpr auto kConsumerWaitTimeout = std::chrono::milliseconds(100);
+constexpr auto kDropReportInterval = std::chrono::seconds(5);
+// 늦게 붙은 구독자도 라벨 테이블을 받을 수 있도록 주기적으로 재전송
+constexpr uint32_t kLabelResendInterval = 300;
+// 한 배치에서 살펴보는 최대 프레임 수 (입력별 전체 프레임 + ROI)
+constexpr std::size_t kMaxBatchFrames = 16;
+
+app_common::PostFilterConfig defaultPostFilter() {
+  app_common::PostFilterConfig config;
+  config.min_confidence = app_config::kPostFilterMinConfidence;
+  config.min_area = app_config::kPostFilterMinArea;
+  config.nms_iou = app_config::kPostFilterNmsIou;
+  std::string error;
+  if (!app_common::parseClassThresholds(app_config::kPostFilterClassConfidence, config.class_confidence, error) ||
+      !app_common::parseClassList(app_config::kPostFilterClasses, config.allowed_classes, error) ||
+      !app_common::validatePostFilter(config, error)) {
+    throw std::runtime_error("invalid post filter config: " + error);
+  }
+  return config;
+}
+
+void appendObjects(app_common::DetectionFrame& frame, const NvDsFrameMeta* frame_meta,
+                   const app_common::RoiTransform& transform) {
+  for (NvDsMetaList* l_obj = frame_meta->obj_meta_list; l_obj != NULL; l_obj = l_obj->next) {
+    if (frame.num_objects == app_common::kMaxDetectionsPerFrame) break;
+
+    const auto* obj_meta = static_cast<const NvDsObjectMeta*>(l_obj->data);
+    app_common::Detection& det = frame.objects[frame.num_objects++];
+    det.class_id = obj_meta->class_id;
+    det.confidence = obj_meta->confidence;
+    det.x = obj_meta->rect_params.left;
+    det.y = obj_meta->rect_params.top;
+    det.w = obj_meta->rect_params.width;
+    det.h = obj_meta->rect_params.height;
+    app_common::copyLabel(det.label, obj_meta->obj_label);
+    det.track_id = 0;
+    transform.apply(det);
+  }
+}
+
+void inspectFrame(GstSample* sample) {
+  GstCaps* caps = gst_sample_get_caps(sample);
+  GstVideoInfo vinfo;
+  if (!caps || !gst_video_info_from_caps(&vinfo, caps)) SPDLOG_SERVICE_INFO("[caps] (no/invalid caps)");
+}
+}  // namespace
+
+AiService::AiService(GstElement* appsink_elem, PubSocket& pub_socket, CameraService::InferenceSinkMode sink_mode,
+                     app_common::OverflowPolicy overflow_policy, std::size_t queue_capacity)
+    : pub_socket_(pub_socket),
+      sink_mode_(sink_mode),
+      queue_(queue_capacity, overflow_policy),
+      sources_(app_config::kMaxCameraSources),
+      topic_detections_(pub_socket.ensureTopic(app_config::kTopicDetections)),
+      topic_detections_binary_(pub_socket.ensureTopic(app_config::kTopicDetectionsBinary)),
+      topic_detection_labels_(pub_socket.ensureTopic(app_config::kTopicDetectionLabels)),
+      topic_tracks_(pub_socket.ensureTopic(app_config::kTopicTracks)),
+      tracking_(app_config::kTrackerEnabled),
+      output_mode_(app_config::kTrackDeltaOutput ? OutputMode::Delta : OutputMode::Full),
+      filter_config_(defaultPostFilter()),
+      lanes_(app_config::kMaxCameraSources, kMaxInFlightFrames,
+             {[this](uint32_t source_id, FrameJob& job) { return filterStage(source_id, job); },
+              [this](uint32_t source_id, FrameJob& job) { return serializeStage(source_id, job); },
+              [this](uint32_t source_id, FrameJob& job) { return publishStage(source_id, job); }}) {
+  sources_[0].last_frame = std::make_unique<app_common::DetectionFrame>();
   attach(appsink_elem);
 }
 
@@ -19,23 +89,326 @@ AiService::~AiService() {
 }
 
 void AiService::start() {
-  running_ = true;
+  if (running_.exchange(true)) return;
   processing_thread_ = std::thread([this] { run(); });
 }
 
 void AiService::stop() {
   running_ = false;
+  wakeConsumer();
   if (processing_thread_.joinable()) processing_thread_.join();
+  lanes_.wait();
 }
 
+// 소비자 스레드는 큐에서 꺼낸 프레임을 source 별 lane 으로 넘기기만 하고, 후처리는 TBB worker 가 한다.
+// 풀이 비었거나 할 일이 없으면 wait() 로 남은 job 을 직접 처리한다 (worker 가 없는 단일 코어 대비).
 void AiService::run() {
   SPDLOG_SERVICE_INFO("[AI] Service ready (publishing results)");
-  int job;
-  app_common::Json inference_result;
+  auto last_report = std::chrono::steady_clock::now();
+  uint64_t last_dropped = 0;
 
   while (running_) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    FrameJob* job = lanes_.acquire();
+    if (!job) {
+      lanes_.wait();
+      continue;
+    }
+
+    if (queue_.pop([job](const app_common::DetectionFrame& frame) { app_common::copyFrame(job->frame, frame); })) {
+      job->republish = false;
+      lanes_.submit(job->frame.source_id, job);
+    } else if (pending_static_frames_.exchange(0, std::memory_order_acquire) > 0) {
+      // 밀린 정적 프레임이 여러 개여도 가장 최근 timestamp 로 한 번만 보낸다
+      job->republish = true;
+      job->frame.source_id = 0;
+      job->frame.timestamp = static_timestamp_.load(std::memory_order_relaxed);
+      lanes_.submit(0, job);
+    } else {
+      lanes_.release(job);
+      lanes_.wait();
+      std::unique_lock<std::mutex> lock(wait_mutex_);
+      consumer_waiting_.store(true);
+      wait_cv_.wait_for(lock, kConsumerWaitTimeout,
+                        [this] { return !queue_.empty() || pending_static_frames_.load() > 0 || !running_; });
+      consumer_waiting_.store(false);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_report >= kDropReportInterval) {
+      uint64_t dropped = queue_.dropped();
+      if (dropped != last_dropped) {
+        SPDLOG_SERVICE_WARN("[AI] detection queue overflow: dropped_oldest={}, dropped_newest={}",
+                            queue_.droppedOldest(), queue_.droppedNewest());
+        last_dropped = dropped;
+      }
+      last_report = now;
+    }
+  }
+
+  SPDLOG_SERVICE_INFO("[AI] Service stopped");
+}
+
+void AiService::onStaticFrame(uint64_t timestamp) {
+  if (static_policy_.load(std::memory_order_relaxed) == StaticFramePolicy::Suppress) return;
+  static_timestamp_.store(timestamp, std::memory_order_relaxed);
+  pending_static_frames_.fetch_add(1, std::memory_order_release);
+  wakeConsumer();
+}
+
+// 정적 프레임 job 은 source 0 lane 에서 앞선 프레임들 뒤에 처리되므로
+// 마지막 결과는 정적 프레임 직전에 추론한 프레임이다. frame_number 는 그대로 두고 timestamp 만 바꾼다.
+bool AiService::restoreLastFrame(SourceState& source, FrameJob& job) {
+  if (!source.has_last_frame || static_policy_.load(std::memory_order_relaxed) != StaticFramePolicy::Republish) {
+    return false;
+  }
+  const uint64_t timestamp = job.frame.timestamp;
+  app_common::copyFrame(job.frame, *source.last_frame);
+  job.frame.timestamp = timestamp;
+  return true;
+}
+
+void AiService::setRoiTransforms(const std::vector<app_common::RoiTransform>& by_pad) {
+  std::lock_guard<std::mutex> lock(roi_mutex_);
+  roi_transforms_ = by_pad;
+}
+
+// ROI crop 은 주 입력에서 나오므로 함께 센다. 추론 전용 입력의 객체는 추론 fps 조절에 쓰지 않는다.
+void AiService::reportActivity(NvDsBatchMeta* batch_meta) {
+  std::lock_guard<std::mutex> lock(roi_mutex_);
+  for (NvDsMetaList* l_frame = batch_meta->frame_meta_list; l_frame != NULL; l_frame = l_frame->next) {
+    const auto* frame_meta = static_cast<const NvDsFrameMeta*>(l_frame->data);
+    if (frame_meta->pad_index < roi_transforms_.size() && roi_transforms_[frame_meta->pad_index].source_id == 0) {
+      activity_listener_(frame_meta->num_obj_meta);
+    }
+  }
+}
+
+// 같은 source 의 같은 PTS 프레임(전체 프레임 + ROI crop)을 하나로 합쳐 큐에 넣는다.
+// ROI 검출은 전체 프레임 좌표로 옮겨지고, frame_number 는 pad 번호가 가장 작은 프레임(전체 프레임)을 따른다.
+// 변환표에 없는 pad 의 프레임(ROI 가 바뀌는 중)은 좌표를 알 수 없으므로 버린다.
+bool AiService::pushBatch(NvDsBatchMeta* batch_meta) {
+  std::array<const NvDsFrameMeta*, kMaxBatchFrames> frames{};
+  std::array<app_common::BatchFrame, kMaxBatchFrames> keys{};
+  std::array<int, kMaxBatchFrames> group{};
+  std::size_t num_frames = 0;
+  for (NvDsMetaList* l_frame = batch_meta->frame_meta_list; l_frame != NULL && num_frames < kMaxBatchFrames;
+       l_frame = l_frame->next) {
+    frames[num_frames++] = static_cast<const NvDsFrameMeta*>(l_frame->data);
+  }
+
+  // 같은 pad 의 프레임이 둘 이상이어도 배치에 들어온 순서를 지킨다
+  std::stable_sort(frames.begin(), frames.begin() + num_frames,
+                   [](const NvDsFrameMeta* a, const NvDsFrameMeta* b) { return a->pad_index < b->pad_index; });
+  for (std::size_t i = 0; i < num_frames; ++i) keys[i] = {frames[i]->pad_index, frames[i]->buf_pts};
+
+  std::lock_guard<std::mutex> lock(roi_mutex_);
+  app_common::groupBatchFrames(keys.data(), num_frames, roi_transforms_, group.data());
+
+  bool pushed = false;
+  for (std::size_t i = 0; i < num_frames; ++i) {
+    if (group[i] != app_common::kBatchRepresentative) continue;
+    const app_common::RoiTransform& transform = roi_transforms_[frames[i]->pad_index];
+    pushed |= queue_.push([&](app_common::DetectionFrame& frame) {
+      frame.frame_number = static_cast<uint64_t>(frames[i]->frame_num);
+      frame.timestamp = frames[i]->buf_pts;
+      frame.source_id = transform.source_id;
+      frame.num_objects = 0;
+      appendObjects(frame, frames[i], transform);
+      const uint32_t first_roi_object = frame.num_objects;
+      for (std::size_t j = i + 1; j < num_frames; ++j) {
+        if (group[j] == static_cast<int>(i)) appendObjects(frame, frames[j], roi_transforms_[frames[j]->pad_index]);
+      }
+      // 전체 프레임과 ROI 양쪽에서 잡힌 객체는 한 번만 보낸다
+      if (frame.num_objects > first_roi_object) {
+        app_common::mergeRoiDetections(frame, first_roi_object, app_config::kRoiMergeOverlap);
+      }
+    });
+  }
+  return pushed;
+}
+
+void AiService::wakeConsumer() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (consumer_waiting_.load()) {
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    wait_cv_.notify_one();
+  }
+}
+
+bool AiService::hasDetectionSubscribers() const {
+  return pub_socket_.hasSubscribers(topic_detections_) || pub_socket_.hasSubscribers(topic_detections_binary_) ||
+         pub_socket_.hasSubscribers(topic_tracks_);
+}
+
+void AiService::setTracking(bool enabled, OutputMode mode) {
+  tracking_.store(enabled);
+  output_mode_.store(mode);
+  // 모드가 바뀌면 기존 구독자도 born 부터 다시 받도록 track 을 새로 시작한다
+  tracker_generation_.fetch_add(1);
+  SPDLOG_SERVICE_INFO("[AI] tracking {} ({} output)", enabled ? "enabled" : "disabled",
+                      mode == OutputMode::Delta ? "delta" : "full");
+}
+
+void AiService::setPostFilter(const app_common::PostFilterConfig& config) {
+  {
+    std::lock_guard<std::mutex> lock(filter_mutex_);
+    filter_config_ = config;
   }
+  filter_generation_.fetch_add(1);
+  SPDLOG_SERVICE_INFO(
+      "[AI] post filter: min_confidence={}, classes='{}', class_confidence='{}', min_area={}, nms_iou={}",
+      config.min_confidence, app_common::formatClassList(config.allowed_classes),
+      app_common::formatClassThresholds(config.class_confidence), config.min_area, config.nms_iou);
+}
+
+app_common::PostFilterConfig AiService::getPostFilter() const {
+  std::lock_guard<std::mutex> lock(filter_mutex_);
+  return filter_config_;
+}
+
+// 추적기가 남은 객체만 보도록 추적보다 먼저 거른다
+void AiService::applyPostFilter(SourceState& source, FrameJob& job) {
+  const uint64_t generation = filter_generation_.load();
+  if (source.filter_generation != generation) {
+    source.post_filter = app_common::PostFilter(getPostFilter());
+    source.filter_generation = generation;
+  }
+  if (source.post_filter.passThrough()) return;
+  const uint32_t removed = source.post_filter.apply(job.frame);
+  if (removed > 0) filtered_objects_.fetch_add(removed, std::memory_order_relaxed);
+}
+
+void AiService::trackFrame(SourceState& source, FrameJob& job) {
+  const uint64_t generation = tracker_generation_.load();
+  if (source.tracker_generation != generation) {
+    app_common::TrackerConfig config;
+    config.iou_threshold = app_config::kTrackerIouThreshold;
+    config.max_age = app_config::kTrackerMaxAge;
+    config.min_hits = app_config::kTrackerMinHits;
+    config.delta_threshold = app_config::kTrackDeltaThreshold;
+    source.tracker = app_common::Tracker(config);
+    source.tracker_generation = generation;
+    source.track_subscription_version = 0;
+  }
+  if (!tracking_.load(std::memory_order_relaxed)) return;
+
+  if (output_mode_.load(std::memory_order_relaxed) != OutputMode::Delta) {
+    source.tracker.update(job.frame);
+    return;
+  }
+  source.tracker.update(job.frame, &job.delta);
+  if (!pub_socket_.hasSubscribers(topic_tracks_)) return;
+
+  // 새 구독자가 생겼거나 앞서 보낸 delta 가 버려졌으면 이번 프레임의 delta 대신 살아 있는 확정 track 전체를 sync 로 보낸다
+  const bool resync = source.track_resync.exchange(false);
+  const uint64_t subscription_version = pub_socket_.subscriptionVersion(topic_tracks_);
+  if (resync || subscription_version != source.track_subscription_version) {
+    source.track_subscription_version = subscription_version;
+    if (!job.sync_frame) job.sync_frame = std::make_unique<app_common::DetectionFrame>();
+    job.sync_frame->frame_number = job.frame.frame_number;
+    job.sync_frame->timestamp = job.frame.timestamp;
+    job.sync_frame->source_id = job.frame.source_id;
+    source.tracker.snapshot(*job.sync_frame);
+    job.track_sync = true;
+    job.send_tracks = true;
+  } else {
+    job.send_tracks = !job.delta.empty();
+  }
+}
+
+// 구독자가 없거나, 구독자가 요청한 전송률을 넘는 경우 직렬화 자체를 건너뛴다
+bool AiService::shouldPublish(PubSocket::TopicId topic, std::chrono::steady_clock::time_point& last_sent) {
+  if (!pub_socket_.hasSubscribers(topic)) return false;
+
+  const uint32_t rate = pub_socket_.requestedRate(topic);
+  const auto now = std::chrono::steady_clock::now();
+  if (rate > 0 && now - last_sent < std::chrono::microseconds(1000000 / rate)) return false;
+
+  last_sent = now;
+  return true;
+}
+
+// 후처리 필터, 추적, 정적 프레임 대체, 전송 여부 결정. 추적기와 전송률 제한 상태를 쓰므로 source 별로 직렬 실행된다.
+bool AiService::filterStage(uint32_t source_id, FrameJob& job) {
+  SourceState& source = sources_[source_id];
+  job.send_json = job.send_wire = job.send_tracks = job.track_sync = false;
+  job.delta.clear();
+
+  if (job.republish) {
+    if (!restoreLastFrame(source, job)) return false;
+  } else {
+    applyPostFilter(source, job);
+    trackFrame(source, job);
+    if (source.last_frame) {
+      app_common::copyFrame(*source.last_frame, job.frame);
+      source.has_last_frame = true;
+    }
+  }
+
+  // delta 가 빠지면 구독자는 다음 sync 까지 track 을 맞출 수 없으므로 trk 에는 전송률 제한을 적용하지 않는다
+  const bool delta_output = tracking_.load(std::memory_order_relaxed) &&
+                            output_mode_.load(std::memory_order_relaxed) == OutputMode::Delta;
+  job.send_json = !delta_output && shouldPublish(topic_detections_, source.last_json_sent);
+  job.send_wire = shouldPublish(topic_detections_binary_, source.last_wire_sent);
+  return job.send_json || job.send_wire || job.send_tracks;
+}
+
+bool AiService::serializeStage(uint32_t source_id, FrameJob& job) {
+  if (job.send_tracks) {
+    if (job.track_sync) {
+      app_common::TrackDelta sync;
+      for (uint32_t i = 0; i < job.sync_frame->num_objects; ++i) sync.born.push_back(i);
+      app_common::writeTrackDeltaJson(*job.sync_frame, sync, true, job.tracks);
+    } else {
+      app_common::writeTrackDeltaJson(job.frame, job.delta, false, job.tracks);
+    }
+  }
+
+  if (job.send_json) {
+    SourceState& source = sources_[source_id];
+    job.json.reserve(source.json_reserve);
+    app_common::writeDetectionJson(job.frame, job.json);
+    source.json_reserve = job.json.size();
+  }
+  return true;
+}
+
+// 직렬화한 버퍼는 복사 없이 PubSocket 으로 넘기고, job 에는 전송이 끝난 버퍼를 받아 다음 프레임에 다시 쓴다
+bool AiService::publishBuffer(PubSocket::TopicId topic, std::string& buffer) {
+  std::string payload = pub_socket_.acquirePayload();
+  payload.swap(buffer);
+  return pub_socket_.publish(topic, std::move(payload));
+}
+
+bool AiService::publishStage(uint32_t source_id, FrameJob& job) {
+  if (job.send_tracks && !publishBuffer(topic_tracks_, job.tracks)) {
+    SPDLOG_SERVICE_DEBUG("[AI] trk delta dropped for source {}, sending sync next frame", source_id);
+    sources_[source_id].track_resync.store(true);
+  }
+  if (job.send_json) {
+    SPDLOG_SERVICE_DEBUG("Sending JSON: {}", job.json);
+    publishBuffer(topic_detections_, job.json);
+  }
+  if (job.send_wire) publishWire(job);
+  return true;
+}
+
+// 라벨 테이블은 모든 source 가 공유하므로 bdet 인코딩과 라벨 / bdet 발행을 한 번에 잠그고 한다.
+// 어떤 source 가 새 라벨을 배운 뒤 인코딩된 다른 source 의 bdet 는 그 라벨 메시지보다 늦게 큐에 들어간다.
+void AiService::publishWire(FrameJob& job) {
+  std::lock_guard<std::mutex> lock(wire_mutex_);
+  const bool labels_changed = wire_encoder_.encodeFrame(job.frame, job.wire);
+
+  // 새 라벨이 생겼거나 새 구독자가 붙었으면 라벨 테이블을 먼저 보낸다
+  const uint64_t subscription_version = pub_socket_.subscriptionVersion(topic_detection_labels_);
+  if (labels_changed || subscription_version != label_subscription_version_ ||
+      ++frames_since_labels_ >= kLabelResendInterval) {
+    wire_encoder_.encodeLabels(job.labels);
+    publishBuffer(topic_detection_labels_, job.labels);
+    frames_since_labels_ = 0;
+    label_subscription_version_ = subscription_version;
+  }
+  publishBuffer(topic_detections_binary_, job.wire);
 }
 
 void AiService::attach(GstElement* appsink_elem) {
@@ -63,114 +436,26 @@ GstFlowReturn AiService::onNewSample(GstAppSink* sink, gpointer user_data) {
 
   GstSample* sample = gst_app_sink_pull_sample(sink);
   if (!sample) return GST_FLOW_ERROR;
+  self->pulled_samples_.fetch_add(1, std::memory_order_relaxed);
 
-  // 1) 캡스/비디오정보
-  GstCaps* caps = gst_sample_get_caps(sample);
-  GstVideoInfo vinfo;
-  bool has_vinfo = (caps && gst_video_info_from_caps(&vinfo, caps));
-
-  if (has_vinfo) {
-    const GstStructure* s = gst_caps_get_structure(caps, 0);
-    int w = GST_VIDEO_INFO_WIDTH(&vinfo);
-    int h = GST_VIDEO_INFO_HEIGHT(&vinfo);
-    GstVideoFormat fmt = GST_VIDEO_INFO_FORMAT(&vinfo);
-
-    // FPS 가져오기 (caps의 framerate fraction)
-    int fps_n = 0, fps_d = 1;
-    gst_structure_get_fraction(s, "framerate", &fps_n, &fps_d);
-
-    //        SPDLOG_SERVICE_INFO("[caps] format={} (I420? {}), {}x{}, fps={}/{}",
-    //                      gst_structure_has_field_typed(s, "format", G_TYPE_STRING) ?
-    //                        gst_structure_get_string(s, "format") : "unknown",
-    //                      (fmt == GST_VIDEO_FORMAT_I420), w, h, fps_n, fps_d);
-  } else {
-    SPDLOG_SERVICE_INFO("[caps] (no/invalid caps)");
-  }
-
-  // 2) 버퍼 메타
+  // 1) 버퍼 메타
   GstBuffer* buf = gst_sample_get_buffer(sample);
   if (!buf) {
     gst_sample_unref(sample);
     return GST_FLOW_ERROR;
   }
 
-  // 추론 코드
+  // 추론 코드: 메타만 복사해 큐에 넣고(extract) 추적/직렬화/전송은 후처리 graph 에서 처리
   NvDsBatchMeta* batch_meta = gst_buffer_get_nvds_batch_meta(buf);
-  if (batch_meta) {
-    // 프레임 메타데이터 리스트를 순회
-    for (NvDsMetaList* l_frame = batch_meta->frame_meta_list; l_frame != NULL; l_frame = l_frame->next) {
-      NvDsFrameMeta* frame_meta = (NvDsFrameMeta*)l_frame->data;
-
-      // 이 프레임에 대한 JSON 객체 생성 준비
-      app_common::Json frame_json;
-      frame_json["frame_number"] = frame_meta->frame_num;
-      frame_json["timestamp"] = frame_meta->buf_pts;
-
-      // 검출된 객체들을 담을 JSON 배열
-      app_common::Json objects_array = app_common::Json::array();
-
-      // 객체 메타데이터 리스트를 순회
-      for (NvDsMetaList* l_obj = frame_meta->obj_meta_list; l_obj != NULL; l_obj = l_obj->next) {
-        NvDsObjectMeta* obj_meta = (NvDsObjectMeta*)l_obj->data;
-
-        // 객체 하나에 대한 정보를 담을 JSON 객체
-        app_common::Json object_json;
-        object_json["class_id"] = obj_meta->class_id;
-        object_json["label"] = std::string(obj_meta->obj_label);
-        object_json["confidence"] = obj_meta->confidence;
-
-        // 바운딩 박스 좌표 정보를 담을 JSON 객체
-        app_common::Json box_json;
-        box_json["x"] = obj_meta->rect_params.left;
-        box_json["y"] = obj_meta->rect_params.top;
-        box_json["w"] = obj_meta->rect_params.width;
-        box_json["h"] = obj_meta->rect_params.height;
-
-        object_json["box"] = box_json;
-
-        // 생성된 객체 JSON을 배열에 추가
-        objects_array.push_back(object_json);
-      }
-
-      // 완성된 객체 배열을 프레임 JSON에 추가
-      frame_json["objects"] = objects_array;
-
-      // 완성된 JSON을 문자열로 변환하여 ZMQ로 전송
-      std::string json_string_to_send = frame_json.dump();
-      self->pub_socket_.publish(std::string(app_config::kTopicDetections), json_string_to_send);
+  if (batch_meta && self->activity_listener_) self->reportActivity(batch_meta);
 
-      SPDLOG_SERVICE_DEBUG("Sending JSON: {}", json_string_to_send);
-    }
+  if (batch_meta && self->hasDetectionSubscribers() && self->pushBatch(batch_meta)) {
+    self->wakeConsumer();
   }
 
-  guint nmem = gst_buffer_n_memory(buf);
-  GstClockTime pts = GST_BUFFER_PTS(buf);
-  GstClockTime dts = GST_BUFFER_DTS(buf);
-  GstClockTime dur = GST_BUFFER_DURATION(buf);
-
-  //    SPDLOG_SERVICE_INFO("[buffer] nmem={}, PTS={} ns, DTS={} ns, DUR={} ns, flags=0x{:x}",
-  //                  nmem, (guint64)pts, (guint64)dts, (guint64)dur, (unsigned)GST_BUFFER_FLAGS(buf));
-
-  // 3) 맵해서 크기/데이터 접근
-  GstMapInfo map;
-  if (gst_buffer_map(buf, &map, GST_MAP_READ)) {
-    //        SPDLOG_SERVICE_INFO("[map] size={} bytes, data_ptr={}", (gsize)map.size, (const void*)map.data);
-    gst_buffer_unmap(buf, &map);
-  } else {
-    SPDLOG_SERVICE_WARN("[map] failed");
-  }
-
-  // 4) 비디오 메타(plane pitch/offset 등)
-  if (has_vinfo) {
-    // I420은 3 planes: Y, U, V
-    int n_planes = GST_VIDEO_INFO_N_PLANES(&vinfo);
-    for (int i = 0; i < n_planes; ++i) {
-      //            SPDLOG_SERVICE_INFO("[video] plane{}: stride={}, offset={}, plane_height={}",
-      //                          i,
-      //                          GST_VIDEO_INFO_PLANE_STRIDE(&vinfo, i),
-      //                          GST_VIDEO_INFO_PLANE_OFFSET(&vinfo, i),
-      //                          GST_VIDEO_INFO_COMP_HEIGHT(&vinfo, i));
-    }
+  // 2) Frames 모드에서만 프레임 caps 를 확인한다 (메타데이터 전용 모드는 메타만 쓴다)
+  if (self->sink_mode_ == CameraService::InferenceSinkMode::Frames) {
+    inspectFrame(sample);
   }
 
   gst_sample_unref(sample);
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <random>
+
+#include "common/infer/detection.hpp"
+
+// 단위 테스트와 벤치마크가 함께 쓰는 DetectionFrame 픽스처
+namespace test_support {
+
+// 검출이 없는 프레임
+inline std::unique_ptr<app_common::DetectionFrame> makeFrame(uint64_t frame_number = 0, uint64_t timestamp = 0,
+                                                            uint32_t source_id = 0) {
+  auto frame = std::make_unique<app_common::DetectionFrame>();
+  frame->frame_number = frame_number;
+  frame->timestamp = timestamp;
+  frame->source_id = source_id;
+  frame->num_objects = 0;
+  return frame;
+}
+
+// car(0), person(2) 두 검출이 들어 있는 프레임
+inline std::unique_ptr<app_common::DetectionFrame> makeSampleFrame(uint64_t frame_number, uint32_t source_id) {
+  auto frame = makeFrame(frame_number, 9876543210, source_id);
+  frame->num_objects = 2;
+  frame->objects[0] = {0, 0.95f, 100.0f, 50.0f, 80.0f, 60.0f, {}};
+  app_common::copyLabel(frame->objects[0].label, "car");
+  frame->objects[1] = {2, 0.88f, 200.0f, 150.0f, 30.0f, 90.0f, {}};
+  app_common::copyLabel(frame->objects[1].label, "person");
+  return frame;
+}
+
+// 사람이 몰린 장면처럼 박스가 자주 겹치고 confidence 가 넓게 퍼진 검출 num_objects 개. 같은 seed 면 같은 프레임이다.
+inline std::unique_ptr<app_common::DetectionFrame> makeRandomFrame(uint32_t num_objects, uint32_t seed,
+                                                                  int32_t num_classes) {
+  static const char* const kLabels[] = {"car", "person", "bicycle", "roadsign"};
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> coord(0.0f, 900.0f);
+  std::uniform_real_distribution<float> size(20.0f, 120.0f);
+  std::uniform_real_distribution<float> conf(0.05f, 1.0f);
+
+  auto frame = makeFrame(123456, 9876543210, 0);
+  frame->num_objects = num_objects;
+  for (uint32_t i = 0; i < num_objects; ++i) {
+    auto& det = frame->objects[i];
+    det.class_id = static_cast<int32_t>(i % static_cast<uint32_t>(num_classes));
+    det.confidence = conf(rng);
+    det.x = coord(rng);
+    det.y = coord(rng) * 0.5f;
+    det.w = size(rng);
+    det.h = size(rng);
+    app_common::copyLabel(det.label, kLabels[det.class_id % 4]);
+  }
+  return frame;
+}
+
+}  // namespace test_support
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "common/infer/detection_json_writer.hpp"
+#include "common/utils/json.hpp"
+#include "detection_frames.hpp"
+
+namespace {
+auto makeFrame() { return test_support::makeSampleFrame(123, 0); }
+}  // namespace
+
+TEST(DetectionJsonWriterTest, MatchesInferSchemaLayout) {
+  auto frame = makeFrame();
+  std::string out;
+  app_common::writeDetectionJson(*frame, out);
+
+  EXPECT_EQ(out,
+            R"({"frame_number":123,"timestamp":9876543210,"source_id":0,"objects":[)"
+            R"({"class_id":0,"label":"car","confidence":0.95,"box":{"x":100,"y":50,"w":80,"h":60}},)"
+            R"({"class_id":2,"label":"person","confidence":0.88,"box":{"x":200,"y":150,"w":30,"h":90}}]})");
+}
+
+TEST(DetectionJsonWriterTest, ParsesBackToSameValues) {
+  auto frame = makeFrame();
+  auto json = app_common::Json::parse(app_common::writeDetectionJson(*frame));
+
+  EXPECT_EQ(json["frame_number"], 123);
+  EXPECT_EQ(json["timestamp"], 9876543210ULL);
+  ASSERT_EQ(json["objects"].size(), 2u);
+  EXPECT_EQ(json["objects"][1]["label"], "person");
+  EXPECT_FLOAT_EQ(json["objects"][1]["confidence"].get<float>(), 0.88f);
+  EXPECT_FLOAT_EQ(json["objects"][1]["box"]["h"].get<float>(), 90.0f);
+}
+
+TEST(DetectionJsonWriterTest, EscapesLabelsAndEmptyFrames) {
+  auto frame = makeFrame();
+  frame->num_objects = 1;
+  app_common::copyLabel(frame->objects[0].label, "a\"b\\c\x01");
+
+  auto json = app_common::Json::parse(app_common::writeDetectionJson(*frame));
+  EXPECT_EQ(json["objects"][0]["label"], "a\"b\\c\x01");
+
+  frame->num_objects = 0;
+  EXPECT_EQ(app_common::writeDetectionJson(*frame),
+            R"({"frame_number":123,"timestamp":9876543210,"source_id":0,"objects":[]})");
+}
+
+TEST(DetectionJsonWriterTest, ReusesBufferCapacity) {
+  auto frame = makeFrame();
+  std::string out;
+  app_common::writeDetectionJson(*frame, out);
+  const auto* data = out.data();
+  const auto capacity = out.capacity();
+
+  app_common::writeDetectionJson(*frame, out);
+  EXPECT_EQ(out.data(), data);
+  EXPECT_EQ(out.capacity(), capacity);
+}
+
+TEST(DetectionJsonWriterTest, LongMultiByteLabelStaysValidUtf8) {
+  auto frame = makeFrame();
+  // 3 byte 문자 20 개 (60 bytes). 31 bytes 에서 자르면 11 번째 문자 중간이다
+  std::string label;
+  for (int i = 0; i < 20; ++i) label += "가";
+  app_common::copyLabel(frame->objects[0].label, label.c_str());
+  EXPECT_EQ(std::string(frame->objects[0].label), label.substr(0, 30));
+
+  const auto json = app_common::Json::parse(app_common::writeDetectionJson(*frame));
+  EXPECT_EQ(json["objects"][0]["label"], label.substr(0, 30));
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "common/infer/detection_wire.hpp"
+#include "common/infer/detection_wire_encoder.hpp"
+#include "detection_frames.hpp"
+
+using app_common::wire::DetectionWireEncoder;
+using app_common::wire::FrameView;
+
+namespace {
+auto makeFrame() { return test_support::makeSampleFrame(42, 3); }
+}  // namespace
+
+TEST(DetectionWireTest, FrameRoundTrip) {
+  auto frame = makeFrame();
+  DetectionWireEncoder encoder;
+  std::string out;
+  encoder.encodeFrame(*frame, out);
+
+  EXPECT_EQ(out.size(), app_common::wire::kFrameHeaderSize + 2 * sizeof(app_common::wire::WireDetection));
+
+  FrameView view;
+  ASSERT_TRUE(view.parse(out.data(), out.size()));
+  EXPECT_EQ(view.frameNumber(), 42u);
+  EXPECT_EQ(view.timestamp(), 9876543210u);
+  EXPECT_EQ(view.sourceId(), 3u);
+  ASSERT_EQ(view.size(), 2u);
+  EXPECT_EQ(view[1].class_id, 2);
+  EXPECT_FLOAT_EQ(view[1].confidence, 0.88f);
+  EXPECT_FLOAT_EQ(view[1].h, 90.0f);
+}
+
+TEST(DetectionWireTest, LabelsAreReportedOnce) {
+  auto frame = makeFrame();
+  DetectionWireEncoder encoder;
+  std::string out;
+  EXPECT_TRUE(encoder.encodeFrame(*frame, out));
+  EXPECT_FALSE(encoder.encodeFrame(*frame, out));
+
+  std::string labels;
+  encoder.encodeLabels(labels);
+
+  std::map<int32_t, std::string> table;
+  ASSERT_TRUE(app_common::wire::forEachLabel(labels.data(), labels.size(),
+                                             [&](int32_t id, std::string_view label) { table[id] = label; }));
+  EXPECT_EQ(table, (std::map<int32_t, std::string>{{0, "car"}, {2, "person"}}));
+}
+
+TEST(DetectionWireTest, LearnsLabelsForAnyClassId) {
+  auto frame = makeFrame();
+  frame->objects[0].class_id = 5000;
+  frame->objects[1].class_id = -1;
+  DetectionWireEncoder encoder;
+  std::string out;
+  EXPECT_TRUE(encoder.encodeFrame(*frame, out));
+
+  std::string labels;
+  encoder.encodeLabels(labels);
+  std::map<int32_t, std::string> table;
+  ASSERT_TRUE(app_common::wire::forEachLabel(labels.data(), labels.size(),
+                                             [&](int32_t id, std::string_view label) { table[id] = label; }));
+  EXPECT_EQ(table, (std::map<int32_t, std::string>{{-1, "person"}, {5000, "car"}}));
+}
+
+TEST(DetectionWireTest, RejectsMalformedMessages) {
+  auto frame = makeFrame();
+  DetectionWireEncoder encoder;
+  std::string out;
+  encoder.encodeFrame(*frame, out);
+
+  FrameView view;
+  EXPECT_FALSE(view.parse(out.data(), out.size() - 1));
+  EXPECT_FALSE(view.parse(out.data(), 4));
+
+  std::string labels;
+  encoder.encodeLabels(labels);
+  EXPECT_FALSE(view.parse(labels.data(), labels.size()));
+
+  int calls = 0;
+  EXPECT_FALSE(app_common::wire::forEachLabel(labels.data(), labels.size() - 1,
+                                              [&](int32_t, std::string_view) { ++calls; }));
+  EXPECT_EQ(calls, 0);
+
+  out[0] = 'X';
+  EXPECT_FALSE(view.parse(out.data(), out.size()));
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "common/vision/frame_diff.hpp"
+
+using app_common::FrameDiffScorer;
+using app_common::SimdLevel;
+
+namespace {
+std::vector<uint8_t> randomBytes(std::size_t size, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<uint8_t> data(size);
+  for (auto& v : data) v = static_cast<uint8_t>(dist(rng));
+  return data;
+}
+}  // namespace
+
+TEST(FrameDiffTest, SimdLevelsMatchScalar) {
+  // 벡터 폭의 배수가 아닌 길이도 꼬리 처리까지 같아야 한다
+  for (std::size_t size : {0u, 1u, 15u, 16u, 31u, 33u, 1920u, 4099u}) {
+    const auto a = randomBytes(size, 1);
+    const auto b = randomBytes(size, 2);
+    const uint64_t expected = app_common::sumAbsDiff(a.data(), b.data(), size, SimdLevel::Scalar);
+    for (SimdLevel level : {SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Neon}) {
+      EXPECT_EQ(app_common::sumAbsDiff(a.data(), b.data(), size, level), expected)
+          << app_common::simdLevelName(level) << " size=" << size;
+    }
+  }
+}
+
+TEST(FrameDiffTest, MaxDifferenceDoesNotOverflow) {
+  std::vector<uint8_t> black(1 << 20, 0);
+  std::vector<uint8_t> white(1 << 20, 255);
+  EXPECT_EQ(app_common::sumAbsDiff(black.data(), white.data(), black.size()), 255ull * black.size());
+}
+
+TEST(FrameDiffTest, ScorerComparesAgainstReferenceRows) {
+  constexpr int kWidth = 64, kHeight = 32, kStride = 80;
+  std::vector<uint8_t> frame(kStride * kHeight, 100);
+
+  FrameDiffScorer scorer(4);
+  EXPECT_LT(scorer.score(frame.data(), kWidth, kHeight, kStride), 0.0);
+
+  scorer.setReference(frame.data(), kWidth, kHeight, kStride);
+  EXPECT_DOUBLE_EQ(scorer.score(frame.data(), kWidth, kHeight, kStride), 0.0);
+
+  // 골라내지 않는 줄과 stride 패딩의 변화는 점수에 영향이 없다
+  frame[1 * kStride + 3] = 0;
+  frame[kWidth + 2] = 0;
+  EXPECT_DOUBLE_EQ(scorer.score(frame.data(), kWidth, kHeight, kStride), 0.0);
+
+  // 골라낸 줄 (0, 4, ..., 28) 전체가 10 씩 밝아지면 평균 차이는 10
+  for (int y = 0; y < kHeight; y += 4) {
+    for (int x = 0; x < kWidth; ++x) frame[y * kStride + x] = 110;
+  }
+  EXPECT_DOUBLE_EQ(scorer.score(frame.data(), kWidth, kHeight, kStride), 10.0);
+
+  EXPECT_LT(scorer.score(frame.data(), kWidth / 2, kHeight, kStride), 0.0);
+}
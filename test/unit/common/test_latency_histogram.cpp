@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/utils/latency_histogram.hpp"
+
+using app_common::LatencyHistogram;
+
+TEST(LatencyHistogramTest, BucketBoundsContainValue) {
+  const uint64_t values[] = {0, 1, 15, 16, 17, 31, 32, 1000, 33333333, LatencyHistogram::kMaxValue};
+  for (uint64_t v : values) {
+    const auto index = LatencyHistogram::bucketIndex(v);
+    ASSERT_LT(index, LatencyHistogram::kNumBuckets);
+    EXPECT_GE(LatencyHistogram::upperBound(index), v);
+    if (index > 0) {
+      EXPECT_LT(LatencyHistogram::upperBound(index - 1), v);
+    }
+  }
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinRelativeError) {
+  auto hist = std::make_unique<LatencyHistogram>();
+  for (uint64_t v = 1; v <= 10000; ++v) hist->record(v * 1000);
+
+  auto snap = std::make_unique<LatencyHistogram::Snapshot>();
+  hist->drain(*snap);
+  EXPECT_EQ(snap->count, 10000u);
+  EXPECT_EQ(snap->max, 10000u * 1000);
+
+  const double tolerance = 1.0 / LatencyHistogram::kSubBuckets;
+  for (double q : {0.5, 0.9, 0.99}) {
+    const double expected = q * 10000 * 1000;
+    EXPECT_NEAR(static_cast<double>(snap->percentile(q)), expected, expected * tolerance) << q;
+  }
+
+  hist->drain(*snap);
+  EXPECT_EQ(snap->count, 0u);
+  EXPECT_EQ(snap->percentile(0.5), 0u);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecordsAreCounted) {
+  auto hist = std::make_unique<LatencyHistogram>();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&hist] {
+      for (uint64_t v = 0; v < 100000; ++v) hist->record(v);
+    });
+  }
+  for (auto& t : threads) t.join();
+
+  auto snap = std::make_unique<LatencyHistogram::Snapshot>();
+  hist->drain(*snap);
+  EXPECT_EQ(snap->count, 400000u);
+  EXPECT_EQ(snap->max, 99999u);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/utils/mpsc_queue.hpp"
+
+using app_common::MpscQueue;
+using app_common::OverflowPolicy;
+
+TEST(MpscQueueTest, OverflowPolicies) {
+  MpscQueue<std::string> newest(2, OverflowPolicy::DropNewest);
+  std::string a = "a", b = "b", c = "c";
+  EXPECT_TRUE(newest.push(std::move(a)));
+  EXPECT_TRUE(newest.push(std::move(b)));
+  EXPECT_FALSE(newest.push(std::move(c)));
+  EXPECT_EQ(c, "c");
+
+  std::string out;
+  ASSERT_TRUE(newest.pop(out));
+  EXPECT_EQ(out, "a");
+
+  MpscQueue<std::string> oldest(2, OverflowPolicy::DropOldest);
+  for (const char* s : {"a", "b", "c"}) EXPECT_TRUE(oldest.push(std::string(s)));
+  EXPECT_EQ(oldest.droppedOldest(), 1u);
+  ASSERT_TRUE(oldest.pop(out));
+  EXPECT_EQ(out, "b");
+}
+
+TEST(MpscQueueTest, MultipleProducersPreservePerProducerOrder) {
+  constexpr int kProducers = 4;
+  constexpr int kPerProducer = 50000;
+  MpscQueue<int> queue(1024, OverflowPolicy::DropNewest);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&queue, p] {
+      for (int i = 0; i < kPerProducer; ++i) {
+        while (!queue.push(p * kPerProducer + i)) std::this_thread::yield();
+      }
+    });
+  }
+
+  std::vector<int> last(kProducers, -1);
+  int received = 0;
+  while (received < kProducers * kPerProducer) {
+    int value;
+    if (!queue.pop(value)) continue;
+    const int producer = value / kPerProducer;
+    EXPECT_GT(value, last[producer]);
+    last[producer] = value;
+    ++received;
+  }
+  for (auto& t : producers) t.join();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpscQueueTest, DropOldestCountsEachLostMessageOnce) {
+  constexpr int kProducers = 4;
+  constexpr int kPerProducer = 50000;
+  MpscQueue<int> queue(8, OverflowPolicy::DropOldest);
+
+  std::atomic<int> accepted{0};
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&queue, &accepted] {
+      for (int i = 0; i < kPerProducer; ++i) {
+        if (queue.push(int{i})) accepted.fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  std::atomic<bool> done{false};
+  uint64_t received = 0;
+  std::thread consumer([&] {
+    int value;
+    while (!done.load() || !queue.empty()) {
+      if (queue.pop(value)) ++received;
+    }
+  });
+  for (auto& t : producers) t.join();
+  done = true;
+  consumer.join();
+
+  constexpr uint64_t kTotal = static_cast<uint64_t>(kProducers) * kPerProducer;
+  EXPECT_EQ(static_cast<uint64_t>(accepted.load()), kTotal - queue.droppedNewest());
+  EXPECT_EQ(received + queue.dropped(), kTotal);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "common/pipeline/pipeline_spec.hpp"
+
+using app_common::PipelineSpec;
+
+namespace {
+constexpr const char* kSpec = R"({
+  "version": 1,
+  "name": "test-pipe",
+  "elements": [
+    {"name": "src", "factory": "uridecodebin", "properties": {"uri": "${uri}", "caps": "video/x-raw"}},
+    {"name": "q", "factory": "queue", "properties": {"max-size-buffers": 5, "leaky": "downstream", "silent": true}},
+    {"name": "conv", "factory": "videoconvert"},
+    {"name": "mux", "factory": "funnel"},
+    {"name": "sink", "factory": "fakesink", "properties": {"ts-offset": -1.5}}
+  ],
+  "links": [
+    {"from": "src", "to": "q", "dynamic": true, "caps": "video/x-raw"},
+    {"chain": ["q", "conv"]},
+    {"from": "conv", "to": "mux", "to_pad": "sink_%u"},
+    {"chain": ["mux", "sink"]}
+  ]
+})";
+
+std::string parseError(const std::string& text) {
+  PipelineSpec spec;
+  std::string error;
+  EXPECT_FALSE(app_common::parsePipelineSpec(text, spec, error)) << text;
+  return error;
+}
+}  // namespace
+
+TEST(PipelineSpecTest, ParsesElementsPropertiesAndLinks) {
+  PipelineSpec spec;
+  std::string error;
+  ASSERT_TRUE(app_common::parsePipelineSpec(kSpec, spec, error)) << error;
+
+  EXPECT_EQ(spec.name, "test-pipe");
+  ASSERT_EQ(spec.elements.size(), 5u);
+  const auto* queue = spec.find("q");
+  ASSERT_NE(queue, nullptr);
+  EXPECT_EQ(queue->factory, "queue");
+  // 파일에 적힌 순서를 지키고, 숫자 / bool 은 문자열로 바뀐다
+  ASSERT_EQ(queue->properties.size(), 3u);
+  EXPECT_EQ(queue->properties[0], std::make_pair(std::string("max-size-buffers"), std::string("5")));
+  EXPECT_EQ(queue->properties[1].second, "downstream");
+  EXPECT_EQ(queue->properties[2].second, "true");
+  EXPECT_EQ(spec.find("sink")->properties[0].second, "-1.5");
+  EXPECT_EQ(spec.find("missing"), nullptr);
+
+  // chain 은 이웃한 쌍마다 link 하나로 펼쳐진다
+  ASSERT_EQ(spec.links.size(), 4u);
+  EXPECT_TRUE(spec.links[0].dynamic);
+  EXPECT_EQ(spec.links[0].caps, "video/x-raw");
+  EXPECT_EQ(spec.links[1].src, "q");
+  EXPECT_EQ(spec.links[1].sink, "conv");
+  EXPECT_TRUE(spec.links[1].sink_pad.empty());
+  EXPECT_EQ(spec.links[2].sink_pad, "sink_%u");
+}
+
+TEST(PipelineSpecTest, RejectsInvalidSpecsWithLocation) {
+  EXPECT_EQ(parseError("{"), "pipeline: invalid JSON");
+  EXPECT_EQ(parseError(R"({"version": 2, "elements": [{"name": "a", "factory": "queue"}]})"),
+            "version: 2 is not supported (expected 1)");
+  EXPECT_EQ(parseError(R"({"version": 1, "elements": []})"), "elements: pipeline has no elements");
+  EXPECT_EQ(parseError(R"({"version": 1, "elements": [{"name": "a"}]})"), "elements[0]: missing \"factory\"");
+  EXPECT_EQ(parseError(R"({"version": 1, "elements": [{"name": "a", "factory": "queue"},
+                                                    {"name": "a", "factory": "queue"}]})"),
+            "elements[1].name: duplicate 'a'");
+  EXPECT_EQ(parseError(R"({"version": 1, "elements": [{"name": "a b", "factory": "queue"}]})"),
+            "elements[0].name: 'a b' is not a valid name");
+  EXPECT_EQ(parseError(R"({"version": 1, "elements": [{"name": "q.0", "factory": "queue"}]})"),
+            "elements[0].name: 'q.0' is not a valid name");
+  EXPECT_EQ(parseError(R"({"version": 1,
+                          "elements": [{"name": "a", "factory": "queue", "properties": {"x": [1]}}]})"),
+            "elements[0].properties.x: must be a string, number or bool");
+  EXPECT_EQ(parseError(R"({"version": 1, "elements": [{"name": "a", "factory": "queue"}],
+                          "links": [{"chain": ["a", "b"]}]})"),
+            "links[0] (a -> b): unknown element 'b'");
+  EXPECT_EQ(parseError(R"({"version": 1,
+                          "elements": [{"name": "a", "factory": "queue"}, {"name": "b", "factory": "queue"}],
+                          "links": [{"from": "a", "to": "b", "caps": "video/x-raw"}]})"),
+            "links[0] (a -> b): caps filter is only allowed on dynamic links");
+  EXPECT_EQ(parseError(R"({"version": 1, "elements": [{"name": "a", "factory": "queue"}],
+                          "links": [{"from": "a", "to": "a"}]})"),
+            "links[0] (a -> a): element is linked to itself");
+}
+
+TEST(PipelineSpecTest, JsonRoundTrip) {
+  PipelineSpec spec;
+  std::string error;
+  ASSERT_TRUE(app_common::parsePipelineSpec(kSpec, spec, error)) << error;
+
+  PipelineSpec again;
+  ASSERT_TRUE(app_common::parsePipelineSpec(app_common::pipelineSpecToJson(spec), again, error)) << error;
+  EXPECT_EQ(app_common::pipelineSpecToJson(again), app_common::pipelineSpecToJson(spec));
+  ASSERT_EQ(again.links.size(), spec.links.size());
+  EXPECT_TRUE(again.links[0].dynamic);
+  EXPECT_EQ(again.find("q")->properties, spec.find("q")->properties);
+}
+
+TEST(PipelineSpecTest, ExpandsVariablesAndOverridesProperties) {
+  PipelineSpec spec;
+  std::string error;
+  ASSERT_TRUE(app_common::parsePipelineSpec(kSpec, spec, error)) << error;
+
+  ASSERT_TRUE(spec.setProperty("q", "max-size-buffers", "${depth}"));
+  ASSERT_TRUE(spec.setProperty("conv", "qos", "true"));
+  EXPECT_FALSE(spec.setProperty("missing", "qos", "true"));
+
+  EXPECT_FALSE(app_common::expandPipelineSpec(spec, {{"uri", "file:///a.mp4"}}, error));
+  EXPECT_EQ(error, "q.max-size-buffers: undefined variable '${depth}'");
+
+  ASSERT_TRUE(app_common::expandPipelineSpec(spec, {{"uri", "file:///a.mp4"}, {"depth", "7"}}, error)) << error;
+  EXPECT_EQ(spec.find("src")->properties[0].second, "file:///a.mp4");
+  EXPECT_EQ(spec.find("q")->properties[0].second, "7");
+  EXPECT_EQ(spec.find("conv")->properties[0], std::make_pair(std::string("qos"), std::string("true")));
+}
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/infer/post_filter.hpp"
+#include "detection_frames.hpp"
+
+using app_common::DetectionFrame;
+using app_common::PostFilter;
+using app_common::PostFilterConfig;
+using test_support::makeFrame;
+
+namespace {
+void addObject(DetectionFrame& frame, int32_t class_id, float confidence, float x, float y, float w, float h) {
+  auto& det = frame.objects[frame.num_objects++];
+  det = {class_id, confidence, x, y, w, h, {}};
+  app_common::copyLabel(det.label, std::to_string(class_id).c_str());
+}
+
+std::vector<float> confidences(const DetectionFrame& frame) {
+  std::vector<float> values;
+  for (uint32_t i = 0; i < frame.num_objects; ++i) values.push_back(frame.objects[i].confidence);
+  return values;
+}
+}  // namespace
+
+TEST(PostFilterTest, DefaultConfigPassesEverything) {
+  PostFilter filter;
+  EXPECT_TRUE(filter.passThrough());
+
+  auto frame = makeFrame();
+  addObject(*frame, 0, 0.01f, 0, 0, 1, 1);
+  EXPECT_EQ(filter.apply(*frame), 0u);
+  EXPECT_EQ(frame->num_objects, 1u);
+}
+
+TEST(PostFilterTest, AppliesPerClassThresholdsAndAllowList) {
+  PostFilterConfig config;
+  config.min_confidence = 0.5f;
+  config.class_confidence = {{2, 0.2f}, {7, 0.1f}};
+  config.allowed_classes = {0, 2};
+  PostFilter filter(config);
+
+  auto frame = makeFrame();
+  addObject(*frame, 0, 0.6f, 0, 0, 10, 10);    // 기본 임계값 통과
+  addObject(*frame, 0, 0.4f, 0, 0, 10, 10);    // 기본 임계값 미달
+  addObject(*frame, 2, 0.3f, 0, 0, 10, 10);    // 클래스 임계값 통과
+  addObject(*frame, 7, 0.9f, 0, 0, 10, 10);    // 허용 목록 밖
+  addObject(*frame, 999, 0.9f, 0, 0, 10, 10);  // 표 범위 밖
+
+  EXPECT_EQ(filter.apply(*frame), 3u);
+  EXPECT_EQ(confidences(*frame), (std::vector<float>{0.6f, 0.3f}));
+}
+
+TEST(PostFilterTest, DropsSmallBoxes) {
+  PostFilterConfig config;
+  config.min_area = 100.0f;
+  PostFilter filter(config);
+
+  auto frame = makeFrame();
+  addObject(*frame, 0, 0.9f, 0, 0, 10, 10);
+  addObject(*frame, 0, 0.8f, 0, 0, 9, 10);
+  EXPECT_EQ(filter.apply(*frame), 1u);
+  EXPECT_EQ(confidences(*frame), (std::vector<float>{0.9f}));
+}
+
+TEST(PostFilterTest, NmsIsClassAwareAndKeepsOrder) {
+  PostFilterConfig config;
+  config.nms_iou = 0.5f;
+  PostFilter filter(config);
+
+  auto frame = makeFrame();
+  addObject(*frame, 0, 0.7f, 0, 0, 100, 100);     // 0.9 와 겹쳐 제거
+  addObject(*frame, 0, 0.9f, 5, 5, 100, 100);
+  addObject(*frame, 1, 0.6f, 5, 5, 100, 100);     // 다른 클래스라 유지
+  addObject(*frame, 0, 0.8f, 300, 300, 50, 50);   // 겹치지 않음
+  addObject(*frame, 0, 0.5f, 310, 300, 50, 50);   // 0.8 과 겹쳐 제거
+
+  EXPECT_EQ(filter.apply(*frame), 2u);
+  EXPECT_EQ(confidences(*frame), (std::vector<float>{0.9f, 0.6f, 0.8f}));
+}
+
+TEST(PostFilterTest, SuppressedBoxDoesNotSuppressOthers) {
+  // a > b > c 이고 a-b, b-c 만 겹치면 b 만 지워지고 c 는 남아야 한다
+  PostFilterConfig config;
+  config.nms_iou = 0.3f;
+  PostFilter filter(config);
+
+  auto frame = makeFrame();
+  addObject(*frame, 0, 0.9f, 0, 0, 100, 100);
+  addObject(*frame, 0, 0.8f, 50, 0, 100, 100);
+  addObject(*frame, 0, 0.7f, 100, 0, 100, 100);
+
+  EXPECT_EQ(filter.apply(*frame), 1u);
+  EXPECT_EQ(confidences(*frame), (std::vector<float>{0.9f, 0.7f}));
+}
+
+TEST(PostFilterTest, NmsMatchesPairwiseReference) {
+  // SIMD 경로(4 개씩)와 나머지 경로를 모두 지나도록 박스를 많이 만든다
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> coord(0.0f, 400.0f);
+  std::uniform_real_distribution<float> size(20.0f, 80.0f);
+  std::uniform_real_distribution<float> conf(0.0f, 1.0f);
+
+  auto frame = makeFrame();
+  for (int i = 0; i < 203; ++i) addObject(*frame, i % 3, conf(rng), coord(rng), coord(rng), size(rng), size(rng));
+  const auto input = confidences(*frame);
+
+  std::vector<uint32_t> order(frame->num_objects);
+  std::iota(order.begin(), order.end(), 0u);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](uint32_t a, uint32_t b) { return frame->objects[a].confidence > frame->objects[b].confidence; });
+  std::vector<bool> keep(frame->num_objects, true);
+  for (std::size_t r = 0; r < order.size(); ++r) {
+    const auto& a = frame->objects[order[r]];
+    if (!keep[order[r]]) continue;
+    for (std::size_t s = r + 1; s < order.size(); ++s) {
+      const auto& b = frame->objects[order[s]];
+      const float w = std::max(0.0f, std::min(a.x + a.w, b.x + b.w) - std::max(a.x, b.x));
+      const float h = std::max(0.0f, std::min(a.y + a.h, b.y + b.h) - std::max(a.y, b.y));
+      const float inter = w * h;
+      if (a.class_id == b.class_id && inter > 0.4f * (a.w * a.h + b.w * b.h - inter)) keep[order[s]] = false;
+    }
+  }
+  std::vector<float> expected;
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    if (keep[i]) expected.push_back(input[i]);
+  }
+
+  PostFilterConfig config;
+  config.nms_iou = 0.4f;
+  PostFilter filter(config);
+  filter.apply(*frame);
+  EXPECT_EQ(confidences(*frame), expected);
+}
+
+TEST(PostFilterTest, ParsesAndFormatsSpecs) {
+  std::vector<std::pair<int32_t, float>> thresholds;
+  std::vector<int32_t> classes;
+  std::string error;
+
+  ASSERT_TRUE(app_common::parseClassThresholds("0:0.5;2:0.25", thresholds, error));
+  EXPECT_EQ(app_common::formatClassThresholds(thresholds), "0:0.5;2:0.25");
+  ASSERT_TRUE(app_common::parseClassList("1;3", classes, error));
+  EXPECT_EQ(app_common::formatClassList(classes), "1;3");
+  ASSERT_TRUE(app_common::parseClassList("", classes, error));
+  EXPECT_TRUE(classes.empty());
+
+  EXPECT_FALSE(app_common::parseClassThresholds("0:abc", thresholds, error));
+  EXPECT_FALSE(app_common::parseClassThresholds("0", thresholds, error));
+  EXPECT_FALSE(app_common::parseClassList("1;x", classes, error));
+  EXPECT_NE(error.find("'x'"), std::string::npos);
+}
+
+TEST(PostFilterTest, RejectsOutOfRangeValues) {
+  std::vector<std::pair<int32_t, float>> thresholds;
+  std::vector<int32_t> classes;
+  std::string error;
+
+  // 표 밖의 class 는 조용히 무시되지 않고 거절된다
+  EXPECT_FALSE(app_common::parseClassList("1;256", classes, error));
+  EXPECT_NE(error.find("256"), std::string::npos);
+  EXPECT_FALSE(app_common::parseClassList("-1", classes, error));
+  EXPECT_FALSE(app_common::parseClassThresholds("300:0.5", thresholds, error));
+  EXPECT_FALSE(app_common::parseClassThresholds("0:1.5", thresholds, error));
+  EXPECT_FALSE(app_common::parseClassThresholds("0:-0.1", thresholds, error));
+  EXPECT_TRUE(app_common::parseClassList("0;255", classes, error));
+
+  PostFilterConfig config;
+  EXPECT_TRUE(app_common::validatePostFilter(config, error));
+  config.min_confidence = -0.1f;
+  EXPECT_FALSE(app_common::validatePostFilter(config, error));
+  config.min_confidence = 0.5f;
+  config.min_area = -1.0f;
+  EXPECT_FALSE(app_common::validatePostFilter(config, error));
+  config.min_area = 0.0f;
+  config.nms_iou = 1.5f;
+  EXPECT_FALSE(app_common::validatePostFilter(config, error));
+  config.nms_iou = 0.5f;
+  config.allowed_classes = {512};
+  EXPECT_FALSE(app_common::validatePostFilter(config, error));
+  config.allowed_classes = {2};
+  config.class_confidence = {{2, 2.0f}};
+  EXPECT_FALSE(app_common::validatePostFilter(config, error));
+  config.class_confidence = {{2, 0.7f}};
+  EXPECT_TRUE(app_common::validatePostFilter(config, error));
+}
@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zmq.hpp>
+
+#include "common/zmq/pub_socket.hpp"
+
+namespace {
+
+constexpr auto kTimeout = std::chrono::seconds(5);
+
+class PubSocketTest : public ::testing::Test {
+protected:
+  // PubSocket 은 "zmq" 로거로 기록한다
+  void SetUp() override { spdlog::null_logger_mt("zmq"); }
+  void TearDown() override { spdlog::drop("zmq"); }
+
+  zmq::socket_t subscribe(const std::string& endpoint, const std::vector<std::string>& prefixes) {
+    zmq::socket_t sub(ctx_, zmq::socket_type::sub);
+    sub.set(zmq::sockopt::rcvtimeo, 2000);
+    sub.connect(endpoint);
+    for (const auto& prefix : prefixes) sub.set(zmq::sockopt::subscribe, prefix);
+    return sub;
+  }
+
+  // 송신 스레드가 구독 메시지를 처리할 때까지 기다린다
+  static bool waitUntil(const std::function<bool()>& condition) {
+    const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+    while (!condition()) {
+      if (std::chrono::steady_clock::now() > deadline) return false;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+  // 메시지 하나의 프레임들. 시간 안에 오지 않으면 비어 있다.
+  static std::vector<std::string> receive(zmq::socket_t& sub) {
+    std::vector<std::string> frames;
+    zmq::message_t frame;
+    do {
+      if (!sub.recv(frame)) return {};
+      frames.push_back(frame.to_string());
+    } while (frame.more());
+    return frames;
+  }
+
+  static uint64_t seqOf(const std::string& frame) {
+    uint64_t seq = 0;
+    std::memcpy(&seq, frame.data(), sizeof(seq));
+    return seq;
+  }
+
+  zmq::context_t ctx_;
+};
+
+}  // namespace
+
+TEST_F(PubSocketTest, SendsTopicPayloadAndSeqFrames) {
+  PubSocket pub(ctx_, "inproc://pub_frames");
+  const auto det = pub.registerTopic("det", {});
+  auto sub = subscribe("inproc://pub_frames", {"det"});
+  ASSERT_TRUE(waitUntil([&] { return pub.hasSubscribers(det); }));
+
+  EXPECT_TRUE(pub.publish(det, std::string("first")));
+  EXPECT_TRUE(pub.publish("det", std::string_view("second")));
+  EXPECT_FALSE(pub.publish(det + 1, std::string("unknown id")));
+
+  auto frames = receive(sub);
+  ASSERT_EQ(frames.size(), 3u);
+  EXPECT_EQ(frames[0], "det");
+  EXPECT_EQ(frames[1], "first");
+  ASSERT_EQ(frames[2].size(), sizeof(uint64_t));
+  EXPECT_EQ(seqOf(frames[2]), 1u);
+
+  frames = receive(sub);
+  ASSERT_EQ(frames.size(), 3u);
+  EXPECT_EQ(frames[1], "second");
+  EXPECT_EQ(seqOf(frames[2]), 2u);
+}
+
+TEST_F(PubSocketTest, DeliversEveryMessageFromConcurrentPublishers) {
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 100;
+  PubSocket pub(ctx_, "inproc://pub_concurrent", 512);
+  const auto blt = pub.registerTopic("blt", {});
+  auto sub = subscribe("inproc://pub_concurrent", {"blt"});
+  ASSERT_TRUE(waitUntil([&] { return pub.hasSubscribers(blt); }));
+
+  std::vector<std::thread> producers;
+  for (int t = 0; t < kThreads; ++t) {
+    producers.emplace_back([&pub, t] {
+      for (int i = 0; i < kPerThread; ++i) pub.publish("blt", std::to_string(t * kPerThread + i));
+    });
+  }
+  for (auto& producer : producers) producer.join();
+
+  std::set<std::string> payloads;
+  std::set<uint64_t> seqs;
+  std::vector<int> last_per_thread(kThreads, -1);
+  for (int n = 0; n < kThreads * kPerThread; ++n) {
+    const auto frames = receive(sub);
+    ASSERT_EQ(frames.size(), 3u) << "message " << n;
+    EXPECT_EQ(frames[0], "blt");
+    payloads.insert(frames[1]);
+    seqs.insert(seqOf(frames[2]));
+
+    // 한 스레드가 보낸 메시지는 보낸 순서대로 나간다
+    const int value = std::stoi(frames[1]);
+    EXPECT_GT(value, last_per_thread[value / kPerThread]);
+    last_per_thread[value / kPerThread] = value;
+  }
+  EXPECT_EQ(payloads.size(), static_cast<std::size_t>(kThreads * kPerThread));
+  ASSERT_EQ(seqs.size(), static_cast<std::size_t>(kThreads * kPerThread));
+  EXPECT_EQ(*seqs.begin(), 1u);
+  EXPECT_EQ(*seqs.rbegin(), static_cast<uint64_t>(kThreads * kPerThread));
+  EXPECT_EQ(pub.dropped(PubSocket::Priority::Normal), 0u);
+}
+
+TEST_F(PubSocketTest, ReturnsSentPayloadBuffersForReuse) {
+  PubSocket pub(ctx_, "inproc://pub_pool");
+  const auto det = pub.registerTopic("det", {});
+  auto sub = subscribe("inproc://pub_pool", {"det"});
+  ASSERT_TRUE(waitUntil([&] { return pub.hasSubscribers(det); }));
+  EXPECT_TRUE(pub.acquirePayload().empty());
+
+  std::string payload(4096, 'x');
+  const char* buffer = payload.data();
+  pub.publish(det, std::move(payload));
+  {
+    const auto frames = receive(sub);
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[1], std::string(4096, 'x'));
+  }
+
+  // 구독자가 받은 메시지를 놓으면 같은 버퍼가 비워진 채로 풀에 돌아온다
+  std::string reused;
+  ASSERT_TRUE(waitUntil([&] {
+    reused = pub.acquirePayload();
+    return reused.capacity() >= 4096;
+  }));
+  EXPECT_TRUE(reused.empty());
+  EXPECT_EQ(reused.data(), buffer);
+}
+
+TEST_F(PubSocketTest, CountsSubscribersPerTopic) {
+  PubSocket pub(ctx_, "inproc://pub_subscribers");
+  const auto det = pub.registerTopic("det", {});
+  const auto blt = pub.registerTopic("blt", {});
+  EXPECT_FALSE(pub.hasSubscribers(det));
+  EXPECT_EQ(pub.subscriptionVersion(det), 0u);
+
+  auto first = subscribe("inproc://pub_subscribers", {"det"});
+  ASSERT_TRUE(waitUntil([&] { return pub.hasSubscribers(det); }));
+  EXPECT_EQ(pub.subscriptionVersion(det), 1u);
+
+  // prefix 구독도 해당 토픽의 구독으로 센다
+  auto second = subscribe("inproc://pub_subscribers", {"d"});
+  ASSERT_TRUE(waitUntil([&] { return pub.subscriptionVersion(det) == 2; }));
+  EXPECT_FALSE(pub.hasSubscribers(blt));
+  EXPECT_EQ(pub.subscriptionVersion(blt), 0u);
+
+  first.set(zmq::sockopt::unsubscribe, "det");
+  second.set(zmq::sockopt::unsubscribe, "d");
+  EXPECT_TRUE(waitUntil([&] { return !pub.hasSubscribers(det); }));
+  EXPECT_FALSE(pub.hasSubscribers("det"));
+}
+
+TEST_F(PubSocketTest, RequestedRateFollowsRateHints) {
+  PubSocket pub(ctx_, "inproc://pub_rate");
+  const auto det = pub.registerTopic("det", {});
+  EXPECT_EQ(pub.requestedRate(det), 0u);
+
+  // "<topic>@<hz>" 만으로는 구독자가 아니다
+  auto slow = subscribe("inproc://pub_rate", {"det@5"});
+  ASSERT_TRUE(waitUntil([&] { return pub.requestedRate(det) == 5; }));
+  EXPECT_FALSE(pub.hasSubscribers(det));
+  slow.set(zmq::sockopt::subscribe, "det");
+
+  auto faster = subscribe("inproc://pub_rate", {"det", "det@10"});
+  ASSERT_TRUE(waitUntil([&] { return pub.requestedRate(det) == 10; }));
+  EXPECT_TRUE(pub.hasSubscribers(det));
+
+  // 전송률을 지정하지 않은 구독자가 붙으면 제한을 푼다
+  auto unlimited = subscribe("inproc://pub_rate", {"det"});
+  ASSERT_TRUE(waitUntil([&] { return pub.requestedRate(det) == 0; }));
+
+  unlimited.set(zmq::sockopt::unsubscribe, "det");
+  EXPECT_TRUE(waitUntil([&] { return pub.requestedRate(det) == 10; }));
+}
+
+TEST_F(PubSocketTest, NumbersMessagesPerTopic) {
+  PubSocket pub(ctx_, "inproc://pub_seq");
+  const auto det = pub.registerTopic("det", {});
+  const auto blt = pub.registerTopic("blt", {});
+  auto sub = subscribe("inproc://pub_seq", {""});
+  ASSERT_TRUE(waitUntil([&] { return pub.hasSubscribers(det) && pub.hasSubscribers(blt); }));
+
+  for (int i = 0; i < 3; ++i) {
+    pub.publish(det, std::string("d"));
+    if (i < 2) pub.publish(blt, std::string("b"));
+  }
+
+  std::vector<uint64_t> det_seqs;
+  std::vector<uint64_t> blt_seqs;
+  for (int n = 0; n < 5; ++n) {
+    const auto frames = receive(sub);
+    ASSERT_EQ(frames.size(), 3u);
+    (frames[0] == "det" ? det_seqs : blt_seqs).push_back(seqOf(frames[2]));
+  }
+  EXPECT_EQ(det_seqs, (std::vector<uint64_t>{1, 2, 3}));
+  EXPECT_EQ(blt_seqs, (std::vector<uint64_t>{1, 2}));
+}
+
+TEST_F(PubSocketTest, NumbersUnregisteredTopicsByName) {
+  PubSocket pub(ctx_, "inproc://pub_unregistered");
+  for (std::size_t i = 0; i < PubSocket::kMaxTopics; ++i) pub.registerTopic("t" + std::to_string(i), {});
+  EXPECT_EQ(pub.registerTopic("x", {}), PubSocket::kUnregisteredTopic);
+
+  // 미등록 토픽은 구독자 수를 세지 않으므로, 같이 보낸 t0 구독이 반영되는 것으로 확인한다
+  auto sub = subscribe("inproc://pub_unregistered", {"x", "y", "t0"});
+  ASSERT_TRUE(waitUntil([&] { return pub.hasSubscribers("t0"); }));
+
+  pub.publish("x", std::string_view("x1"));
+  pub.publish("y", std::string_view("y1"));
+  pub.publish("x", std::string_view("x2"));
+
+  const std::vector<std::pair<std::string, uint64_t>> expected = {{"x", 1}, {"y", 1}, {"x", 2}};
+  for (const auto& [topic, seq] : expected) {
+    const auto frames = receive(sub);
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[0], topic);
+    EXPECT_EQ(seqOf(frames[2]), seq);
+  }
+}
+
+TEST_F(PubSocketTest, SnapshotHoldsLastValueOfCachedTopics) {
+  PubSocket pub(ctx_, "inproc://pub_snapshot");
+  using app_common::OverflowPolicy;
+  pub.registerTopic("TRACK_CHANGED", {PubSocket::Priority::High, OverflowPolicy::DropNewest, true});
+  pub.registerTopic("blt", {PubSocket::Priority::Normal, OverflowPolicy::DropOldest, true});
+  pub.registerTopic("det", {});
+
+  // 구독자가 없어도 캐시 대상 토픽은 발행할 의미가 있다
+  EXPECT_TRUE(pub.wantsPublish("TRACK_CHANGED"));
+  EXPECT_FALSE(pub.wantsPublish("det"));
+
+  pub.publish("TRACK_CHANGED", std::string_view("first"));
+  pub.publish("TRACK_CHANGED", std::string_view("second"));
+  pub.publish("blt", std::string_view("devices"));
+  pub.publish("det", std::string_view("boxes"));
+
+  const auto all = pub.snapshot();
+  ASSERT_EQ(all.size(), 2u);
+  EXPECT_EQ(all[0].topic, "TRACK_CHANGED");
+  EXPECT_EQ(all[0].payload, "second");
+  EXPECT_EQ(all[0].seq, 2u);
+  EXPECT_EQ(all[1].topic, "blt");
+  EXPECT_EQ(all[1].payload, "devices");
+  EXPECT_EQ(all[1].seq, 1u);
+
+  const auto tracks = pub.snapshot("TRACK");
+  ASSERT_EQ(tracks.size(), 1u);
+  EXPECT_EQ(tracks[0].payload, "second");
+  EXPECT_TRUE(pub.snapshot("det").empty());
+}
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "common/utils/restart_backoff.hpp"
+
+using std::chrono::milliseconds;
+
+TEST(RestartBackoffTest, DoublesUntilMax) {
+  app_common::RestartBackoff backoff(milliseconds(500), milliseconds(3000));
+  EXPECT_EQ(backoff.next(false), milliseconds(500));
+  EXPECT_EQ(backoff.next(false), milliseconds(1000));
+  EXPECT_EQ(backoff.next(false), milliseconds(2000));
+  EXPECT_EQ(backoff.next(false), milliseconds(3000));
+  EXPECT_EQ(backoff.next(false), milliseconds(3000));
+  EXPECT_EQ(backoff.failures(), 5u);
+}
+
+TEST(RestartBackoffTest, HealthyRunStartsOver) {
+  app_common::RestartBackoff backoff(milliseconds(100), milliseconds(10000));
+  backoff.next(false);
+  backoff.next(false);
+  EXPECT_EQ(backoff.next(false), milliseconds(400));
+
+  EXPECT_EQ(backoff.next(true), milliseconds(100));
+  EXPECT_EQ(backoff.failures(), 1u);
+  EXPECT_EQ(backoff.next(false), milliseconds(200));
+
+  backoff.reset();
+  EXPECT_EQ(backoff.failures(), 0u);
+  EXPECT_EQ(backoff.next(false), milliseconds(100));
+}
+
+TEST(RestartBackoffTest, ManyFailuresDoNotOverflow) {
+  app_common::RestartBackoff backoff(milliseconds(1), milliseconds(60000));
+  milliseconds delay{0};
+  for (int i = 0; i < 1000; ++i) delay = backoff.next(false);
+  EXPECT_EQ(delay, milliseconds(60000));
+}
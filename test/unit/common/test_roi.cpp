@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/infer/roi.hpp"
+
+using app_common::RoiRect;
+
+namespace {
+app_common::Detection box(int32_t class_id, float confidence, float x, float y, float w, float h) {
+  app_common::Detection det{};
+  det.class_id = class_id;
+  det.confidence = confidence;
+  det.x = x;
+  det.y = y;
+  det.w = w;
+  det.h = h;
+  return det;
+}
+}  // namespace
+
+TEST(RoiTest, ParseAndFormatRoundTrip) {
+  std::vector<RoiRect> rois;
+  std::string error;
+  ASSERT_TRUE(app_common::parseRois("0:0:640:360;1280:720:640:360", rois, error)) << error;
+  ASSERT_EQ(rois.size(), 2u);
+  EXPECT_EQ(rois[1], (RoiRect{1280, 720, 640, 360}));
+  EXPECT_EQ(app_common::formatRois(rois), "0:0:640:360;1280:720:640:360");
+
+  ASSERT_TRUE(app_common::parseRois("", rois, error));
+  EXPECT_TRUE(rois.empty());
+}
+
+TEST(RoiTest, ParseRejectsMalformedInput) {
+  std::vector<RoiRect> rois;
+  std::string error;
+  EXPECT_FALSE(app_common::parseRois("0:0:640", rois, error));
+  EXPECT_FALSE(app_common::parseRois("0:0:640:360:1", rois, error));
+  EXPECT_FALSE(app_common::parseRois("0:0:64x:360", rois, error));
+  EXPECT_FALSE(error.empty());
+}
+
+TEST(RoiTest, NormalizeClipsToFrameAndAlignsToEven) {
+  RoiRect roi{-10, 101, 300, 2000};
+  ASSERT_TRUE(app_common::normalizeRoi(roi, 1920, 1080));
+  EXPECT_EQ(roi, (RoiRect{0, 100, 290, 980}));
+
+  RoiRect outside{1910, 0, 100, 100};
+  EXPECT_FALSE(app_common::normalizeRoi(outside, 1920, 1080));
+}
+
+TEST(RoiTest, TransformMapsRoiDetectionsIntoFullFrame) {
+  // 1920x1080 원본의 오른쪽 아래 1/4 을 960x544 로 스케일한 입력
+  const auto transform = app_common::roiTransform({960, 540, 960, 540}, 1920, 1080, 960, 544, 0);
+
+  app_common::Detection det{};
+  det.x = 480.0f;
+  det.y = 272.0f;
+  det.w = 96.0f;
+  det.h = 54.4f;
+  transform.apply(det);
+
+  // 전체 프레임을 같은 960x544 로 스케일했을 때의 좌표
+  EXPECT_FLOAT_EQ(det.x, 720.0f);
+  EXPECT_FLOAT_EQ(det.y, 408.0f);
+  EXPECT_FLOAT_EQ(det.w, 48.0f);
+  EXPECT_FLOAT_EQ(det.h, 27.2f);
+}
+
+TEST(RoiTest, MergeKeepsOneDetectionPerObjectAcrossPads) {
+  auto frame = std::make_unique<app_common::DetectionFrame>();
+  frame->num_objects = 0;
+  // 전체 프레임 검출 2 개
+  frame->objects[frame->num_objects++] = box(0, 0.6f, 100, 100, 50, 100);
+  frame->objects[frame->num_objects++] = box(2, 0.9f, 400, 100, 80, 40);
+  // ROI 검출: 같은 사람(ROI 경계에서 아래가 잘림, 더 높은 신뢰도), 같은 자리의 다른 class, 새 객체
+  frame->objects[frame->num_objects++] = box(0, 0.8f, 102, 100, 48, 60);
+  frame->objects[frame->num_objects++] = box(1, 0.7f, 100, 100, 50, 100);
+  frame->objects[frame->num_objects++] = box(0, 0.5f, 700, 300, 20, 40);
+
+  EXPECT_EQ(app_common::mergeRoiDetections(*frame, 2, 0.7f), 1u);
+  ASSERT_EQ(frame->num_objects, 4u);
+  EXPECT_EQ(frame->objects[0].class_id, 0);
+  EXPECT_FLOAT_EQ(frame->objects[0].confidence, 0.8f);
+  EXPECT_EQ(frame->objects[1].class_id, 2);
+  EXPECT_EQ(frame->objects[2].class_id, 1);
+  EXPECT_FLOAT_EQ(frame->objects[3].x, 700.0f);
+}
+
+TEST(RoiTest, MergeWithoutRoiDetectionsIsNoop) {
+  auto frame = std::make_unique<app_common::DetectionFrame>();
+  frame->num_objects = 2;
+  frame->objects[0] = box(0, 0.6f, 0, 0, 10, 10);
+  frame->objects[1] = box(0, 0.6f, 0, 0, 10, 10);
+  EXPECT_EQ(app_common::mergeRoiDetections(*frame, 2, 0.7f), 0u);
+  EXPECT_EQ(frame->num_objects, 2u);
+}
+
+TEST(RoiTest, GroupsBatchPerSourceInOrder) {
+  // pad 0, 1: source 0, 1 의 전체 프레임. pad 2: source 0 의 ROI, pad 3: source 1 의 ROI
+  std::vector<app_common::RoiTransform> by_pad(4);
+  by_pad[0].source_id = 0;
+  by_pad[1].source_id = 1;
+  by_pad[2].source_id = 0;
+  by_pad[3].source_id = 1;
+
+  // source 0 은 한 배치에 두 프레임이 들어왔고, pad 3 의 ROI 는 source 1 과 PTS 가 다르며, pad 7 은 변환표에 없다
+  const app_common::BatchFrame frames[] = {{0, 100}, {0, 133}, {1, 100}, {2, 100}, {2, 133}, {3, 90}, {7, 100}};
+  constexpr std::size_t kCount = sizeof(frames) / sizeof(frames[0]);
+  int group[kCount];
+  app_common::groupBatchFrames(frames, kCount, by_pad, group);
+
+  using app_common::kBatchDropped;
+  using app_common::kBatchRepresentative;
+  const int expected[kCount] = {kBatchRepresentative, kBatchRepresentative, kBatchRepresentative, 0, 1,
+                                kBatchRepresentative, kBatchDropped};
+  for (std::size_t i = 0; i < kCount; ++i) EXPECT_EQ(group[i], expected[i]) << "frame " << i;
+
+  // 대표 프레임을 차례로 보면 source 별 PTS 순서와 source id 가 그대로다
+  std::vector<std::pair<uint32_t, uint64_t>> published;
+  for (std::size_t i = 0; i < kCount; ++i) {
+    if (group[i] == kBatchRepresentative) published.emplace_back(by_pad[frames[i].pad_index].source_id, frames[i].pts);
+  }
+  EXPECT_EQ(published, (std::vector<std::pair<uint32_t, uint64_t>>{{0, 100}, {0, 133}, {1, 100}, {1, 90}}));
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <spdlog/sinks/null_sink.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/pipeline/runtime_config.hpp"
+#include "common/utils/file_watcher.hpp"
+#include "common/utils/logging.hpp"
+
+using app_common::RuntimeSetting;
+
+TEST(RuntimeConfigTest, ParsesSettingsInFileOrder) {
+  std::vector<RuntimeSetting> settings;
+  std::string error;
+  ASSERT_TRUE(app_common::parseRuntimeConfig(R"({
+    "q2": {"max-size-buffers": 3, "leaky": "upstream"},
+    "front_caps": {"caps": "video/x-raw,format=I420,width=640,height=360"},
+    "log": {"service": "debug"}
+  })",
+                                             settings, error))
+      << error;
+
+  ASSERT_EQ(settings.size(), 4u);
+  EXPECT_EQ(settings[0].path(), "q2.max-size-buffers");
+  EXPECT_EQ(settings[0].value, "3");
+  EXPECT_EQ(settings[1].value, "upstream");
+  EXPECT_EQ(settings[2].target, "front_caps");
+  EXPECT_EQ(settings[3].target, "log");
+  EXPECT_EQ(settings[3].key, "service");
+  EXPECT_EQ(settings[3].value, "debug");
+}
+
+TEST(RuntimeConfigTest, RejectsInvalidConfigWithoutTouchingSettings) {
+  std::vector<RuntimeSetting> settings{{"q2", "leaky", "upstream"}};
+  std::string error;
+
+  EXPECT_FALSE(app_common::parseRuntimeConfig("[1]", settings, error));
+  EXPECT_EQ(error, "config: must be an object");
+  EXPECT_FALSE(app_common::parseRuntimeConfig(R"({"q2": 3})", settings, error));
+  EXPECT_EQ(error, "q2: must be an object");
+  EXPECT_FALSE(app_common::parseRuntimeConfig(R"({"q2": {"leaky": null}})", settings, error));
+  EXPECT_EQ(error, "q2.leaky: must be a string, number or bool");
+  EXPECT_FALSE(app_common::parseRuntimeConfig(R"({"log": {"service": "loud"}})", settings, error));
+  EXPECT_EQ(error, "log.service: unknown log level 'loud'");
+
+  ASSERT_EQ(settings.size(), 1u);
+  EXPECT_EQ(settings[0].path(), "q2.leaky");
+}
+
+TEST(RuntimeConfigTest, ParsesSingleSetting) {
+  RuntimeSetting setting;
+  std::string error;
+  ASSERT_TRUE(app_common::parseRuntimeSetting("streammux.batched-push-timeout", "40000", setting, error)) << error;
+  EXPECT_EQ(setting.target, "streammux");
+  EXPECT_EQ(setting.key, "batched-push-timeout");
+  EXPECT_EQ(setting.value, "40000");
+
+  EXPECT_FALSE(app_common::parseRuntimeSetting("q2", "1", setting, error));
+  EXPECT_FALSE(app_common::parseRuntimeSetting(".leaky", "1", setting, error));
+  EXPECT_FALSE(app_common::parseRuntimeSetting("log.zmq", "chatty", setting, error));
+  EXPECT_EQ(setting.path(), "streammux.batched-push-timeout");
+}
+
+TEST(RuntimeConfigTest, SetsLoggerLevel) {
+  auto logger = spdlog::null_logger_mt("runtime_config_test");
+  std::string error;
+  ASSERT_TRUE(app_common::setLogLevel("runtime_config_test", "warn", error)) << error;
+  EXPECT_EQ(logger->level(), spdlog::level::warn);
+  ASSERT_TRUE(app_common::setLogLevel("runtime_config_test", "off", error)) << error;
+  EXPECT_EQ(logger->level(), spdlog::level::off);
+
+  EXPECT_FALSE(app_common::setLogLevel("no_such_logger", "info", error));
+  EXPECT_EQ(error, "log.no_such_logger: no such logger");
+  spdlog::drop("runtime_config_test");
+}
+
+TEST(FileWatcherTest, ReportsInitialContentsAndChanges) {
+  char path[] = "/tmp/file_watcher_testXXXXXX";
+  const int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  close(fd);
+  std::ofstream(path) << "first";
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::string> seen;
+  auto wait_for_count = [&](std::size_t count) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return cv.wait_for(lock, std::chrono::seconds(2), [&] { return seen.size() >= count; });
+  };
+
+  app_common::FileWatcher watcher(path, std::chrono::milliseconds(5), [&](const std::string& contents) {
+    std::lock_guard<std::mutex> lock(mutex);
+    seen.push_back(contents);
+    cv.notify_all();
+  });
+  watcher.start();
+  ASSERT_TRUE(wait_for_count(1));
+
+  // 쓰는 도중의 빈 파일을 보지 않도록 편집기처럼 새 파일을 써서 바꿔 넣는다.
+  // 크기가 달라 mtime 해상도와 무관하게 바뀐 것으로 보인다
+  const std::string next = std::string(path) + ".next";
+  std::ofstream(next) << "second version";
+  ASSERT_EQ(std::rename(next.c_str(), path), 0);
+  ASSERT_TRUE(wait_for_count(2));
+  watcher.stop();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_EQ(seen[0], "first");
+  EXPECT_EQ(seen[1], "second version");
+  std::remove(path);
+}
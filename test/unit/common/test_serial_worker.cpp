@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <vector>
+
+#include "common/utils/serial_worker.hpp"
+
+using app_common::SerialWorker;
+
+TEST(SerialWorkerTest, RunsTasksInOrderAndDrainsOnDestruction) {
+  std::vector<int> order;
+  {
+    SerialWorker worker;
+    for (int i = 0; i < 100; ++i) worker.post([&order, i] { order.push_back(i); });
+  }
+  ASSERT_EQ(order.size(), 100u);
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(order[i], i);
+}
+
+TEST(SerialWorkerTest, IndependentWorkersRunInParallel) {
+  SerialWorker blocked;
+  SerialWorker other;
+  std::promise<void> release;
+  auto released = release.get_future().share();
+
+  blocked.post([released] { released.wait(); });
+
+  std::promise<void> done;
+  auto finished = done.get_future();
+  other.post([&done] { done.set_value(); });
+
+  EXPECT_EQ(finished.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+  release.set_value();
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "common/utils/source_lanes.hpp"
+
+using app_common::SourceLanes;
+
+namespace {
+struct Job {
+  uint32_t seq{0};
+  uint32_t value{0};
+};
+
+constexpr std::size_t kSources = 4;
+}  // namespace
+
+TEST(SourceLanesTest, KeepsOrderWithinEachSource) {
+  // 각 단계는 source 별로 한 번에 하나만 실행되므로 source 별 상태를 잠금 없이 쓸 수 있다
+  std::array<std::vector<uint32_t>, kSources> seen;
+  std::array<uint32_t, kSources> doubled{};
+
+  SourceLanes<Job> lanes(kSources, 16,
+                         {[&](uint32_t source, Job& job) {
+                            job.value = job.seq * 2;
+                            ++doubled[source];
+                            return true;
+                          },
+                          [&](uint32_t source, Job& job) {
+                            seen[source].push_back(job.value / 2);
+                            return true;
+                          }});
+
+  constexpr uint32_t kJobsPerSource = 500;
+  for (uint32_t seq = 0; seq < kJobsPerSource; ++seq) {
+    for (uint32_t source = 0; source < kSources; ++source) {
+      Job* job = nullptr;
+      // 풀이 비면 처리 중인 job 을 직접 돕는다 (worker 가 없는 단일 코어에서도 진행되도록)
+      while (!(job = lanes.acquire())) lanes.wait();
+      job->seq = seq;
+      ASSERT_TRUE(lanes.submit(source, job));
+    }
+  }
+  lanes.wait();
+
+  for (uint32_t source = 0; source < kSources; ++source) {
+    ASSERT_EQ(seen[source].size(), kJobsPerSource);
+    EXPECT_EQ(doubled[source], kJobsPerSource);
+    for (uint32_t seq = 0; seq < kJobsPerSource; ++seq) EXPECT_EQ(seen[source][seq], seq);
+  }
+}
+
+TEST(SourceLanesTest, RejectedJobSkipsRemainingStages) {
+  std::atomic<int> reached{0};
+  SourceLanes<Job> lanes(1, 4,
+                         {[](uint32_t, Job& job) { return job.seq % 2 == 0; },
+                          [&](uint32_t, Job&) {
+                            reached.fetch_add(1);
+                            return true;
+                          }});
+
+  for (uint32_t seq = 0; seq < 4; ++seq) {
+    Job* job = lanes.acquire();
+    ASSERT_NE(job, nullptr);
+    job->seq = seq;
+    lanes.submit(0, job);
+    lanes.wait();
+  }
+  EXPECT_EQ(reached.load(), 2);
+}
+
+TEST(SourceLanesTest, PoolIsBoundedAndRecycled) {
+  std::atomic<int> released{0};
+  SourceLanes<Job> lanes(
+      1, 2, {[](uint32_t, Job&) { return true; }}, [&] { released.fetch_add(1); });
+
+  Job* a = lanes.acquire();
+  Job* b = lanes.acquire();
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(lanes.acquire(), nullptr);
+
+  // 범위를 벗어난 source 는 바로 풀로 돌아간다
+  EXPECT_FALSE(lanes.submit(5, a));
+  EXPECT_TRUE(lanes.submit(0, b));
+  lanes.wait();
+
+  EXPECT_EQ(released.load(), 2);
+  EXPECT_NE(lanes.acquire(), nullptr);
+  EXPECT_NE(lanes.acquire(), nullptr);
+  EXPECT_EQ(lanes.acquire(), nullptr);
+}
+
+TEST(SourceLanesTest, SourcesRunConcurrently) {
+  // source 0 의 단계가 source 1 의 job 을 기다려도 교착되지 않아야 한다
+  if (std::thread::hardware_concurrency() < 2) GTEST_SKIP() << "needs at least two hardware threads";
+
+  std::atomic<bool> second_ran{false};
+  SourceLanes<Job> lanes(2, 4, {[&](uint32_t source, Job&) {
+                           if (source == 1) {
+                             second_ran.store(true);
+                             return true;
+                           }
+                           const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+                           while (!second_ran.load() && std::chrono::steady_clock::now() < deadline) {
+                             std::this_thread::yield();
+                           }
+                           return true;
+                         }});
+
+  lanes.submit(0, lanes.acquire());
+  lanes.submit(1, lanes.acquire());
+  lanes.wait();
+  EXPECT_TRUE(second_ran.load());
+}
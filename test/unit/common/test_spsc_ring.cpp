@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "common/utils/spsc_ring.hpp"
+
+using app_common::OverflowPolicy;
+using app_common::SpscRing;
+
+namespace {
+bool pushValue(SpscRing<int>& ring, int value) {
+  return ring.push([value](int& slot) { slot = value; });
+}
+
+bool popValue(SpscRing<int>& ring, int& out) {
+  return ring.pop([&out](const int& slot) { out = slot; });
+}
+}  // namespace
+
+TEST(SpscRingTest, RejectsNonPowerOfTwoCapacity) {
+  EXPECT_THROW(SpscRing<int>(3), std::invalid_argument);
+  EXPECT_THROW(SpscRing<int>(1), std::invalid_argument);
+}
+
+TEST(SpscRingTest, DropNewestKeepsExistingItems) {
+  SpscRing<int> ring(4, OverflowPolicy::DropNewest);
+  for (int i = 0; i < 6; ++i) pushValue(ring, i);
+
+  EXPECT_EQ(ring.droppedNewest(), 2u);
+  EXPECT_EQ(ring.droppedOldest(), 0u);
+
+  int value = -1;
+  for (int expected = 0; expected < 4; ++expected) {
+    ASSERT_TRUE(popValue(ring, value));
+    EXPECT_EQ(value, expected);
+  }
+  EXPECT_FALSE(popValue(ring, value));
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRingTest, DropOldestKeepsLatestItems) {
+  SpscRing<int> ring(4, OverflowPolicy::DropOldest);
+  for (int i = 0; i < 6; ++i) EXPECT_TRUE(pushValue(ring, i));
+
+  EXPECT_EQ(ring.droppedOldest(), 2u);
+  EXPECT_EQ(ring.droppedNewest(), 0u);
+
+  int value = -1;
+  for (int expected = 2; expected < 6; ++expected) {
+    ASSERT_TRUE(popValue(ring, value));
+    EXPECT_EQ(value, expected);
+  }
+}
+
+TEST(SpscRingTest, ConcurrentProducerConsumerPreservesOrder) {
+  constexpr int kCount = 200000;
+  SpscRing<int> ring(64, OverflowPolicy::DropOldest);
+
+  std::atomic<bool> done{false};
+
+  std::thread producer([&] {
+    for (int i = 0; i < kCount; ++i) pushValue(ring, i);
+    done = true;
+  });
+
+  int last = -1;
+  uint64_t received = 0;
+  while (!done || !ring.empty()) {
+    int value = -1;
+    if (popValue(ring, value)) {
+      EXPECT_GT(value, last);
+      last = value;
+      ++received;
+    }
+  }
+  producer.join();
+
+  EXPECT_EQ(received + ring.droppedOldest() + ring.droppedNewest(), static_cast<uint64_t>(kCount));
+}
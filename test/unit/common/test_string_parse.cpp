@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "common/utils/string_parse.hpp"
+
+TEST(StringParseTest, ParsesWholeNumbersOnly) {
+  int32_t i = 0;
+  EXPECT_TRUE(app_common::parseInt("-42", i));
+  EXPECT_EQ(i, -42);
+  EXPECT_FALSE(app_common::parseInt("", i));
+  EXPECT_FALSE(app_common::parseInt("12x", i));
+  EXPECT_FALSE(app_common::parseInt(" 1", i));
+  EXPECT_FALSE(app_common::parseInt("99999999999", i));
+
+  float f = 0.0f;
+  EXPECT_TRUE(app_common::parseFloat("0.25", f));
+  EXPECT_FLOAT_EQ(f, 0.25f);
+  EXPECT_FALSE(app_common::parseFloat("", f));
+  EXPECT_FALSE(app_common::parseFloat("0.5;", f));
+  EXPECT_FALSE(app_common::parseFloat("nan", f));
+  EXPECT_FALSE(app_common::parseFloat("inf", f));
+}
+
+TEST(StringParseTest, TrimsBlanks) {
+  EXPECT_EQ(app_common::trim(" \t1, 2\r"), "1, 2");
+  EXPECT_EQ(app_common::trim("   "), "");
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/infer/synthetic_detections.hpp"
+
+using app_common::DetectionFrame;
+using app_common::SyntheticConfig;
+using app_common::SyntheticDetector;
+
+TEST(SyntheticDetectionsTest, RandomModeIsDeterministicAndStaysInFrame) {
+  SyntheticConfig config;
+  config.objects_per_frame = 20;
+  config.num_classes = 3;
+  config.frame_width = 640.0f;
+  config.frame_height = 360.0f;
+  config.seed = 42;
+
+  SyntheticDetector a(config);
+  SyntheticDetector b(config);
+  auto fa = std::make_unique<DetectionFrame>();
+  auto fb = std::make_unique<DetectionFrame>();
+  for (int n = 0; n < 500; ++n) {
+    a.next(*fa);
+    b.next(*fb);
+    ASSERT_EQ(fa->num_objects, 20u);
+    ASSERT_EQ(fb->num_objects, 20u);
+    for (uint32_t i = 0; i < fa->num_objects; ++i) {
+      const auto& det = fa->objects[i];
+      EXPECT_EQ(det.x, fb->objects[i].x);
+      EXPECT_EQ(det.confidence, fb->objects[i].confidence);
+      EXPECT_GE(det.x, 0.0f);
+      EXPECT_GE(det.y, 0.0f);
+      EXPECT_LE(det.x + det.w, 640.0f);
+      EXPECT_LE(det.y + det.h, 360.0f);
+      EXPECT_GE(det.class_id, 0);
+      EXPECT_LT(det.class_id, 3);
+      EXPECT_EQ(std::string(det.label), "class" + std::to_string(det.class_id));
+    }
+  }
+  EXPECT_EQ(a.framesGenerated(), 500u);
+
+  // 같은 seed 로 처음부터 다시 만들면 같은 첫 프레임이 나온다
+  SyntheticDetector c(config);
+  c.next(*fb);
+  a.reset();
+  a.next(*fa);
+  EXPECT_EQ(fa->objects[0].x, fb->objects[0].x);
+  EXPECT_EQ(fa->objects[0].class_id, fb->objects[0].class_id);
+}
+
+TEST(SyntheticDetectionsTest, ScriptModeLoopsOverLines) {
+  SyntheticConfig config;
+  std::string error;
+  ASSERT_TRUE(app_common::parseSyntheticScript("# 주석\n0:0.9:10:20:30:40;2:0.5:0:0:5:5\n\n1:0.75:1:2:3:4\n",
+                                               config.script, error))
+      << error;
+  ASSERT_EQ(config.script.size(), 3u);
+
+  SyntheticDetector detector(config);
+  auto frame = std::make_unique<DetectionFrame>();
+  detector.next(*frame);
+  ASSERT_EQ(frame->num_objects, 2u);
+  EXPECT_EQ(frame->objects[0].class_id, 0);
+  EXPECT_FLOAT_EQ(frame->objects[0].confidence, 0.9f);
+  EXPECT_FLOAT_EQ(frame->objects[0].h, 40.0f);
+  EXPECT_STREQ(frame->objects[1].label, "class2");
+
+  detector.next(*frame);
+  EXPECT_EQ(frame->num_objects, 0u);
+  detector.next(*frame);
+  ASSERT_EQ(frame->num_objects, 1u);
+  EXPECT_FLOAT_EQ(frame->objects[0].x, 1.0f);
+  detector.next(*frame);
+  EXPECT_EQ(frame->num_objects, 2u);
+}
+
+TEST(SyntheticDetectionsTest, RejectsMalformedScripts) {
+  std::vector<std::vector<app_common::Detection>> frames;
+  std::string error;
+  EXPECT_FALSE(app_common::parseSyntheticScript("0:0.9:10:20:30\n", frames, error));
+  EXPECT_NE(error.find("line 1"), std::string::npos);
+  EXPECT_FALSE(app_common::parseSyntheticScript("0:0.9:1:1:1:1\nx:0.9:1:1:1:1\n", frames, error));
+  EXPECT_NE(error.find("line 2"), std::string::npos);
+  EXPECT_FALSE(app_common::parseSyntheticScript("0:0.9:1:1:1:1:7\n", frames, error));
+  EXPECT_FALSE(app_common::parseSyntheticScript("# 비어 있음\n", frames, error));
+  EXPECT_TRUE(frames.empty());
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "common/infer/detection_json_writer.hpp"
+#include "common/infer/tracker.hpp"
+#include "common/utils/json.hpp"
+#include "detection_frames.hpp"
+
+using app_common::DetectionFrame;
+using app_common::TrackDelta;
+using app_common::Tracker;
+using test_support::makeFrame;
+
+namespace {
+void setObject(DetectionFrame& frame, uint32_t index, int32_t class_id, float x, float y, float w, float h) {
+  auto& det = frame.objects[index];
+  det = {class_id, 0.9f, x, y, w, h, {}};
+  app_common::copyLabel(det.label, class_id == 0 ? "car" : "person");
+  frame.num_objects = std::max(frame.num_objects, index + 1);
+}
+}  // namespace
+
+TEST(TrackerTest, KeepsIdsForMovingObjects) {
+  Tracker tracker;
+  auto frame = makeFrame();
+  uint32_t car_id = 0;
+  uint32_t person_id = 0;
+
+  for (int i = 0; i < 30; ++i) {
+    frame->num_objects = 0;
+    // 검출 순서가 바뀌어도 id 는 객체를 따라간다
+    const bool swap = i % 2 == 1;
+    setObject(*frame, swap ? 1 : 0, 0, 100.0f + i * 4.0f, 100.0f, 80.0f, 60.0f);
+    setObject(*frame, swap ? 0 : 1, 1, 500.0f, 300.0f - i * 2.0f, 30.0f, 90.0f);
+    tracker.update(*frame);
+
+    const auto& car = frame->objects[swap ? 1 : 0];
+    const auto& person = frame->objects[swap ? 0 : 1];
+    if (i == 0) {
+      car_id = car.track_id;
+      person_id = person.track_id;
+      EXPECT_NE(car_id, 0u);
+      EXPECT_NE(car_id, person_id);
+    }
+    EXPECT_EQ(car.track_id, car_id) << "frame " << i;
+    EXPECT_EQ(person.track_id, person_id) << "frame " << i;
+  }
+  EXPECT_EQ(tracker.size(), 2u);
+}
+
+TEST(TrackerTest, ReportsBirthMovementAndDeath) {
+  app_common::TrackerConfig config;
+  config.min_hits = 3;
+  config.max_age = 2;
+  config.delta_threshold = 0.05f;
+  Tracker tracker(config);
+  auto frame = makeFrame();
+  TrackDelta delta;
+
+  // 확정 전에는 delta 가 비어 있다
+  for (int i = 0; i < 2; ++i) {
+    frame->num_objects = 0;
+    setObject(*frame, 0, 0, 100.0f, 100.0f, 100.0f, 100.0f);
+    tracker.update(*frame, &delta);
+    EXPECT_TRUE(delta.empty());
+  }
+
+  frame->num_objects = 0;
+  setObject(*frame, 0, 0, 101.0f, 100.0f, 100.0f, 100.0f);
+  tracker.update(*frame, &delta);
+  ASSERT_EQ(delta.born.size(), 1u);
+  const uint32_t id = frame->objects[0].track_id;
+
+  // 임계값(5px) 이하의 흔들림은 보내지 않는다
+  frame->num_objects = 0;
+  setObject(*frame, 0, 0, 104.0f, 100.0f, 100.0f, 100.0f);
+  tracker.update(*frame, &delta);
+  EXPECT_TRUE(delta.empty());
+
+  frame->num_objects = 0;
+  setObject(*frame, 0, 0, 110.0f, 100.0f, 100.0f, 100.0f);
+  tracker.update(*frame, &delta);
+  ASSERT_EQ(delta.moved.size(), 1u);
+
+  frame->num_objects = 0;
+  for (int i = 0; i < 3; ++i) tracker.update(*frame, &delta);
+  ASSERT_EQ(delta.died.size(), 1u);
+  EXPECT_EQ(delta.died[0], id);
+  EXPECT_EQ(tracker.size(), 0u);
+}
+
+TEST(TrackerTest, DropsUnconfirmedTracksAfterOneMiss) {
+  Tracker tracker;
+  auto frame = makeFrame();
+  TrackDelta delta;
+
+  setObject(*frame, 0, 0, 100.0f, 100.0f, 50.0f, 50.0f);
+  tracker.update(*frame, &delta);
+  EXPECT_EQ(tracker.size(), 1u);
+
+  frame->num_objects = 0;
+  tracker.update(*frame, &delta);
+  EXPECT_EQ(tracker.size(), 0u);
+  EXPECT_TRUE(delta.died.empty());
+}
+
+TEST(TrackerTest, SnapshotAndDeltaJson) {
+  app_common::TrackerConfig config;
+  config.min_hits = 1;
+  Tracker tracker(config);
+  auto frame = makeFrame();
+  TrackDelta delta;
+
+  setObject(*frame, 0, 1, 10.0f, 20.0f, 30.0f, 40.0f);
+  tracker.update(*frame, &delta);
+
+  std::string out;
+  app_common::writeTrackDeltaJson(*frame, delta, false, out);
+  auto json = app_common::Json::parse(out);
+  ASSERT_EQ(json["born"].size(), 1u);
+  EXPECT_EQ(json["born"][0]["track_id"], frame->objects[0].track_id);
+  EXPECT_EQ(json["born"][0]["label"], "person");
+  EXPECT_TRUE(json["moved"].empty());
+  EXPECT_FALSE(json.contains("sync"));
+
+  auto snapshot = makeFrame();
+  tracker.snapshot(*snapshot);
+  ASSERT_EQ(snapshot->num_objects, 1u);
+  EXPECT_EQ(snapshot->objects[0].track_id, frame->objects[0].track_id);
+  EXPECT_FLOAT_EQ(snapshot->objects[0].h, 40.0f);
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "common/vision/yuv_convert.hpp"
+
+using app_common::ImageView;
+using app_common::PixelFormat;
+using app_common::RoiRect;
+using app_common::SimdLevel;
+using app_common::YuvConverter;
+using app_common::YuvMatrix;
+
+namespace {
+std::vector<uint8_t> randomBytes(std::size_t size, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<uint8_t> data(size);
+  for (auto& v : data) v = static_cast<uint8_t>(dist(rng));
+  return data;
+}
+
+// plane 을 하나의 버퍼에 이어 붙인 영상 (stride 에 패딩을 둔다)
+struct Image {
+  Image(PixelFormat format, int width, int height) {
+    view.format = format;
+    view.width = width;
+    view.height = height;
+    const int cw = (width + 1) / 2, ch = (height + 1) / 2;
+    int sizes[3]{};
+    if (format == PixelFormat::Rgba) {
+      view.stride[0] = 4 * width + 8;
+      sizes[0] = view.stride[0] * height;
+    } else {
+      view.stride[0] = width + 8;
+      sizes[0] = view.stride[0] * height;
+      view.stride[1] = (format == PixelFormat::Nv12 ? 2 * cw : cw) + 8;
+      sizes[1] = view.stride[1] * ch;
+      if (format == PixelFormat::I420) {
+        view.stride[2] = cw + 8;
+        sizes[2] = view.stride[2] * ch;
+      }
+    }
+    bytes = randomBytes(static_cast<std::size_t>(sizes[0] + sizes[1] + sizes[2]), 7);
+    view.data[0] = bytes.data();
+    view.data[1] = bytes.data() + sizes[0];
+    view.data[2] = bytes.data() + sizes[0] + sizes[1];
+  }
+
+  uint8_t* row(int plane, int y) { return view.data[plane] + y * view.stride[plane]; }
+
+  ImageView view;
+  std::vector<uint8_t> bytes;
+};
+
+// 패딩은 출력마다 다를 수 있으므로 유효 영역만 비교한다
+bool samePixels(Image& a, Image& b) {
+  const int cw = (a.view.width + 1) / 2, ch = (a.view.height + 1) / 2;
+  const int planes = a.view.format == PixelFormat::I420 ? 3 : a.view.format == PixelFormat::Nv12 ? 2 : 1;
+  for (int p = 0; p < planes; ++p) {
+    const int rows = p == 0 ? a.view.height : ch;
+    const int bytes = a.view.format == PixelFormat::Rgba ? 4 * a.view.width
+                      : p == 0                          ? a.view.width
+                      : a.view.format == PixelFormat::Nv12 ? 2 * cw
+                                                           : cw;
+    for (int y = 0; y < rows; ++y) {
+      if (!std::equal(a.row(p, y), a.row(p, y) + bytes, b.row(p, y))) return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+TEST(YuvConvertTest, RowKernelsMatchScalar) {
+  for (int width : {1, 2, 15, 16, 17, 31, 32, 33, 64, 1920, 1923}) {
+    const auto y = randomBytes(static_cast<std::size_t>(width), 1);
+    const auto u = randomBytes(static_cast<std::size_t>(width + 1) / 2, 2);
+    const auto v = randomBytes(static_cast<std::size_t>(width + 1) / 2, 3);
+    const auto uv = randomBytes(static_cast<std::size_t>(width), 4);
+    const int pairs = width / 2;
+
+    for (YuvMatrix matrix : {YuvMatrix::Bt601, YuvMatrix::Bt709}) {
+      std::vector<uint8_t> expected(4 * static_cast<std::size_t>(width));
+      app_common::yuvToRgbaRow(y.data(), u.data(), v.data(), expected.data(), width, matrix, SimdLevel::Scalar);
+      for (SimdLevel level : {SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Neon}) {
+        std::vector<uint8_t> actual(expected.size());
+        app_common::yuvToRgbaRow(y.data(), u.data(), v.data(), actual.data(), width, matrix, level);
+        EXPECT_EQ(actual, expected) << app_common::simdLevelName(level) << " width=" << width;
+      }
+    }
+
+    std::vector<uint8_t> su(pairs), sv(pairs), merged(2 * static_cast<std::size_t>(pairs));
+    app_common::splitUvRow(uv.data(), su.data(), sv.data(), pairs, SimdLevel::Scalar);
+    for (SimdLevel level : {SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Neon}) {
+      std::vector<uint8_t> lu(pairs), lv(pairs);
+      app_common::splitUvRow(uv.data(), lu.data(), lv.data(), pairs, level);
+      EXPECT_EQ(lu, su) << app_common::simdLevelName(level) << " width=" << width;
+      EXPECT_EQ(lv, sv) << app_common::simdLevelName(level) << " width=" << width;
+      app_common::mergeUvRow(lu.data(), lv.data(), merged.data(), pairs, level);
+      EXPECT_TRUE(std::equal(merged.begin(), merged.end(), uv.begin()))
+          << app_common::simdLevelName(level) << " width=" << width;
+    }
+  }
+}
+
+TEST(YuvConvertTest, KnownColours) {
+  struct Case {
+    uint8_t y, u, v;
+    uint8_t r, g, b;
+  };
+  // limited range 의 검정/흰색/BT.601 원색
+  const Case cases[] = {
+      {16, 128, 128, 0, 0, 0},
+      {235, 128, 128, 255, 255, 255},
+      {81, 90, 240, 255, 0, 0},
+      {145, 54, 34, 0, 255, 0},
+      {41, 240, 110, 0, 0, 255},
+  };
+  for (const Case& c : cases) {
+    const uint8_t y[2]{c.y, c.y};
+    uint8_t rgba[8]{};
+    app_common::yuvToRgbaRow(y, &c.u, &c.v, rgba, 2, YuvMatrix::Bt601, SimdLevel::Scalar);
+    EXPECT_NEAR(rgba[0], c.r, 2);
+    EXPECT_NEAR(rgba[1], c.g, 2);
+    EXPECT_NEAR(rgba[2], c.b, 2);
+    EXPECT_EQ(rgba[3], 255);
+  }
+}
+
+TEST(YuvConvertTest, ConvertersMatchScalarAcrossFormats) {
+  struct Case {
+    PixelFormat src, dst;
+    int src_w, src_h, dst_w, dst_h;
+    RoiRect crop;
+  };
+  const Case cases[] = {
+      {PixelFormat::Nv12, PixelFormat::Rgba, 1920, 1080, 960, 544, {}},
+      {PixelFormat::Nv12, PixelFormat::Rgba, 67, 35, 67, 35, {}},
+      {PixelFormat::I420, PixelFormat::Rgba, 130, 70, 64, 32, {}},
+      {PixelFormat::Nv12, PixelFormat::I420, 130, 70, 130, 70, {}},
+      {PixelFormat::I420, PixelFormat::Nv12, 130, 70, 99, 51, {}},
+      {PixelFormat::Nv12, PixelFormat::Nv12, 640, 360, 200, 100, {101, 51, 300, 151}},
+      {PixelFormat::Nv12, PixelFormat::Rgba, 640, 360, 300, 151, {101, 51, 300, 151}},
+  };
+  for (const Case& c : cases) {
+    Image src(c.src, c.src_w, c.src_h);
+    Image expected(c.dst, c.dst_w, c.dst_h);
+    ASSERT_TRUE(YuvConverter(SimdLevel::Scalar).convert(src.view, expected.view, c.crop));
+    for (SimdLevel level : {SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Neon}) {
+      Image actual(c.dst, c.dst_w, c.dst_h);
+      YuvConverter converter(level);
+      ASSERT_TRUE(converter.convert(src.view, actual.view, c.crop));
+      EXPECT_TRUE(samePixels(actual, expected)) << app_common::simdLevelName(level) << " " << c.src_w << "x" << c.src_h
+                                                << " -> " << c.dst_w << "x" << c.dst_h;
+    }
+  }
+}
+
+TEST(YuvConvertTest, CropAndScalePickNearestSource) {
+  Image src(PixelFormat::Nv12, 64, 32);
+  for (int y = 0; y < 32; ++y) {
+    for (int x = 0; x < 64; ++x) src.row(0, y)[x] = static_cast<uint8_t>(y * 64 + x);
+  }
+
+  // 같은 크기면 그대로 복사되고, 홀수 시작점은 짝수로 내려간다
+  Image copy(PixelFormat::I420, 16, 8);
+  YuvConverter converter(SimdLevel::Scalar);
+  ASSERT_TRUE(converter.convert(src.view, copy.view, {9, 5, 16, 8}));
+  EXPECT_EQ(copy.row(0, 0)[0], src.row(0, 4)[8]);
+  EXPECT_EQ(copy.row(0, 7)[15], src.row(0, 11)[23]);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(copy.row(1, 1)[i], src.row(1, 3)[2 * (4 + i)]);
+    EXPECT_EQ(copy.row(2, 1)[i], src.row(1, 3)[2 * (4 + i) + 1]);
+  }
+
+  // 2 배 축소는 각 2x2 블록의 오른쪽 아래 픽셀을 고른다
+  Image half(PixelFormat::Nv12, 32, 16);
+  ASSERT_TRUE(converter.convert(src.view, half.view));
+  for (int y = 0; y < 16; ++y) {
+    for (int x = 0; x < 32; ++x) EXPECT_EQ(half.row(0, y)[x], src.row(0, 2 * y + 1)[2 * x + 1]);
+  }
+
+  // 프레임 밖으로 나가는 crop 은 잘리고, RGBA 입력은 받지 않는다
+  Image clipped(PixelFormat::Nv12, 8, 8);
+  EXPECT_TRUE(converter.convert(src.view, clipped.view, {60, 28, 100, 100}));
+  Image rgba(PixelFormat::Rgba, 8, 8);
+  EXPECT_FALSE(converter.convert(rgba.view, clipped.view));
+}
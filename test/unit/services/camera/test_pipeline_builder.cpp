@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "common/pipeline/pipeline_spec.hpp"
+#include "config/camera_config.hpp"
+#include "impl/camera/pipeline_builder.hpp"
+
+TEST(PipelineBuilderTest, DefaultSpecIsValid) {
+  for (const bool sink_mode_frames : {true, false}) {
+    std::string error;
+    EXPECT_TRUE(app_common::validatePipelineSpec(defaultCameraPipelineSpec(sink_mode_frames), error))
+        << "sink_mode_frames=" << sink_mode_frames << ": " << error;
+  }
+}
+
+// 예제 파일은 DeepStream 프로파일 / Frames 모드의 기본 파이프라인을 내보낸 것이다
+TEST(PipelineBuilderTest, ExampleFileMatchesDefaultSpec) {
+  if (!app_config::kWithDeepStream) GTEST_SKIP() << "example is written for the DeepStream profile";
+
+  std::ifstream file(std::string(VISION_SOURCE_DIR) + "/doc/camera-pipeline.example.json");
+  ASSERT_TRUE(file);
+  std::ostringstream text;
+  text << file.rdbuf();
+
+  app_common::PipelineSpec spec;
+  std::string error;
+  ASSERT_TRUE(app_common::parsePipelineSpec(text.str(), spec, error)) << error;
+  EXPECT_EQ(app_common::pipelineSpecToJson(spec), app_common::pipelineSpecToJson(defaultCameraPipelineSpec(true)));
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "impl/camera/queue_monitor.hpp"
+
+namespace {
+constexpr QueueMonitor::Bounds kBounds{2, 8, 10000, 40000, 0.05};
+
+QueueMonitor::Tuning step(QueueMonitor::Tuning current, uint64_t in, uint64_t drops, uint32_t& calm) {
+  return QueueMonitor::nextTuning(kBounds, current, in, drops, calm);
+}
+}  // namespace
+
+TEST(QueueMonitorTest, DropsGrowQueueAndShortenTimeout) {
+  uint32_t calm = 3;
+  const auto next = step({5, 40000}, 100, 10, calm);
+  EXPECT_EQ(next.depth, 6u);
+  EXPECT_EQ(next.push_timeout_us, 30000);
+  EXPECT_EQ(calm, 0u);
+}
+
+TEST(QueueMonitorTest, StaysWithinBounds) {
+  uint32_t calm = 0;
+  QueueMonitor::Tuning tuning{5, 40000};
+  for (int i = 0; i < 20; ++i) tuning = step(tuning, 100, 50, calm);
+  EXPECT_EQ(tuning.depth, kBounds.max_depth);
+  EXPECT_EQ(tuning.push_timeout_us, kBounds.min_push_timeout_us);
+
+  for (int i = 0; i < 200; ++i) tuning = step(tuning, 100, 0, calm);
+  EXPECT_EQ(tuning.depth, kBounds.min_depth);
+  EXPECT_EQ(tuning.push_timeout_us, kBounds.max_push_timeout_us);
+}
+
+TEST(QueueMonitorTest, RelaxesOnlyAfterCalmWindows) {
+  uint32_t calm = 0;
+  QueueMonitor::Tuning tuning{5, 20000};
+  for (int i = 0; i < 4; ++i) {
+    tuning = step(tuning, 100, 0, calm);
+    EXPECT_EQ(tuning.depth, 5u);
+  }
+  tuning = step(tuning, 100, 0, calm);
+  EXPECT_EQ(tuning.depth, 4u);
+  EXPECT_EQ(tuning.push_timeout_us, 25000);
+  EXPECT_EQ(calm, 0u);
+}
+
+TEST(QueueMonitorTest, DropsBelowTargetKeepSettings) {
+  uint32_t calm = 4;
+  const auto next = step({5, 20000}, 100, 3, calm);
+  EXPECT_EQ(next.depth, 5u);
+  EXPECT_EQ(next.push_timeout_us, 20000);
+  EXPECT_EQ(calm, 4u);
+
+  // 들어온 프레임이 없는 주기는 판단하지 않는다
+  EXPECT_EQ(step({5, 20000}, 0, 0, calm).depth, 5u);
+  EXPECT_EQ(calm, 4u);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "services/config/config_service.hpp"
+
+namespace {
+// 파이프라인 대신 받은 속성을 기록한다. rejected 에 든 요소는 검사에서 거절한다.
+class FakeTarget : public LivePropertyTarget {
+public:
+  bool checkLiveProperty(const std::string& element, const std::string& property, const std::string& /*value*/,
+                         std::string& error) const override {
+    if (!rejected.count(element)) return true;
+    error = element + "." + property + ": rejected";
+    return false;
+  }
+
+  bool setLiveProperty(const std::string& element, const std::string& property, const std::string& value,
+                       std::string& /*error*/) override {
+    applied.push_back(element + "." + property + "=" + value);
+    return true;
+  }
+
+  std::set<std::string> rejected;
+  std::vector<std::string> applied;
+};
+
+class ConfigServiceTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    logger_ = spdlog::null_logger_mt("config_service_test");
+    char path[] = "/tmp/config_service_testXXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    path_ = path;
+  }
+
+  void TearDown() override {
+    std::remove(path_.c_str());
+    spdlog::drop("config_service_test");
+  }
+
+  void write(const std::string& text) { std::ofstream(path_) << text; }
+
+  std::shared_ptr<spdlog::logger> logger_;
+  std::string path_;
+};
+}  // namespace
+
+TEST_F(ConfigServiceTest, AppliesEveryEntryInFileOrder) {
+  FakeTarget target;
+  ConfigService config(target, path_);
+  write(R"({"q2": {"max-size-buffers": 3, "leaky": "upstream"}, "log": {"config_service_test": "warn"}})");
+
+  const auto result = config.reload();
+  EXPECT_TRUE(result["ok"].get<bool>()) << result.dump();
+  EXPECT_EQ(target.applied, (std::vector<std::string>{"q2.max-size-buffers=3", "q2.leaky=upstream"}));
+  EXPECT_EQ(logger_->level(), spdlog::level::warn);
+}
+
+TEST_F(ConfigServiceTest, OneBadEntryAppliesNothing) {
+  FakeTarget target;
+  target.rejected.insert("front_caps");
+  ConfigService config(target, path_);
+  write(R"({"q2": {"max-size-buffers": 3},
+            "log": {"config_service_test": "error"},
+            "front_caps": {"caps": "video/x-raw,width=1"}})");
+
+  const auto level = logger_->level();
+  auto result = config.reload();
+  EXPECT_FALSE(result["ok"].get<bool>());
+  EXPECT_EQ(result["msg"], "front_caps.caps: rejected");
+  EXPECT_TRUE(target.applied.empty());
+  EXPECT_EQ(logger_->level(), level);
+
+  // 없는 logger 도 검사 단계에서 걸러진다
+  target.rejected.clear();
+  write(R"({"q2": {"max-size-buffers": 3}, "log": {"no_such_logger": "debug"}})");
+  result = config.reload();
+  EXPECT_FALSE(result["ok"].get<bool>());
+  EXPECT_TRUE(target.applied.empty());
+}
+
+TEST_F(ConfigServiceTest, SetAppliesSingleSetting) {
+  FakeTarget target;
+  ConfigService config(target, path_);
+
+  EXPECT_TRUE(config.set("streammux.batched-push-timeout", "40000")["ok"].get<bool>());
+  EXPECT_FALSE(config.set("q2", "1")["ok"].get<bool>());
+  EXPECT_EQ(target.applied, (std::vector<std::string>{"streammux.batched-push-timeout=40000"}));
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "services/control/command_registry.hpp"
+
+using app_common::Json;
+
+namespace {
+void noop(const Json& /*args*/, Json& /*reply*/) {}
+
+CommandRegistry makeRegistry() {
+  CommandRegistry registry;
+  registry.add("PING", {}, false, noop);
+  registry.add("SEEK",
+               {{"uri", ArgType::String}, {"position", ArgType::Int}, {"rate", ArgType::Number, false},
+                {"paused", ArgType::Bool, false}},
+               true, noop);
+  return registry;
+}
+
+std::string validateError(const CommandRegistry& registry, const std::string& name, const Json& args) {
+  std::string error;
+  EXPECT_FALSE(CommandRegistry::validate(*registry.find(name), args, error)) << args.dump();
+  return error;
+}
+}  // namespace
+
+TEST(CommandRegistryTest, AcceptsArgumentsMatchingSchema) {
+  const auto registry = makeRegistry();
+  std::string error;
+  EXPECT_TRUE(CommandRegistry::validate(*registry.find("PING"), Json(), error)) << error;
+  EXPECT_TRUE(CommandRegistry::validate(*registry.find("PING"), Json::object(), error)) << error;
+  EXPECT_TRUE(CommandRegistry::validate(*registry.find("SEEK"), {{"uri", "a.mp4"}, {"position", 3}}, error)) << error;
+  // Number 는 정수도 받는다
+  EXPECT_TRUE(CommandRegistry::validate(*registry.find("SEEK"),
+                                        {{"uri", "a.mp4"}, {"position", 3}, {"rate", 2}, {"paused", true}}, error))
+      << error;
+}
+
+TEST(CommandRegistryTest, RejectsWrongTypes) {
+  const auto registry = makeRegistry();
+  EXPECT_EQ(validateError(registry, "SEEK", {{"uri", 1}, {"position", 3}}), "argument uri must be string");
+  EXPECT_EQ(validateError(registry, "SEEK", {{"uri", "a"}, {"position", 1.5}}), "argument position must be int");
+  EXPECT_EQ(validateError(registry, "SEEK", {{"uri", "a"}, {"position", 1}, {"rate", "fast"}}),
+            "argument rate must be number");
+  EXPECT_EQ(validateError(registry, "SEEK", {{"uri", "a"}, {"position", 1}, {"paused", 1}}),
+            "argument paused must be bool");
+  EXPECT_EQ(validateError(registry, "PING", Json::array({1})), "args must be an object");
+}
+
+TEST(CommandRegistryTest, RejectsMissingAndExtraArguments) {
+  const auto registry = makeRegistry();
+  EXPECT_EQ(validateError(registry, "SEEK", {{"uri", "a"}}), "missing argument: position");
+  EXPECT_EQ(validateError(registry, "SEEK", Json()), "missing argument: uri");
+  EXPECT_EQ(validateError(registry, "SEEK", {{"uri", "a"}, {"position", 1}, {"speed", 2}}),
+            "unknown argument for SEEK");
+  EXPECT_EQ(validateError(registry, "PING", {{"x", 1}}), "unknown argument for PING");
+}
+
+TEST(CommandRegistryTest, UnknownCommands) {
+  const auto registry = makeRegistry();
+  EXPECT_EQ(registry.find("NOPE"), nullptr);
+
+  const CommandRegistry::Command* command = nullptr;
+  Json args;
+  std::string error;
+  EXPECT_FALSE(registry.parseLegacy("NOPE:1", command, args, error));
+  EXPECT_EQ(error, "unknown command");
+  EXPECT_EQ(command, nullptr);
+}
+
+TEST(CommandRegistryTest, ParsesLegacyCommands) {
+  const auto registry = makeRegistry();
+  const CommandRegistry::Command* command = nullptr;
+  Json args;
+  std::string error;
+
+  ASSERT_TRUE(registry.parseLegacy("PING", command, args, error)) << error;
+  EXPECT_EQ(command->name, "PING");
+  EXPECT_TRUE(args.empty());
+
+  ASSERT_TRUE(registry.parseLegacy("SEEK:a.mp4", command, args, error)) << error;
+  EXPECT_EQ(args, Json({{"uri", "a.mp4"}}));
+
+  EXPECT_FALSE(registry.parseLegacy("PING:1", command, args, error));
+  EXPECT_EQ(error, "PING takes no argument");
+}
+
+TEST(CommandRegistryTest, RejectsInvalidSchemas) {
+  CommandRegistry registry;
+  registry.add("A", {{"x", ArgType::Int}}, false, noop);
+  EXPECT_THROW(registry.add("A", {}, false, noop), std::invalid_argument);
+  EXPECT_THROW(registry.add("", {}, false, noop), std::invalid_argument);
+  EXPECT_THROW(registry.add("B:1", {}, false, noop), std::invalid_argument);
+  EXPECT_THROW(registry.add("C", {}, false, nullptr), std::invalid_argument);
+  EXPECT_THROW(registry.add("D", {{"x", ArgType::Int}, {"x", ArgType::String}}, false, noop), std::invalid_argument);
+  EXPECT_THROW(registry.add("E", {{"", ArgType::Int}}, false, noop), std::invalid_argument);
+}